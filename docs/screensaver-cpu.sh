@@ -0,0 +1,49 @@
+#!/usr/bin/env bash
+# Measure the screensaver's CPU use per face. Run on the device itself, as it
+# reads the player's CPU time from /proc.
+# Usage: ./screensaver-cpu.sh [host:port] [seconds per face]
+set -u
+BASE="http://${1:-localhost:8080}"
+SECONDS_PER_FACE="${2:-20}"
+SETTLE=3
+
+pid=$(pgrep -x player | head -n1)
+if [ -z "$pid" ]; then
+  echo "player is not running"
+  exit 1
+fi
+ticks_per_sec=$(getconf CLK_TCK)
+
+# utime + stime of the whole process, in clock ticks
+cpu_ticks() {
+  awk '{ print $14 + $15 }' "/proc/$pid/stat"
+}
+
+# Builds without /api/screensaver/stats (before the layer cache) show "-"
+paint_cost() {
+  curl -s "$BASE/api/screensaver/stats" \
+    | sed -n 's/.*"paintCostUs":\([0-9.]*\).*/\1/p' \
+    | awk '{ printf "%.0f", $1 } END { if (NR == 0) printf "-" }'
+}
+
+faces=$(curl -s "$BASE/api/clock/list" \
+  | sed -n 's/.*"faces":\[\(.*\)\].*/\1/p' | tr -d '"' | tr ',' '\n')
+if [ -z "$faces" ]; then
+  echo "could not list faces from $BASE"
+  exit 1
+fi
+
+printf "| %-18s | %6s | %12s |\n" "Face" "CPU %" "Paint (us)"
+printf "|%s|%s|%s|\n" "--------------------" "--------" "--------------"
+while IFS= read -r face; do
+  curl -s -o /dev/null -G "$BASE/api/clock" --data-urlencode "face=$face"
+  sleep "$SETTLE"
+  start=$(cpu_ticks)
+  sleep "$SECONDS_PER_FACE"
+  end=$(cpu_ticks)
+  cpu=$(awk -v t=$((end - start)) -v hz="$ticks_per_sec" -v s="$SECONDS_PER_FACE" \
+    'BEGIN { printf "%.1f", 100 * t / hz / s }')
+  printf "| %-18s | %6s | %12s |\n" "$face" "$cpu" "$(paint_cost)"
+done <<< "$faces"
+
+curl -s -o /dev/null "$BASE/api/screensaver/off"
@@ -236,6 +236,7 @@ ApiServer::Response ApiServer::route(const HttpRequest &req)
     if (handleSources(path, req, out))     return out;
     if (handleTransport(path, req, out))   return out;
     if (handleScreensaver(path, req, out)) return out;
+    if (handleVisualizer(path, req, out))  return out;
     return {404, errJson("unknown endpoint")};
 }
 
@@ -350,6 +351,10 @@ bool ApiServer::handleScreensaver(const QString &path, const HttpRequest &req, R
         out = {200, okJson()};
         return true;
     }
+    if (path == "/api/screensaver/stats") {
+        out = {200, QJsonDocument(m_window->apiScreensaverStats()).toJson(QJsonDocument::Compact)};
+        return true;
+    }
     if (path == "/api/clock") {
         int index = -1;
         if (req.query.contains("index")) {
@@ -377,6 +382,24 @@ bool ApiServer::handleScreensaver(const QString &path, const HttpRequest &req, R
     return false;
 }
 
+bool ApiServer::handleVisualizer(const QString &path, const HttpRequest &req, Response &out)
+{
+    Q_UNUSED(req);
+    if (path == "/api/avs/stats") {
+        out = {200, QJsonDocument(m_window->apiAvsStats()).toJson(QJsonDocument::Compact)};
+        return true;
+    }
+    if (path == "/api/geiss/stats") {
+        out = {200, QJsonDocument(m_window->apiGeissStats()).toJson(QJsonDocument::Compact)};
+        return true;
+    }
+    if (path == "/api/frames/stats") {
+        out = {200, QJsonDocument(m_window->apiFrameStats()).toJson(QJsonDocument::Compact)};
+        return true;
+    }
+    return false;
+}
+
 bool ApiServer::handlePlaylist(const QString &path, const HttpRequest &req, Response &out)
 {
     if (path == "/api/playlist") {
@@ -53,6 +53,7 @@ private:
     bool handleSources(const QString &path, const HttpRequest &req, Response &out);
     bool handleTransport(const QString &path, const HttpRequest &req, Response &out);   // Task 5
     bool handleScreensaver(const QString &path, const HttpRequest &req, Response &out); // Task 6
+    bool handleVisualizer(const QString &path, const HttpRequest &req, Response &out);
     bool authorized(const HttpRequest &req) const;
     void sendResponse(QTcpSocket *socket, const Response &resp);
 
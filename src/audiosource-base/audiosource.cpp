@@ -5,3 +5,9 @@ AudioSource::AudioSource(QObject *parent)
 {
 
 }
+
+void AudioSource::setGain(int volume, int balance)
+{
+    Q_UNUSED(volume);
+    Q_UNUSED(balance);
+}
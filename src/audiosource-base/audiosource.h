@@ -39,6 +39,12 @@ public slots:
     virtual void handleRepeat() = 0;
     virtual void handleSeek(int mseconds) = 0;
 
+    // Volume (0 to 100) and balance (-100 to 100) to apply to the source's
+    // own stream when the mixer isn't used for them (mixer/softwareGain).
+    // Sources that play through the system have no stream of their own, so
+    // by default this does nothing.
+    virtual void setGain(int volume, int balance);
+
 };
 
 #endif // AUDIOSOURCE_H
@@ -96,6 +96,7 @@ void AudioSourceCoordinator::setSource(int newSource)
 void AudioSourceCoordinator::setVolume(int volume)
 {
     system_audio->setVolume(volume);
+    applyGain();
     emit volumeChanged(volume);
     view->setMessage(QString("VOLUME: %1%").arg(volume), 500);
 }
@@ -103,6 +104,7 @@ void AudioSourceCoordinator::setVolume(int volume)
 void AudioSourceCoordinator::setBalance(int balance)
 {
     system_audio->setBalance(balance);
+    applyGain();
     emit balanceChanged(balance);
     QString message;
     if(balance == 0) {
@@ -120,6 +122,7 @@ void AudioSourceCoordinator::addSource(AudioSource *source, QString label, bool
     // Instantiate sources
     sources.append(source);
     sourceLabels.append(label);
+    applyGain();
     quint32 idx = sources.length() - 1;
     connect(source, &AudioSource::requestActivation, [=]() {
         this->setSource(idx);
@@ -129,6 +132,16 @@ void AudioSourceCoordinator::addSource(AudioSource *source, QString label, bool
     }
 }
 
+// With software gain every source gets the levels, not only the active one,
+// so switching sources needs nothing more
+void AudioSourceCoordinator::applyGain()
+{
+    if(!system_audio->isSoftwareGain()) return;
+    for(AudioSource *source : sources) {
+        source->setGain(system_audio->getVolume(), system_audio->getBalance());
+    }
+}
+
 AudioSource *AudioSourceCoordinator::activeSource() const
 {
     if (currentSource < 0 || currentSource >= sources.size())
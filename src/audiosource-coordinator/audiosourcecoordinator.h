@@ -42,6 +42,8 @@ public slots:
     void repeat();
 
 private:
+    void applyGain();
+
     QList<AudioSource*> sources;
     QList<QString> sourceLabels;
     int currentSource = -1;
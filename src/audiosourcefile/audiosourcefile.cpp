@@ -127,6 +127,12 @@ void AudioSourceFile::handleSeek(int mseconds)
 
 }
 
+void AudioSourceFile::setGain(int volume, int balance)
+{
+    m_player->setVolume(volume / 100.0f);
+    m_player->setBalance(balance / 100.0f);
+}
+
 void AudioSourceFile::handleMetaDataChanged()
 {
     auto metaData = m_player->metaData();
@@ -31,6 +31,7 @@ public slots:
     void handleShuffle();
     void handleRepeat();
     void handleSeek(int mseconds);
+    void setGain(int volume, int balance);
 
     void jump(const QModelIndex &index);
 
@@ -33,6 +33,7 @@ bool MediaPlayer::init(const QAudioFormat& format)
 {
     QMutexLocker l(&initMutex);
     m_format = format;
+    m_gain.setFormat(m_format);
 
     // Initialize buffers
     if (!m_output.open(QIODevice::ReadOnly) || !m_input.open(QIODevice::WriteOnly))
@@ -70,7 +71,7 @@ void MediaPlayer::setupAudioOutput()
     m_audioOutput = new QAudioSink(m_format, this);
     connect(m_audioOutput, &QAudioSink::stateChanged, this, &MediaPlayer::onOutputStateChanged);
 
-    m_audioOutput->setVolume(m_volume);
+    // The sink stays at full volume; m_gain applies ours in readData()
     emit volumeChanged(volume());
 }
 
@@ -95,8 +96,9 @@ qint64 MediaPlayer::readData(char* data, qint64 maxlen)
 {
     QMutexLocker l(&readMutex);
 
-    // Limit max len
+    // Limit max len, to whole frames so the gain stage stays on channel boundaries
     if(maxlen > MAX_AUDIO_STREAM_SAMPLE_SIZE) maxlen = MAX_AUDIO_STREAM_SAMPLE_SIZE;
+    if(m_format.bytesPerFrame() > 0) maxlen -= maxlen % m_format.bytesPerFrame();
 
     memset(data, 0, maxlen);
     qint64 bytesRead = 0;
@@ -113,6 +115,9 @@ qint64 MediaPlayer::readData(char* data, qint64 maxlen)
             emit newData(buff);
         }
 
+        // After the copy for visualization, so it doesn't follow the volume
+        m_gain.process(data, bytesRead);
+
         // If we are at the end of the file, stop
         if (atEnd())
         {
@@ -476,6 +481,7 @@ void MediaPlayer::setPosition(qint64 position)
 
     if(target >= currentBufferSize) target = currentBufferSize - 1;
     if(target < 0) target = 0;
+    if(m_format.bytesPerFrame() > 0) target -= target % m_format.bytesPerFrame();
 
     m_output.seek(target);
 }
@@ -483,5 +489,11 @@ void MediaPlayer::setPosition(qint64 position)
 void MediaPlayer::setVolume(float volume)
 {
     m_volume = volume;
-    if(m_audioOutput) m_audioOutput->setVolume(m_volume);
+    m_gain.setVolume(m_volume);
+    emit volumeChanged(volume);
+}
+
+void MediaPlayer::setBalance(float balance)
+{
+    m_gain.setBalance(balance);
 }
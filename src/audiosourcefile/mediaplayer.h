@@ -12,6 +12,8 @@
 #include <QAudioSink>
 #include <QMutex>
 
+#include "gainstage.h"
+
 // Class for decode audio files like MP3 and push decoded audio data to QOutputDevice (like speaker) and also signal newData().
 // For decoding it uses QAudioDecoder which uses QAudioFormat for decode audio file for desire format, then put decoded data to buffer.
 // based on: https://github.com/Znurre/QtMixer
@@ -88,6 +90,7 @@ private:
     bool m_seekable = false;
     qint64 m_position = 0;
     float m_volume = 1.0; // range: 0.0 - 1.0
+    GainStage m_gain;
 
     bool init(const QAudioFormat& format);
     void setupDecoder();
@@ -105,6 +108,7 @@ public slots:
     void clearSource();
     void setPosition(qint64 position);
     void setVolume(float volume);
+    void setBalance(float balance);
 
 private slots:
     void bufferReady();
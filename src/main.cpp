@@ -4,6 +4,7 @@
 
 #include "mainwindow.h"
 #include "scale.h"
+#include "skinatlas.h"
 
 #include <QApplication>
 #include <QCommandLineOption>
@@ -25,8 +26,14 @@ int main(int argc, char *argv[])
     parser.addHelpOption();
     parser.addVersionOption();
     parser.addPositionalArgument("url", "The URL(s) to open.");
+    QCommandLineOption scaleOption("scale", "UI scale, 1 to 4; overrides the ui/scale setting.", "factor");
+    parser.addOption(scaleOption);
     parser.process(app);
 
+    if (parser.isSet(scaleOption))
+        setUiScale(parser.value(scaleOption).toInt());
+    SkinAtlas::install();
+
     MainWindow window;
     if (!parser.positionalArguments().isEmpty()) {
         QList<QUrl> urls;
@@ -0,0 +1,219 @@
+#include "framescheduler.h"
+#include <QApplication>
+#include <QEvent>
+#include <QWidget>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    // An interval this close to a whole number of grid steps is taken as
+    // exactly that many, so 33 ms and 33333 us both mean every other step
+    // instead of slipping a step every few hundred frames
+    constexpr double SNAP_STEPS = 0.05;
+    // Lets a timer that fires a little early still count as on its step
+    constexpr double EARLY_STEPS = 0.05;
+
+    // Moving average over roughly the last 16 samples
+    void smooth(double &average, qint64 sample)
+    {
+        average += (sample - average) / 16.0;
+    }
+}
+
+FrameScheduler &FrameScheduler::instance()
+{
+    // Parented to the application so it is deleted while Qt is still up
+    static FrameScheduler *scheduler = new FrameScheduler(qApp);
+    return *scheduler;
+}
+
+FrameScheduler::FrameScheduler(QObject *parent)
+    : QObject(parent)
+{
+    m_clock.start();
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &FrameScheduler::onTimer);
+}
+
+double FrameScheduler::stepsFor(int intervalUs)
+{
+    double steps = std::max(1, intervalUs) * CLOCK_HZ / 1e6;
+    double whole = std::round(steps);
+    if (whole >= 1.0 && std::fabs(steps - whole) < SNAP_STEPS)
+        return whole;
+    return std::max(1.0, steps);
+}
+
+double FrameScheduler::now() const
+{
+    return m_clock.nsecsElapsed() * CLOCK_HZ / 1e9;
+}
+
+FrameScheduler::Subscriber *FrameScheduler::find(const QObject *widget)
+{
+    for (Subscriber &s : m_subscribers) {
+        if (s.widget == widget)
+            return &s;
+    }
+    return nullptr;
+}
+
+void FrameScheduler::subscribe(QWidget *widget, const QString &name, int intervalUs,
+                               const std::function<void()> &tick)
+{
+    Subscriber s;
+    s.widget = widget;
+    s.tick = tick;
+    s.interval = stepsFor(intervalUs);
+    s.due = std::ceil(now());
+    s.stats.name = name;
+    s.stats.visible = widget->isVisible();
+    s.stats.active = true;
+    s.stats.intervalUs = intervalUs;
+    m_subscribers.append(s);
+
+    widget->installEventFilter(this);
+    connect(widget, &QObject::destroyed, this, [this](QObject *gone) {
+        m_subscribers.erase(std::remove_if(m_subscribers.begin(), m_subscribers.end(),
+                                           [gone](const Subscriber &sub) { return sub.widget == gone; }),
+                            m_subscribers.end());
+        arm();
+    });
+    arm();
+}
+
+void FrameScheduler::setInterval(QWidget *widget, int intervalUs)
+{
+    Subscriber *s = find(widget);
+    if (!s || s->stats.intervalUs == intervalUs)
+        return;
+    // The tick already due stays where it is; the new interval counts from it
+    s->interval = stepsFor(intervalUs);
+    s->stats.intervalUs = intervalUs;
+}
+
+void FrameScheduler::setActive(QWidget *widget, bool active)
+{
+    Subscriber *s = find(widget);
+    if (!s || s->stats.active == active)
+        return;
+    s->stats.active = active;
+    if (active)
+        s->due = std::ceil(now());
+    arm();
+}
+
+void FrameScheduler::scheduleTick(QWidget *widget, int delayUs)
+{
+    Subscriber *s = find(widget);
+    if (!s)
+        return;
+    s->due = now() + std::max(0, delayUs) * CLOCK_HZ / 1e6;
+    arm();
+}
+
+QVector<FrameScheduler::Stats> FrameScheduler::stats() const
+{
+    QVector<Stats> out;
+    for (const Subscriber &s : m_subscribers) {
+        Stats st = s.stats;
+        if (!s.widget->objectName().isEmpty())
+            st.name += ":" + s.widget->objectName();
+        out << st;
+    }
+    return out;
+}
+
+bool FrameScheduler::eventFilter(QObject *watched, QEvent *event)
+{
+    Subscriber *s = find(watched);
+    if (!s)
+        return false;
+
+    switch (event->type()) {
+    case QEvent::Show:
+        // Also sent to children when a hidden parent, e.g. a stack page, is shown
+        if (!s->stats.visible) {
+            s->stats.visible = true;
+            s->due = std::ceil(now());
+            arm();
+        }
+        break;
+    case QEvent::Hide:
+        if (s->stats.visible) {
+            s->stats.visible = false;
+            arm();
+        }
+        break;
+    default:
+        break;
+    }
+    return false;
+}
+
+FrameScheduler::PaintTimer::PaintTimer(QWidget *widget)
+    : m_widget(widget)
+{
+    m_cost.start();
+}
+
+// The filter only sees a paint before the widget handles it, so the end is
+// marked from inside paintEvent instead
+FrameScheduler::PaintTimer::~PaintTimer()
+{
+    if (Subscriber *s = instance().find(m_widget)) {
+        s->stats.paints++;
+        smooth(s->stats.paintCostUs, m_cost.nsecsElapsed() / 1000);
+    }
+}
+
+void FrameScheduler::arm()
+{
+    double next = -1.0;
+    for (const Subscriber &s : m_subscribers) {
+        if (runnable(s) && (next < 0.0 || s.due < next))
+            next = s.due;
+    }
+    if (next < 0.0) {
+        m_timer.stop();
+        return;
+    }
+
+    // Onto the grid: the first step at or after the earliest due tick
+    const double step = std::ceil(next - EARLY_STEPS);
+    const double waitMs = (step - now()) * 1000.0 / CLOCK_HZ;
+    m_timer.start(std::max(0, static_cast<int>(std::ceil(waitMs))));
+}
+
+void FrameScheduler::onTimer()
+{
+    const double step = std::floor(now() + EARLY_STEPS);
+
+    // Subscribers may re-schedule themselves while ticking, so go by index
+    // and look each one up again afterwards
+    for (int i = 0; i < m_subscribers.size(); i++) {
+        Subscriber &s = m_subscribers[i];
+        if (!runnable(s) || s.due > step + EARLY_STEPS)
+            continue;
+
+        if (step - s.due >= 1.0)
+            s.stats.late++;
+        // A subscriber that fell behind picks up from now rather than
+        // ticking back to back to catch up
+        s.due += s.interval;
+        if (s.due <= step)
+            s.due = step + s.interval;
+
+        QWidget *widget = s.widget;
+        const std::function<void()> tick = s.tick;
+        QElapsedTimer cost;
+        cost.start();
+        tick();
+        if (Subscriber *ticked = find(widget)) {
+            ticked->stats.ticks++;
+            smooth(ticked->stats.tickCostUs, cost.nsecsElapsed() / 1000);
+        }
+    }
+    arm();
+}
@@ -0,0 +1,104 @@
+#ifndef FRAMESCHEDULER_H
+#define FRAMESCHEDULER_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+#include <functional>
+
+class QWidget;
+
+// One clock for every animated widget: Geiss, AVS, the screensaver, and the
+// player's spectrum and title scroller. Ticks fall on a shared 60 Hz grid
+// and each subscriber takes every Nth step of it for its own interval, so
+// they all wake together instead of on separate timers drifting against
+// each other. Intervals that aren't a whole number of steps (25 FPS) keep
+// their average rate by alternating step counts.
+//
+// A subscriber only ticks while its widget is shown, which includes every
+// parent up to the window, and while it is active. Views in the stack that
+// aren't on screen cost nothing, and with no subscriber left to tick the
+// clock stops altogether.
+//
+// Tick and paint times are measured per subscriber, for the API. Paints are
+// timed by the subscriber itself, with a PaintTimer in its paintEvent.
+class FrameScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Stats {
+        QString name;
+        bool visible = false;
+        bool active = false;
+        int intervalUs = 0;
+        quint64 ticks = 0;     // since launch
+        quint64 late = 0;      // ticks that came a grid step or more after they were due
+        quint64 paints = 0;
+        double tickCostUs = 0.0;  // smoothed
+        double paintCostUs = 0.0; // smoothed
+    };
+
+    // Times a subscriber's paint for stats(): make one at the top of its
+    // paintEvent. Does nothing for a widget that isn't subscribed.
+    class PaintTimer
+    {
+    public:
+        explicit PaintTimer(QWidget *widget);
+        ~PaintTimer();
+        PaintTimer(const PaintTimer &) = delete;
+        PaintTimer &operator=(const PaintTimer &) = delete;
+
+    private:
+        QWidget *m_widget;
+        QElapsedTimer m_cost;
+    };
+
+    static constexpr int CLOCK_HZ = 60;
+
+    static FrameScheduler &instance();
+
+    // Calls tick every intervalUs while widget is visible and active. The
+    // subscription ends with the widget. name labels it in stats(), followed
+    // by the widget's object name if it has one.
+    void subscribe(QWidget *widget, const QString &name, int intervalUs,
+                   const std::function<void()> &tick);
+    void setInterval(QWidget *widget, int intervalUs);
+    // Subscribers start out active; an inactive one doesn't tick even while
+    // shown, e.g. the spectrum while nothing plays
+    void setActive(QWidget *widget, bool active);
+    // Moves the next tick to delayUs from now, for a widget that knows when
+    // it next changes; ticks after it come at the interval again
+    void scheduleTick(QWidget *widget, int delayUs);
+
+    QVector<Stats> stats() const;
+
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    struct Subscriber {
+        QWidget *widget = nullptr;
+        std::function<void()> tick;
+        double interval = 1.0; // in grid steps
+        double due = 0.0;      // grid step of the next tick
+        Stats stats;
+    };
+
+    explicit FrameScheduler(QObject *parent = nullptr);
+
+    Subscriber *find(const QObject *widget);
+    static bool runnable(const Subscriber &s) { return s.stats.visible && s.stats.active; }
+    static double stepsFor(int intervalUs);
+    double now() const; // in grid steps
+    void arm();
+    void onTimer();
+
+    QVector<Subscriber> m_subscribers; // a handful, searched linearly
+    QElapsedTimer m_clock;
+    QTimer m_timer;
+};
+
+#endif // FRAMESCHEDULER_H
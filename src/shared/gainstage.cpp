@@ -0,0 +1,292 @@
+#include "gainstage.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+// --- Scalar reference ---
+//
+// Kernels take samples four at a time, whatever the channel count: sample i
+// is scaled by gain[i % 4], and after every fourth sample each gain grows by
+// its step. Integer results round to nearest, ties to even, and saturate.
+
+void scaleInt16Scalar(int16_t *s, int count, float *gain, const float *step)
+{
+    for (int i = 0; i < count; i++) {
+        const int lane = i & 3;
+        const long r = std::lrint(s[i] * gain[lane]);
+        s[i] = static_cast<int16_t>(std::clamp(r, -32768L, 32767L));
+        if (lane == 3) {
+            for (int l = 0; l < 4; l++)
+                gain[l] += step[l];
+        }
+    }
+}
+
+void scaleFloatScalar(float *s, int count, float *gain, const float *step)
+{
+    for (int i = 0; i < count; i++) {
+        const int lane = i & 3;
+        s[i] *= gain[lane];
+        if (lane == 3) {
+            for (int l = 0; l < 4; l++)
+                gain[l] += step[l];
+        }
+    }
+}
+
+// Any format and channel count, a frame at a time, for what the kernels
+// don't cover: UInt8, Int32 and 3, 5 or more channels
+void scaleFrames(char *data, int frames, int channels, int bytesPerFrame,
+                 QAudioFormat::SampleFormat format, float *gain, const float *step)
+{
+    for (int f = 0; f < frames; f++) {
+        for (int c = 0; c < channels; c++) {
+            switch (format) {
+            case QAudioFormat::UInt8: {
+                uint8_t *s = reinterpret_cast<uint8_t *>(data) + c;
+                const long r = std::lrint((*s - 128) * gain[c]);
+                *s = static_cast<uint8_t>(std::clamp(r, -128L, 127L) + 128);
+                break;
+            }
+            case QAudioFormat::Int16: {
+                int16_t *s = reinterpret_cast<int16_t *>(data) + c;
+                const long r = std::lrint(*s * gain[c]);
+                *s = static_cast<int16_t>(std::clamp(r, -32768L, 32767L));
+                break;
+            }
+            case QAudioFormat::Int32: {
+                // float has too few bits for these
+                int32_t *s = reinterpret_cast<int32_t *>(data) + c;
+                const long long r = std::llrint(static_cast<double>(*s) * gain[c]);
+                *s = static_cast<int32_t>(std::clamp(r, -2147483648LL, 2147483647LL));
+                break;
+            }
+            case QAudioFormat::Float:
+                reinterpret_cast<float *>(data)[c] *= gain[c];
+                break;
+            default:
+                return;
+            }
+        }
+        for (int c = 0; c < channels; c++)
+            gain[c] += step[c];
+        data += bytesPerFrame;
+    }
+}
+
+#if defined(__SSE2__)
+
+// --- SIMD ---
+//
+// Eight Int16 or four Float samples per step; the remainder goes through the
+// scalar reference, starting at lane 0. Int16 is widened to int32 and scaled
+// in float, then cvtps rounds to nearest even and packs saturates.
+
+void scaleInt16(int16_t *s, int count, float *gain, const float *step)
+{
+    __m128 g = _mm_loadu_ps(gain);
+    const __m128 st = _mm_loadu_ps(step);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + i));
+        const __m128i sign = _mm_srai_epi16(v, 15);
+        const __m128 lo = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v, sign)), g);
+        g = _mm_add_ps(g, st);
+        const __m128 hi = _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v, sign)), g);
+        g = _mm_add_ps(g, st);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(s + i),
+                         _mm_packs_epi32(_mm_cvtps_epi32(lo), _mm_cvtps_epi32(hi)));
+    }
+    _mm_storeu_ps(gain, g);
+    scaleInt16Scalar(s + i, count - i, gain, step);
+}
+
+void scaleFloat(float *s, int count, float *gain, const float *step)
+{
+    __m128 g = _mm_loadu_ps(gain);
+    const __m128 st = _mm_loadu_ps(step);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm_storeu_ps(s + i, _mm_mul_ps(_mm_loadu_ps(s + i), g));
+        g = _mm_add_ps(g, st);
+    }
+    _mm_storeu_ps(gain, g);
+    scaleFloatScalar(s + i, count - i, gain, step);
+}
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+// As for SSE2. vcvtnq (AArch64 only) rounds to nearest even and vqmovn
+// saturates; 32-bit ARM takes the scalar path.
+
+void scaleInt16(int16_t *s, int count, float *gain, const float *step)
+{
+    float32x4_t g = vld1q_f32(gain);
+    const float32x4_t st = vld1q_f32(step);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const int16x8_t v = vld1q_s16(s + i);
+        const float32x4_t lo = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(v))), g);
+        g = vaddq_f32(g, st);
+        const float32x4_t hi = vmulq_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(v))), g);
+        g = vaddq_f32(g, st);
+        vst1q_s16(s + i, vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(lo)), vqmovn_s32(vcvtnq_s32_f32(hi))));
+    }
+    vst1q_f32(gain, g);
+    scaleInt16Scalar(s + i, count - i, gain, step);
+}
+
+void scaleFloat(float *s, int count, float *gain, const float *step)
+{
+    float32x4_t g = vld1q_f32(gain);
+    const float32x4_t st = vld1q_f32(step);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        vst1q_f32(s + i, vmulq_f32(vld1q_f32(s + i), g));
+        g = vaddq_f32(g, st);
+    }
+    vst1q_f32(gain, g);
+    scaleFloatScalar(s + i, count - i, gain, step);
+}
+
+#else
+
+void scaleInt16(int16_t *s, int count, float *gain, const float *step)
+{
+    scaleInt16Scalar(s, count, gain, step);
+}
+
+void scaleFloat(float *s, int count, float *gain, const float *step)
+{
+    scaleFloatScalar(s, count, gain, step);
+}
+
+#endif
+
+} // namespace
+
+void GainStage::setFormat(const QAudioFormat &format)
+{
+    m_sampleFormat = format.sampleFormat();
+    m_channels = format.channelCount();
+    m_bytesPerFrame = format.bytesPerFrame();
+    m_rampFrames = std::max(1, format.sampleRate() * RAMP_MS / 1000);
+    m_rampLeft = 0;
+
+    if (m_channels > MAX_CHANNELS) {
+        qWarning() << "[gain]" << m_channels << "channels, leaving volume and balance to the mixer";
+        return;
+    }
+    targetGains(m_target);
+    std::copy(m_target, m_target + m_channels, m_gain);
+}
+
+void GainStage::setVolume(float volume)
+{
+    m_volume = std::clamp(volume, 0.0f, 1.0f);
+}
+
+void GainStage::setBalance(float balance)
+{
+    m_balance = std::clamp(balance, -1.0f, 1.0f);
+}
+
+void GainStage::targetGains(float *gains) const
+{
+    const float v = m_volume;
+    const float volume = v * v * v;
+
+    // Pan angle from 0 (left) through pi/4 (centre) to pi/2 (right); the
+    // centre is pinned so it stays exactly unity. Each side is capped at
+    // unity so balance only ever attenuates, like the mixer did.
+    const float b = m_balance;
+    float left = 1.0f;
+    float right = 1.0f;
+    if (b != 0.0f) {
+        const float angle = (b + 1.0f) * static_cast<float>(M_PI) / 4.0f;
+        left = std::clamp(static_cast<float>(M_SQRT2) * std::cos(angle), 0.0f, 1.0f);
+        right = std::clamp(static_cast<float>(M_SQRT2) * std::sin(angle), 0.0f, 1.0f);
+    }
+
+    for (int c = 0; c < m_channels; c++)
+        gains[c] = volume;
+    if (m_channels >= 2) {
+        gains[0] *= left;
+        gains[1] *= right;
+    }
+}
+
+void GainStage::apply(char *data, int frames, const float *step)
+{
+    float gain[MAX_CHANNELS];
+    std::copy(m_gain, m_gain + m_channels, gain);
+
+    const bool simd = (m_sampleFormat == QAudioFormat::Int16 || m_sampleFormat == QAudioFormat::Float)
+                      && 4 % m_channels == 0;
+    if (simd) {
+        // Lay the channels out over the kernels' four lanes: with two
+        // channels a group of four samples is two frames, so lane 2 is the
+        // left channel one frame on and every lane steps two frames at once
+        const int framesPerGroup = 4 / m_channels;
+        float lanes[4];
+        float laneStep[4];
+        for (int l = 0; l < 4; l++) {
+            const int c = l % m_channels;
+            lanes[l] = gain[c] + step[c] * (l / m_channels);
+            laneStep[l] = step[c] * framesPerGroup;
+        }
+        const int samples = frames * m_channels;
+        if (m_sampleFormat == QAudioFormat::Int16)
+            scaleInt16(reinterpret_cast<int16_t *>(data), samples, lanes, laneStep);
+        else
+            scaleFloat(reinterpret_cast<float *>(data), samples, lanes, laneStep);
+    } else {
+        scaleFrames(data, frames, m_channels, m_bytesPerFrame, m_sampleFormat, gain, step);
+    }
+
+    for (int c = 0; c < m_channels; c++)
+        m_gain[c] += step[c] * frames;
+}
+
+void GainStage::process(char *data, qint64 bytes)
+{
+    if (m_channels <= 0 || m_channels > MAX_CHANNELS || m_bytesPerFrame <= 0)
+        return;
+
+    // A new target restarts the ramp from wherever the gains are now
+    float target[MAX_CHANNELS];
+    targetGains(target);
+    if (!std::equal(target, target + m_channels, m_target)) {
+        std::copy(target, target + m_channels, m_target);
+        for (int c = 0; c < m_channels; c++)
+            m_step[c] = (m_target[c] - m_gain[c]) / m_rampFrames;
+        m_rampLeft = m_rampFrames;
+    }
+
+    int frames = static_cast<int>(bytes / m_bytesPerFrame);
+    if (m_rampLeft > 0 && frames > 0) {
+        const int n = std::min(frames, m_rampLeft);
+        apply(data, n, m_step);
+        data += n * m_bytesPerFrame;
+        frames -= n;
+        m_rampLeft -= n;
+        if (m_rampLeft == 0)
+            std::copy(m_target, m_target + m_channels, m_gain);
+    }
+
+    if (frames <= 0)
+        return;
+    if (std::all_of(m_gain, m_gain + m_channels, [](float g) { return g == 1.0f; }))
+        return;
+    const float hold[MAX_CHANNELS] = {};
+    apply(data, frames, hold);
+}
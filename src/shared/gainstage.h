@@ -0,0 +1,57 @@
+#ifndef GAINSTAGE_H
+#define GAINSTAGE_H
+
+#include <QAudioFormat>
+#include <atomic>
+
+// Volume and balance applied to PCM on its way to the audio output, for
+// outputs where the ALSA mixer can't or shouldn't do it. A new setting is
+// reached by a linear per-sample ramp over RAMP_MS rather than in one step,
+// so moving a slider doesn't put steps in the waveform (zipper noise).
+//
+// Volume follows a cubic curve, so the slider feels like a mixer's dB
+// scale. Balance uses a constant-power pan law normalised to unity at the
+// centre and capped at unity on each side: the side panned towards keeps
+// full level and the other fades out, so balance never adds gain. Channels
+// past the front pair take the volume only.
+//
+// Int16 and Float samples are scaled with SSE2 or NEON (AArch64) when
+// built for it, and the remaining formats with the scalar reference, which
+// the SIMD paths match bit for bit.
+//
+// setVolume() and setBalance() may be called from any thread; process()
+// belongs to the thread feeding the output.
+class GainStage
+{
+public:
+    static constexpr int RAMP_MS = 10;
+    static constexpr int MAX_CHANNELS = 8;
+
+    // Also snaps to the current target, as there is nothing to ramp from
+    void setFormat(const QAudioFormat &format);
+    void setVolume(float volume);   // 0.0 - 1.0, slider position
+    void setBalance(float balance); // -1.0 (left) to 1.0 (right)
+
+    // Scales the whole frames of interleaved samples in data in place. A
+    // format with more than MAX_CHANNELS channels is left untouched.
+    void process(char *data, qint64 bytes);
+
+private:
+    void targetGains(float *gains) const;
+    void apply(char *data, int frames, const float *step);
+
+    std::atomic<float> m_volume{1.0f};
+    std::atomic<float> m_balance{0.0f};
+
+    QAudioFormat::SampleFormat m_sampleFormat = QAudioFormat::Unknown;
+    int m_channels = 0;
+    int m_bytesPerFrame = 0;
+    int m_rampFrames = 1;
+
+    float m_gain[MAX_CHANNELS] = {};   // where the ramp is now
+    float m_target[MAX_CHANNELS] = {};
+    float m_step[MAX_CHANNELS] = {};   // per frame
+    int m_rampLeft = 0;                // frames
+};
+
+#endif // GAINSTAGE_H
@@ -0,0 +1,678 @@
+#include "pixelkernels.h"
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// --- Scalar reference ---
+
+void PixelKernels::Scalar::addSaturate(uint32_t *dst, const uint32_t *src, int count)
+{
+    for (int i = 0; i < count; i++)
+        dst[i] = PixelKernels::addSaturate(dst[i], src[i]);
+}
+
+void PixelKernels::Scalar::maxBlend(uint32_t *dst, const uint32_t *src, int count)
+{
+    for (int i = 0; i < count; i++)
+        dst[i] = maxPixel(dst[i], src[i]);
+}
+
+void PixelKernels::Scalar::averageBlend(uint32_t *dst, const uint32_t *src, int count)
+{
+    for (int i = 0; i < count; i++) {
+        uint32_t d = dst[i];
+        uint32_t s = src[i];
+        dst[i] = (((d ^ s) & 0xFEFEFEFE) >> 1) + (d & s);
+    }
+}
+
+void PixelKernels::Scalar::alphaBlend(uint32_t *dst, const uint32_t *src, int count, int alpha)
+{
+    uint32_t a = static_cast<uint32_t>(std::clamp(alpha, 0, 256));
+    uint32_t ia = 256 - a;
+
+    // Two channels per multiply; each lane peaks at 255 * 256 so none spill
+    for (int i = 0; i < count; i++) {
+        uint32_t d = dst[i];
+        uint32_t s = src[i];
+        uint32_t rb = (((s & 0x00FF00FF) * a + (d & 0x00FF00FF) * ia) >> 8) & 0x00FF00FF;
+        uint32_t ag = (((s >> 8) & 0x00FF00FF) * a + ((d >> 8) & 0x00FF00FF) * ia) & 0xFF00FF00;
+        dst[i] = rb | ag;
+    }
+}
+
+void PixelKernels::Scalar::fadeToward(uint32_t *px, int count, uint32_t color, int step)
+{
+    int s = std::clamp(step, 0, 255);
+
+    for (int i = 0; i < count; i++) {
+        uint32_t p = px[i];
+        uint32_t out = p & 0xFF000000;
+        for (int shift = 0; shift < 24; shift += 8) {
+            int c = (p >> shift) & 0xFF;
+            int t = (color >> shift) & 0xFF;
+            c = (c > t) ? std::max(c - s, t) : std::min(c + s, t);
+            out |= static_cast<uint32_t>(c) << shift;
+        }
+        px[i] = out;
+    }
+}
+
+void PixelKernels::Scalar::modulate(const uint32_t *src, uint32_t *dst, int count, uint32_t color)
+{
+    uint32_t f[4];
+    for (int c = 0; c < 4; c++)
+        f[c] = ((color >> (c * 8)) & 0xFF) + 1;
+
+    for (int i = 0; i < count; i++) {
+        uint32_t s = src[i];
+        uint32_t out = 0;
+        for (int c = 0; c < 4; c++)
+            out |= ((((s >> (c * 8)) & 0xFF) * f[c]) >> 8) << (c * 8);
+        dst[i] = out;
+    }
+}
+
+void PixelKernels::Scalar::blur3x3(const uint32_t *src, uint32_t *dst, int width, int height)
+{
+    int w = width;
+    int h = height;
+
+    std::copy(src, src + w, dst);
+    std::copy(src + (h - 1) * w, src + h * w, dst + (h - 1) * w);
+
+    for (int y = 1; y < h - 1; y++)
+        blurRow3x3(src + (y - 1) * w, src + y * w, src + (y + 1) * w, dst + y * w, w);
+}
+
+void PixelKernels::Scalar::blurRow3x3(const uint32_t *above, const uint32_t *row, const uint32_t *below,
+                                      uint32_t *out, int width)
+{
+    out[0] = row[0];
+    out[width - 1] = row[width - 1];
+
+    for (int x = 1; x < width - 1; x++) {
+        uint32_t p = 0;
+        for (int shift = 0; shift < 32; shift += 8) {
+            uint32_t sum = 0;
+            for (int dx = -1; dx <= 1; dx++) {
+                sum += (above[x + dx] >> shift) & 0xFF;
+                sum += (row[x + dx] >> shift) & 0xFF;
+                sum += (below[x + dx] >> shift) & 0xFF;
+            }
+            p |= (sum / 9) << shift;
+        }
+        out[x] = p;
+    }
+}
+
+void PixelKernels::Scalar::boxBlurH(const uint32_t *src, uint32_t *dst, int width, int height,
+                                    int srcStride, int dstStride, int radius)
+{
+    const int divisor = 2 * radius + 1;
+    const int wMax = width - 1;
+
+    for (int y = 0; y < height; y++) {
+        const uint32_t *sl = src + y * srcStride;
+        uint32_t *dl = dst + y * dstStride;
+        int sum[4] = {0, 0, 0, 0};
+
+        for (int x = -radius; x <= radius; x++) {
+            uint32_t p = sl[std::clamp(x, 0, wMax)];
+            for (int c = 0; c < 4; c++)
+                sum[c] += (p >> (c * 8)) & 0xFF;
+        }
+        for (int x = 0; x < width; x++) {
+            uint32_t out = 0;
+            for (int c = 0; c < 4; c++)
+                out |= static_cast<uint32_t>(sum[c] / divisor) << (c * 8);
+            dl[x] = out;
+
+            uint32_t add = sl[std::min(x + radius + 1, wMax)];
+            uint32_t sub = sl[std::max(x - radius, 0)];
+            for (int c = 0; c < 4; c++)
+                sum[c] += static_cast<int>((add >> (c * 8)) & 0xFF) - static_cast<int>((sub >> (c * 8)) & 0xFF);
+        }
+    }
+}
+
+void PixelKernels::Scalar::boxBlurV(const uint32_t *src, uint32_t *dst, int width, int height,
+                                    int srcStride, int dstStride, int radius)
+{
+    const int divisor = 2 * radius + 1;
+    const int hMax = height - 1;
+
+    for (int x = 0; x < width; x++) {
+        int sum[4] = {0, 0, 0, 0};
+
+        for (int y = -radius; y <= radius; y++) {
+            uint32_t p = src[std::clamp(y, 0, hMax) * srcStride + x];
+            for (int c = 0; c < 4; c++)
+                sum[c] += (p >> (c * 8)) & 0xFF;
+        }
+        for (int y = 0; y < height; y++) {
+            uint32_t out = 0;
+            for (int c = 0; c < 4; c++)
+                out |= static_cast<uint32_t>(sum[c] / divisor) << (c * 8);
+            dst[y * dstStride + x] = out;
+
+            uint32_t add = src[std::min(y + radius + 1, hMax) * srcStride + x];
+            uint32_t sub = src[std::max(y - radius, 0) * srcStride + x];
+            for (int c = 0; c < 4; c++)
+                sum[c] += static_cast<int>((add >> (c * 8)) & 0xFF) - static_cast<int>((sub >> (c * 8)) & 0xFF);
+        }
+    }
+}
+
+void PixelKernels::Scalar::scaleNearest(const uint32_t *src, int srcWidth, int srcHeight, int srcStride,
+                                        uint32_t *dst, int dstWidth, int dstHeight, int dstStride)
+{
+    if (srcWidth <= 0 || srcHeight <= 0 || dstWidth <= 0 || dstHeight <= 0)
+        return;
+
+    std::vector<int> columns(dstWidth);
+    for (int x = 0; x < dstWidth; x++)
+        columns[x] = static_cast<int>(int64_t(x) * srcWidth / dstWidth);
+
+    int lastRow = -1;
+    for (int y = 0; y < dstHeight; y++) {
+        int sy = static_cast<int>(int64_t(y) * srcHeight / dstHeight);
+        uint32_t *dl = dst + y * dstStride;
+        if (sy == lastRow) {
+            std::memcpy(dl, dl - dstStride, dstWidth * sizeof(uint32_t));
+            continue;
+        }
+        lastRow = sy;
+        const uint32_t *sl = src + sy * srcStride;
+        for (int x = 0; x < dstWidth; x++)
+            dl[x] = sl[columns[x]] | 0xFF000000;
+    }
+}
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+
+// --- SIMD ---
+//
+// 16 bytes (4 pixels) per step for the byte-wise kernels; the remainder goes
+// through the scalar reference. The box blurs keep one pixel's four channel
+// sums in a vector and divide with a float reciprocal: for sums below 2^24,
+// (sum + 0.5) / divisor never crosses an integer boundary, so truncating it
+// gives the same result as the integer division in the reference.
+
+namespace {
+
+#if defined(__SSE2__)
+
+using Bytes = __m128i;
+using Sums = __m128i;
+
+inline Bytes load(const uint32_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+inline void store(uint32_t *p, Bytes v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+
+inline Bytes addSat(Bytes a, Bytes b) { return _mm_adds_epu8(a, b); }
+inline Bytes maxBytes(Bytes a, Bytes b) { return _mm_max_epu8(a, b); }
+inline Bytes floorAverage(Bytes a, Bytes b)
+{
+    // pavgb rounds up; take the odd bit back off
+    Bytes odd = _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi8(1));
+    return _mm_sub_epi8(_mm_avg_epu8(a, b), odd);
+}
+inline Bytes fade(Bytes c, Bytes target, Bytes step)
+{
+    return _mm_min_epu8(_mm_max_epu8(_mm_subs_epu8(c, step), target), _mm_adds_epu8(c, step));
+}
+inline Bytes splatPixel(uint32_t p) { return _mm_set1_epi32(static_cast<int>(p)); }
+inline Bytes orBytes(Bytes a, Bytes b) { return _mm_or_si128(a, b); }
+
+// Each of the four pixels twice, in order
+inline void doublePixels(Bytes v, Bytes &lo, Bytes &hi)
+{
+    lo = _mm_unpacklo_epi32(v, v);
+    hi = _mm_unpackhi_epi32(v, v);
+}
+// Pixel N in all four lanes
+template <int N>
+inline Bytes splatLane(Bytes v) { return _mm_shuffle_epi32(v, N * 0x55); }
+
+inline Bytes alphaMix(Bytes d, Bytes s, uint16_t a)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i wa = _mm_set1_epi16(static_cast<short>(a));
+    __m128i wi = _mm_set1_epi16(static_cast<short>(256 - a));
+    __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), wa),
+                               _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), wi));
+    __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), wa),
+                               _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), wi));
+    return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+}
+
+// Per-channel factors (1-256) of a pixel, repeated for two pixels
+using Factors = __m128i;
+inline Factors pixelFactors(uint32_t color)
+{
+    __m128i c = _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(color)), _mm_setzero_si128());
+    c = _mm_add_epi16(c, _mm_set1_epi16(1));
+    return _mm_unpacklo_epi64(c, c);
+}
+inline Bytes modulateBytes(Bytes s, Factors f)
+{
+    // Products stay below 2^16, so the low halves are exact
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), f);
+    __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), f);
+    return _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8));
+}
+
+inline Sums sumsZero() { return _mm_setzero_si128(); }
+inline Sums sumsLoad(const int32_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+inline void sumsStore(int32_t *p, Sums v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+inline Sums sumsAdd(Sums a, Sums b) { return _mm_add_epi32(a, b); }
+inline Sums sumsSub(Sums a, Sums b) { return _mm_sub_epi32(a, b); }
+inline Sums widen(uint32_t p)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i v = _mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(p)), zero);
+    return _mm_unpacklo_epi16(v, zero);
+}
+inline uint32_t divide(Sums sum, float inv)
+{
+    __m128 f = _mm_mul_ps(_mm_add_ps(_mm_cvtepi32_ps(sum), _mm_set1_ps(0.5f)), _mm_set1_ps(inv));
+    __m128i q = _mm_cvttps_epi32(f);
+    q = _mm_packs_epi32(q, q);
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(q, q)));
+}
+
+// Vertical 3-tap sums of 4 pixels as 8 + 8 channel sums
+inline void columnSums3(const uint32_t *a, const uint32_t *b, const uint32_t *c, uint16_t *out)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i va = load(a), vb = load(b), vc = load(c);
+    __m128i lo = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(va, zero), _mm_unpacklo_epi8(vb, zero)),
+                               _mm_unpacklo_epi8(vc, zero));
+    __m128i hi = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(va, zero), _mm_unpackhi_epi8(vb, zero)),
+                               _mm_unpackhi_epi8(vc, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), lo);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 8), hi);
+}
+
+// Horizontal 3-tap of column sums divided by 9 for 4 pixels; v points at the
+// sums of the pixel left of the first output. x * 7282 >> 16 == x / 9 for
+// every sum up to 9 * 255.
+inline Bytes rowDivide9(const uint16_t *v)
+{
+    auto at = [v](int i) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(v + i)); };
+    const __m128i ninth = _mm_set1_epi16(7282);
+    __m128i lo = _mm_add_epi16(_mm_add_epi16(at(0), at(4)), at(8));
+    __m128i hi = _mm_add_epi16(_mm_add_epi16(at(8), at(12)), at(16));
+    return _mm_packus_epi16(_mm_mulhi_epu16(lo, ninth), _mm_mulhi_epu16(hi, ninth));
+}
+
+#else // __ARM_NEON
+
+using Bytes = uint8x16_t;
+using Sums = int32x4_t;
+
+inline Bytes load(const uint32_t *p) { return vld1q_u8(reinterpret_cast<const uint8_t *>(p)); }
+inline void store(uint32_t *p, Bytes v) { vst1q_u8(reinterpret_cast<uint8_t *>(p), v); }
+
+inline Bytes addSat(Bytes a, Bytes b) { return vqaddq_u8(a, b); }
+inline Bytes maxBytes(Bytes a, Bytes b) { return vmaxq_u8(a, b); }
+inline Bytes floorAverage(Bytes a, Bytes b) { return vhaddq_u8(a, b); }
+inline Bytes fade(Bytes c, Bytes target, Bytes step)
+{
+    return vminq_u8(vmaxq_u8(vqsubq_u8(c, step), target), vqaddq_u8(c, step));
+}
+inline Bytes splatPixel(uint32_t p) { return vreinterpretq_u8_u32(vdupq_n_u32(p)); }
+inline Bytes orBytes(Bytes a, Bytes b) { return vorrq_u8(a, b); }
+
+inline void doublePixels(Bytes v, Bytes &lo, Bytes &hi)
+{
+    uint32x4x2_t z = vzipq_u32(vreinterpretq_u32_u8(v), vreinterpretq_u32_u8(v));
+    lo = vreinterpretq_u8_u32(z.val[0]);
+    hi = vreinterpretq_u8_u32(z.val[1]);
+}
+template <int N>
+inline Bytes splatLane(Bytes v) { return vreinterpretq_u8_u32(vdupq_n_u32(vgetq_lane_u32(vreinterpretq_u32_u8(v), N))); }
+
+inline Bytes alphaMix(Bytes d, Bytes s, uint16_t a)
+{
+    uint16_t ia = static_cast<uint16_t>(256 - a);
+    uint16x8_t lo = vmlaq_n_u16(vmulq_n_u16(vmovl_u8(vget_low_u8(s)), a), vmovl_u8(vget_low_u8(d)), ia);
+    uint16x8_t hi = vmlaq_n_u16(vmulq_n_u16(vmovl_u8(vget_high_u8(s)), a), vmovl_u8(vget_high_u8(d)), ia);
+    return vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+}
+
+using Factors = uint16x8_t;
+inline Factors pixelFactors(uint32_t color)
+{
+    uint16x8_t c = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(color)));
+    return vaddq_u16(c, vdupq_n_u16(1));
+}
+inline Bytes modulateBytes(Bytes s, Factors f)
+{
+    uint16x8_t lo = vmulq_u16(vmovl_u8(vget_low_u8(s)), f);
+    uint16x8_t hi = vmulq_u16(vmovl_u8(vget_high_u8(s)), f);
+    return vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8));
+}
+
+inline Sums sumsZero() { return vdupq_n_s32(0); }
+inline Sums sumsLoad(const int32_t *p) { return vld1q_s32(p); }
+inline void sumsStore(int32_t *p, Sums v) { vst1q_s32(p, v); }
+inline Sums sumsAdd(Sums a, Sums b) { return vaddq_s32(a, b); }
+inline Sums sumsSub(Sums a, Sums b) { return vsubq_s32(a, b); }
+inline Sums widen(uint32_t p)
+{
+    uint16x8_t v = vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(p)));
+    return vreinterpretq_s32_u32(vmovl_u16(vget_low_u16(v)));
+}
+inline uint32_t divide(Sums sum, float inv)
+{
+    float32x4_t f = vmulq_n_f32(vaddq_f32(vcvtq_f32_s32(sum), vdupq_n_f32(0.5f)), inv);
+    uint16x4_t q16 = vmovn_u32(vcvtq_u32_f32(f));
+    uint8x8_t q8 = vmovn_u16(vcombine_u16(q16, q16));
+    return vget_lane_u32(vreinterpret_u32_u8(q8), 0);
+}
+
+inline void columnSums3(const uint32_t *a, const uint32_t *b, const uint32_t *c, uint16_t *out)
+{
+    uint8x16_t va = load(a), vb = load(b), vc = load(c);
+    uint16x8_t lo = vaddw_u8(vaddl_u8(vget_low_u8(va), vget_low_u8(vb)), vget_low_u8(vc));
+    uint16x8_t hi = vaddw_u8(vaddl_u8(vget_high_u8(va), vget_high_u8(vb)), vget_high_u8(vc));
+    vst1q_u16(out, lo);
+    vst1q_u16(out + 8, hi);
+}
+
+inline Bytes rowDivide9(const uint16_t *v)
+{
+    uint16x8_t lo = vaddq_u16(vaddq_u16(vld1q_u16(v), vld1q_u16(v + 4)), vld1q_u16(v + 8));
+    uint16x8_t hi = vaddq_u16(vaddq_u16(vld1q_u16(v + 8), vld1q_u16(v + 12)), vld1q_u16(v + 16));
+    auto div9 = [](uint16x8_t x) {
+        uint16x4_t l = vshrn_n_u32(vmull_n_u16(vget_low_u16(x), 7282), 16);
+        uint16x4_t h = vshrn_n_u32(vmull_n_u16(vget_high_u16(x), 7282), 16);
+        return vmovn_u16(vcombine_u16(l, h));
+    };
+    return vcombine_u8(div9(lo), div9(hi));
+}
+
+#endif
+
+} // namespace
+
+void PixelKernels::addSaturate(uint32_t *dst, const uint32_t *src, int count)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        store(dst + i, addSat(load(dst + i), load(src + i)));
+    Scalar::addSaturate(dst + i, src + i, count - i);
+}
+
+void PixelKernels::maxBlend(uint32_t *dst, const uint32_t *src, int count)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        store(dst + i, maxBytes(load(dst + i), load(src + i)));
+    Scalar::maxBlend(dst + i, src + i, count - i);
+}
+
+void PixelKernels::averageBlend(uint32_t *dst, const uint32_t *src, int count)
+{
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        store(dst + i, floorAverage(load(dst + i), load(src + i)));
+    Scalar::averageBlend(dst + i, src + i, count - i);
+}
+
+void PixelKernels::alphaBlend(uint32_t *dst, const uint32_t *src, int count, int alpha)
+{
+    uint16_t a = static_cast<uint16_t>(std::clamp(alpha, 0, 256));
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        store(dst + i, alphaMix(load(dst + i), load(src + i), a));
+    Scalar::alphaBlend(dst + i, src + i, count - i, alpha);
+}
+
+void PixelKernels::fadeToward(uint32_t *px, int count, uint32_t color, int step)
+{
+    // A zero step in the alpha byte leaves alpha as it is
+    uint32_t s = static_cast<uint32_t>(std::clamp(step, 0, 255));
+    Bytes stepv = splatPixel(s * 0x00010101);
+    Bytes target = splatPixel(color);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        store(px + i, fade(load(px + i), target, stepv));
+    Scalar::fadeToward(px + i, count - i, color, step);
+}
+
+void PixelKernels::modulate(const uint32_t *src, uint32_t *dst, int count, uint32_t color)
+{
+    const Factors f = pixelFactors(color);
+    int i = 0;
+    for (; i + 4 <= count; i += 4)
+        store(dst + i, modulateBytes(load(src + i), f));
+    Scalar::modulate(src + i, dst + i, count - i, color);
+}
+
+void PixelKernels::blur3x3(const uint32_t *src, uint32_t *dst, int width, int height)
+{
+    int w = width;
+    int h = height;
+
+    std::copy(src, src + w, dst);
+    std::copy(src + (h - 1) * w, src + h * w, dst + (h - 1) * w);
+
+    for (int y = 1; y < h - 1; y++)
+        blurRow3x3(src + (y - 1) * w, src + y * w, src + (y + 1) * w, dst + y * w, w);
+}
+
+void PixelKernels::blurRow3x3(const uint32_t *above, const uint32_t *row, const uint32_t *below,
+                              uint32_t *out, int width)
+{
+    if (width < 6) {
+        Scalar::blurRow3x3(above, row, below, out, width);
+        return;
+    }
+
+    out[0] = row[0];
+    out[width - 1] = row[width - 1];
+
+    // Column sums of the three rows, four channels per pixel, for a chunk of
+    // outputs plus the pixel either side of it
+    constexpr int CHUNK = 64;
+    uint16_t v[(CHUNK + 2) * 4];
+
+    for (int x0 = 1; x0 < width - 1; x0 += CHUNK) {
+        int n = std::min(CHUNK, width - 1 - x0);
+        int m = n + 2;
+        const uint32_t *a = above + x0 - 1;
+        const uint32_t *r = row + x0 - 1;
+        const uint32_t *b = below + x0 - 1;
+
+        int i = 0;
+        for (; i + 4 <= m; i += 4)
+            columnSums3(a + i, r + i, b + i, v + i * 4);
+        for (; i < m; i++) {
+            for (int c = 0; c < 4; c++) {
+                v[i * 4 + c] = static_cast<uint16_t>(((a[i] >> (c * 8)) & 0xFF)
+                                                     + ((r[i] >> (c * 8)) & 0xFF)
+                                                     + ((b[i] >> (c * 8)) & 0xFF));
+            }
+        }
+
+        // rowDivide9 reads one pixel past its fourth output
+        int j = 0;
+        for (; j + 4 <= n; j += 4)
+            store(out + x0 + j, rowDivide9(v + j * 4));
+        for (; j < n; j++) {
+            uint32_t p = 0;
+            for (int c = 0; c < 4; c++) {
+                uint32_t sum = v[j * 4 + c] + v[(j + 1) * 4 + c] + v[(j + 2) * 4 + c];
+                p |= (sum / 9) << (c * 8);
+            }
+            out[x0 + j] = p;
+        }
+    }
+}
+
+void PixelKernels::boxBlurH(const uint32_t *src, uint32_t *dst, int width, int height,
+                            int srcStride, int dstStride, int radius)
+{
+    const float inv = 1.0f / (2 * radius + 1);
+    const int wMax = width - 1;
+
+    for (int y = 0; y < height; y++) {
+        const uint32_t *sl = src + y * srcStride;
+        uint32_t *dl = dst + y * dstStride;
+        Sums sum = sumsZero();
+
+        for (int x = -radius; x <= radius; x++)
+            sum = sumsAdd(sum, widen(sl[std::clamp(x, 0, wMax)]));
+        for (int x = 0; x < width; x++) {
+            dl[x] = divide(sum, inv);
+            sum = sumsAdd(sum, widen(sl[std::min(x + radius + 1, wMax)]));
+            sum = sumsSub(sum, widen(sl[std::max(x - radius, 0)]));
+        }
+    }
+}
+
+void PixelKernels::boxBlurV(const uint32_t *src, uint32_t *dst, int width, int height,
+                            int srcStride, int dstStride, int radius)
+{
+    const float inv = 1.0f / (2 * radius + 1);
+    const int hMax = height - 1;
+
+    // Running sums for every column, slid down a row at a time so reads stay
+    // sequential
+    std::vector<int32_t> sums(static_cast<size_t>(width) * 4, 0);
+    int32_t *col = sums.data();
+    for (int y = -radius; y <= radius; y++) {
+        const uint32_t *sl = src + std::clamp(y, 0, hMax) * srcStride;
+        for (int x = 0; x < width; x++)
+            sumsStore(col + x * 4, sumsAdd(sumsLoad(col + x * 4), widen(sl[x])));
+    }
+
+    for (int y = 0; y < height; y++) {
+        const uint32_t *addRow = src + std::min(y + radius + 1, hMax) * srcStride;
+        const uint32_t *subRow = src + std::max(y - radius, 0) * srcStride;
+        uint32_t *dl = dst + y * dstStride;
+        for (int x = 0; x < width; x++) {
+            Sums sum = sumsLoad(col + x * 4);
+            dl[x] = divide(sum, inv);
+            sumsStore(col + x * 4, sumsSub(sumsAdd(sum, widen(addRow[x])), widen(subRow[x])));
+        }
+    }
+}
+
+void PixelKernels::scaleNearest(const uint32_t *src, int srcWidth, int srcHeight, int srcStride,
+                                uint32_t *dst, int dstWidth, int dstHeight, int dstStride)
+{
+    const int factor = srcWidth > 0 && dstWidth % srcWidth == 0 ? dstWidth / srcWidth : 0;
+    if ((factor != 1 && factor != 2 && factor != 4) || srcHeight <= 0 || dstHeight <= 0) {
+        Scalar::scaleNearest(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride);
+        return;
+    }
+
+    const Bytes opaque = splatPixel(0xFF000000);
+    int lastRow = -1;
+    for (int y = 0; y < dstHeight; y++) {
+        int sy = static_cast<int>(int64_t(y) * srcHeight / dstHeight);
+        uint32_t *dl = dst + y * dstStride;
+        if (sy == lastRow) {
+            std::memcpy(dl, dl - dstStride, dstWidth * sizeof(uint32_t));
+            continue;
+        }
+        lastRow = sy;
+        const uint32_t *sl = src + sy * srcStride;
+
+        int x = 0;
+        for (; x + 4 <= srcWidth; x += 4) {
+            Bytes v = orBytes(load(sl + x), opaque);
+            uint32_t *d = dl + x * factor;
+            if (factor == 1) {
+                store(d, v);
+            } else if (factor == 2) {
+                Bytes lo, hi;
+                doublePixels(v, lo, hi);
+                store(d, lo);
+                store(d + 4, hi);
+            } else {
+                store(d, splatLane<0>(v));
+                store(d + 4, splatLane<1>(v));
+                store(d + 8, splatLane<2>(v));
+                store(d + 12, splatLane<3>(v));
+            }
+        }
+        for (; x < srcWidth; x++) {
+            for (int k = 0; k < factor; k++)
+                dl[x * factor + k] = sl[x] | 0xFF000000;
+        }
+    }
+}
+
+#else
+
+void PixelKernels::addSaturate(uint32_t *dst, const uint32_t *src, int count)
+{
+    Scalar::addSaturate(dst, src, count);
+}
+
+void PixelKernels::maxBlend(uint32_t *dst, const uint32_t *src, int count)
+{
+    Scalar::maxBlend(dst, src, count);
+}
+
+void PixelKernels::averageBlend(uint32_t *dst, const uint32_t *src, int count)
+{
+    Scalar::averageBlend(dst, src, count);
+}
+
+void PixelKernels::alphaBlend(uint32_t *dst, const uint32_t *src, int count, int alpha)
+{
+    Scalar::alphaBlend(dst, src, count, alpha);
+}
+
+void PixelKernels::fadeToward(uint32_t *px, int count, uint32_t color, int step)
+{
+    Scalar::fadeToward(px, count, color, step);
+}
+
+void PixelKernels::modulate(const uint32_t *src, uint32_t *dst, int count, uint32_t color)
+{
+    Scalar::modulate(src, dst, count, color);
+}
+
+void PixelKernels::blur3x3(const uint32_t *src, uint32_t *dst, int width, int height)
+{
+    Scalar::blur3x3(src, dst, width, height);
+}
+
+void PixelKernels::blurRow3x3(const uint32_t *above, const uint32_t *row, const uint32_t *below,
+                              uint32_t *out, int width)
+{
+    Scalar::blurRow3x3(above, row, below, out, width);
+}
+
+void PixelKernels::boxBlurH(const uint32_t *src, uint32_t *dst, int width, int height,
+                            int srcStride, int dstStride, int radius)
+{
+    Scalar::boxBlurH(src, dst, width, height, srcStride, dstStride, radius);
+}
+
+void PixelKernels::boxBlurV(const uint32_t *src, uint32_t *dst, int width, int height,
+                            int srcStride, int dstStride, int radius)
+{
+    Scalar::boxBlurV(src, dst, width, height, srcStride, dstStride, radius);
+}
+
+void PixelKernels::scaleNearest(const uint32_t *src, int srcWidth, int srcHeight, int srcStride,
+                                uint32_t *dst, int dstWidth, int dstHeight, int dstStride)
+{
+    Scalar::scaleNearest(src, srcWidth, srcHeight, srcStride, dst, dstWidth, dstHeight, dstStride);
+}
+
+#endif
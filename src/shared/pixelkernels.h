@@ -0,0 +1,89 @@
+#ifndef PIXELKERNELS_H
+#define PIXELKERNELS_H
+
+#include <algorithm>
+#include <cstdint>
+
+// Kernels on packed 32-bit pixels, shared by the AVS, Geiss and screensaver
+// renderers. The four bytes of a pixel are treated alike, so they work on
+// AVS 0xAARRGGBB as well as Qt's RGB32 and ARGB32 layouts; the few that treat
+// alpha specially say so. Span kernels pick an SSE2 or NEON path at compile
+// time. PixelKernels::Scalar holds the portable reference versions, which
+// the SIMD paths match bit for bit (tests/pixelkernelscheck.cpp).
+namespace PixelKernels {
+    // Per-byte saturating add of one pixel
+    inline uint32_t addSaturate(uint32_t a, uint32_t b)
+    {
+        uint32_t low = (a & 0x7F7F7F7F) + (b & 0x7F7F7F7F);
+        uint32_t top = (a ^ b) & 0x80808080;
+        uint32_t carry = ((a & b) | (top & low)) & 0x80808080;
+        return (low ^ top) | ((carry >> 7) * 0xFF);
+    }
+
+    // Per-byte maximum of one pixel
+    inline uint32_t maxPixel(uint32_t a, uint32_t b)
+    {
+        uint32_t r = 0;
+        for (int shift = 0; shift < 32; shift += 8)
+            r |= std::max((a >> shift) & 0xFF, (b >> shift) & 0xFF) << shift;
+        return r;
+    }
+
+    // dst = min(dst + src, 255) per byte
+    void addSaturate(uint32_t *dst, const uint32_t *src, int count);
+    // dst = max(dst, src) per byte
+    void maxBlend(uint32_t *dst, const uint32_t *src, int count);
+    // dst = (dst + src) >> 1 per byte
+    void averageBlend(uint32_t *dst, const uint32_t *src, int count);
+    // dst = (src * alpha + dst * (256 - alpha)) >> 8 per byte, alpha 0-256
+    void alphaBlend(uint32_t *dst, const uint32_t *src, int count, int alpha);
+    // Move R, G and B toward color by at most step (0-255); alpha is kept
+    void fadeToward(uint32_t *px, int count, uint32_t color, int step);
+    // dst = (src * (color + 1)) >> 8 per byte, so a white premultiplied
+    // image comes out tinted with a premultiplied color. src and dst may be
+    // the same buffer.
+    void modulate(const uint32_t *src, uint32_t *dst, int count, uint32_t color);
+
+    // 3x3 box blur. The one-pixel border is copied unchanged; src and dst
+    // must not alias.
+    void blur3x3(const uint32_t *src, uint32_t *dst, int width, int height);
+    // One interior row of blur3x3 from the rows above, at and below it. The
+    // first and last pixel are copied; out must not alias the inputs.
+    void blurRow3x3(const uint32_t *above, const uint32_t *row, const uint32_t *below,
+                    uint32_t *out, int width);
+
+    // One pass of a separable box blur of the given radius with clamped
+    // edges. Strides are in pixels; src and dst must not alias.
+    void boxBlurH(const uint32_t *src, uint32_t *dst, int width, int height,
+                  int srcStride, int dstStride, int radius);
+    void boxBlurV(const uint32_t *src, uint32_t *dst, int width, int height,
+                  int srcStride, int dstStride, int radius);
+
+    // Nearest-neighbour resize of a whole image; dst pixel (x, y) takes src
+    // pixel (x * srcWidth / dstWidth, y * srcHeight / dstHeight). Alpha is
+    // set to 0xFF, so the result is a valid RGB32 image. Widths that are an
+    // exact 1x, 2x or 4x of the source take a SIMD path; repeated rows are
+    // copied rather than sampled again.
+    void scaleNearest(const uint32_t *src, int srcWidth, int srcHeight, int srcStride,
+                      uint32_t *dst, int dstWidth, int dstHeight, int dstStride);
+
+    namespace Scalar {
+        void addSaturate(uint32_t *dst, const uint32_t *src, int count);
+        void maxBlend(uint32_t *dst, const uint32_t *src, int count);
+        void averageBlend(uint32_t *dst, const uint32_t *src, int count);
+        void alphaBlend(uint32_t *dst, const uint32_t *src, int count, int alpha);
+        void fadeToward(uint32_t *px, int count, uint32_t color, int step);
+        void modulate(const uint32_t *src, uint32_t *dst, int count, uint32_t color);
+        void blur3x3(const uint32_t *src, uint32_t *dst, int width, int height);
+        void blurRow3x3(const uint32_t *above, const uint32_t *row, const uint32_t *below,
+                        uint32_t *out, int width);
+        void boxBlurH(const uint32_t *src, uint32_t *dst, int width, int height,
+                      int srcStride, int dstStride, int radius);
+        void boxBlurV(const uint32_t *src, uint32_t *dst, int width, int height,
+                      int srcStride, int dstStride, int radius);
+        void scaleNearest(const uint32_t *src, int srcWidth, int srcHeight, int srcStride,
+                          uint32_t *dst, int dstWidth, int dstHeight, int dstStride);
+    }
+}
+
+#endif // PIXELKERNELS_H
@@ -0,0 +1,130 @@
+#include "qualitygovernor.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+    // Frames ignored after a level change while effects and caches adjust
+    constexpr int SETTLE_FRAMES = 5;
+    // Weight of the newest frame in the running average
+    constexpr double AVERAGE_WEIGHT = 1.0 / 8.0;
+    constexpr double OVER_BUDGET = 0.85;
+    constexpr double UNDER_BUDGET = 0.55;
+
+    const char *const LEVEL_NAMES[] = {"full", "passes", "particles", "fps25", "fps20"};
+}
+
+QualityGovernor::QualityGovernor(int frameIntervalUs, uint32_t levels)
+    : m_baseIntervalUs(frameIntervalUs)
+    , m_levels((levels & ALL_LEVELS) | (1u << Full))
+{
+    changeLevel(Full);
+}
+
+int QualityGovernor::intervalFor(Level level) const
+{
+    switch (level) {
+    case Fps25:
+        return 1000000 / 25;
+    case Fps20:
+        return 1000000 / 20;
+    default:
+        return m_baseIntervalUs;
+    }
+}
+
+QualityGovernor::Level QualityGovernor::nextLevel(Level level, int direction) const
+{
+    for (int l = level + direction; l >= 0 && l < LEVEL_COUNT; l += direction) {
+        if (m_levels & (1u << l))
+            return static_cast<Level>(l);
+    }
+    return level;
+}
+
+void QualityGovernor::changeLevel(Level level)
+{
+    m_level = level;
+    m_settle = SETTLE_FRAMES;
+    m_overFrames = 0;
+    m_underFrames = 0;
+}
+
+bool QualityGovernor::addFrame(int64_t costUs)
+{
+    if (m_forced)
+        return false;
+
+    if (m_sinceStepUp >= 0 && ++m_sinceStepUp > REVERT_WINDOW_FRAMES)
+        m_sinceStepUp = -1;
+
+    if (m_settle > 0) {
+        // Start the average afresh from the first frame at the new level
+        if (--m_settle == 0)
+            m_average = static_cast<double>(costUs);
+        return false;
+    }
+    m_average += (costUs - m_average) * AVERAGE_WEIGHT;
+
+    if (m_average > OVER_BUDGET * intervalFor(m_level)) {
+        m_underFrames = 0;
+        Level worse = nextLevel(m_level, 1);
+        if (++m_overFrames < DOWN_FRAMES || worse == m_level)
+            return false;
+        if (m_sinceStepUp >= 0)
+            m_holdFrames = std::min(m_holdFrames * 2, MAX_HOLD_FRAMES); // the last step up didn't hold
+        m_sinceStepUp = -1;
+        changeLevel(worse);
+        return true;
+    }
+    m_overFrames = 0;
+
+    Level better = nextLevel(m_level, -1);
+    if (better == m_level || m_average >= UNDER_BUDGET * intervalFor(better)) {
+        m_underFrames = 0;
+        return false;
+    }
+    if (++m_underFrames < m_holdFrames)
+        return false;
+    m_sinceStepUp = 0;
+    changeLevel(better);
+    return true;
+}
+
+void QualityGovernor::setForcedLevel(int level)
+{
+    if (level >= 0 && level < LEVEL_COUNT) {
+        m_forced = true;
+        changeLevel(static_cast<Level>(level));
+    } else if (m_forced) {
+        m_forced = false;
+        changeLevel(Full);
+    }
+}
+
+void QualityGovernor::reset()
+{
+    m_holdFrames = HOLD_FRAMES;
+    m_sinceStepUp = -1;
+    changeLevel(m_forced ? m_level : Full);
+}
+
+const char *QualityGovernor::levelName(Level level)
+{
+    return (level >= 0 && level < LEVEL_COUNT) ? LEVEL_NAMES[level] : "";
+}
+
+int QualityGovernor::parseLevel(const char *text)
+{
+    if (std::strcmp(text, "auto") == 0)
+        return AUTO;
+    for (int l = 0; l < LEVEL_COUNT; l++) {
+        if (std::strcmp(text, LEVEL_NAMES[l]) == 0)
+            return l;
+    }
+    char *end = nullptr;
+    long n = std::strtol(text, &end, 10);
+    if (end != text && *end == '\0' && n >= 0 && n < LEVEL_COUNT)
+        return static_cast<int>(n);
+    return INVALID;
+}
@@ -0,0 +1,80 @@
+#ifndef QUALITYGOVERNOR_H
+#define QUALITYGOVERNOR_H
+
+#include <cstdint>
+
+// Steps a visualizer's quality down while its frames run over budget and
+// back up when there is room again, so a heavy preset keeps a steady frame
+// rate and a light one keeps full quality. Fed with the measured render time
+// of every frame.
+//
+// Two thresholds and a hold time keep it from flapping: it steps down when
+// the smoothed cost stays above 85% of the frame interval for a third of a
+// second, and up only when it has stayed below 55% of the better level's
+// interval for the hold time. A step up that has to be taken back within
+// REVERT_WINDOW_FRAMES doubles the hold time, so a preset sitting right on a
+// boundary settles instead of bouncing.
+class QualityGovernor
+{
+public:
+    // Cheapest last; each level keeps the cuts of the ones above it. Both
+    // visualizers render at an internal resolution fixed at build time, so
+    // the ladder starts at effect passes.
+    enum Level {
+        Full,
+        FewerPasses,    // multi-pass blurs run a single pass
+        FewerParticles, // star and particle counts halved
+        Fps25,
+        Fps20,
+        LEVEL_COUNT
+    };
+    static constexpr int AUTO = -1;
+    static constexpr int INVALID = -2;
+    static constexpr uint32_t ALL_LEVELS = (1u << LEVEL_COUNT) - 1;
+
+    // levels is a mask of (1 << Level) the visualizer has a use for; the
+    // governor steps over the others. Full is always included.
+    explicit QualityGovernor(int frameIntervalUs, uint32_t levels = ALL_LEVELS);
+
+    // Measured render time of one frame. Returns true when the level changed.
+    bool addFrame(int64_t costUs);
+
+    Level level() const { return m_level; }
+    // Pins the level, e.g. from a preset; AUTO hands control back
+    void setForcedLevel(int level);
+    bool isForced() const { return m_forced; }
+    // Forgets the measurements and returns to Full, or the forced level
+    void reset();
+
+    // Frame interval at the current level
+    int frameIntervalUs() const { return intervalFor(m_level); }
+    int64_t averageCostUs() const { return static_cast<int64_t>(m_average); }
+
+    static const char *levelName(Level level);
+    // A level name or number; AUTO for "auto", INVALID when unrecognised
+    static int parseLevel(const char *text);
+
+    static constexpr int DOWN_FRAMES = 10;
+    static constexpr int HOLD_FRAMES = 90;
+    static constexpr int MAX_HOLD_FRAMES = 1800;
+    static constexpr int REVERT_WINDOW_FRAMES = 300;
+
+private:
+    int intervalFor(Level level) const;
+    Level nextLevel(Level level, int direction) const;
+    void changeLevel(Level level);
+
+    const int m_baseIntervalUs;
+    const uint32_t m_levels;
+    Level m_level = Full;
+    bool m_forced = false;
+
+    double m_average = 0.0;
+    int m_settle = 0;      // frames left before the average counts again
+    int m_overFrames = 0;
+    int m_underFrames = 0;
+    int m_holdFrames = HOLD_FRAMES;
+    int m_sinceStepUp = -1; // frames since the last step up, -1 once it stuck
+};
+
+#endif // QUALITYGOVERNOR_H
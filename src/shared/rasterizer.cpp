@@ -0,0 +1,67 @@
+#include "rasterizer.h"
+#include <cmath>
+
+namespace {
+    enum OutCode { INSIDE = 0, LEFT = 1, RIGHT = 2, BOTTOM = 4, TOP = 8 };
+
+    int outCode(float x, float y, float xmin, float ymin, float xmax, float ymax)
+    {
+        int code = INSIDE;
+        if (x < xmin)
+            code |= LEFT;
+        else if (x > xmax)
+            code |= RIGHT;
+        if (y < ymin)
+            code |= TOP;
+        else if (y > ymax)
+            code |= BOTTOM;
+        return code;
+    }
+}
+
+bool Rasterizer::clipLine(float &x0, float &y0, float &x1, float &y1,
+                          float xmin, float ymin, float xmax, float ymax)
+{
+    if (!std::isfinite(x0) || !std::isfinite(y0) || !std::isfinite(x1) || !std::isfinite(y1))
+        return false;
+
+    int code0 = outCode(x0, y0, xmin, ymin, xmax, ymax);
+    int code1 = outCode(x1, y1, xmin, ymin, xmax, ymax);
+
+    // Each pass moves one end onto an edge it was outside of, so four
+    // passes cover every case
+    for (int pass = 0; pass < 4 && (code0 | code1); pass++) {
+        if (code0 & code1)
+            return false; // both ends beyond the same edge
+
+        // Interpolate in double: far-off script output can overflow float
+        int code = code0 ? code0 : code1;
+        float x, y;
+        if (code & (TOP | BOTTOM)) {
+            y = (code & TOP) ? ymin : ymax;
+            x = static_cast<float>(x0 + (double(x1) - x0) * ((double(y) - y0) / (double(y1) - y0)));
+        } else {
+            x = (code & LEFT) ? xmin : xmax;
+            y = static_cast<float>(y0 + (double(y1) - y0) * ((double(x) - x0) / (double(x1) - x0)));
+        }
+
+        if (code == code0) {
+            x0 = x;
+            y0 = y;
+            code0 = outCode(x0, y0, xmin, ymin, xmax, ymax);
+        } else {
+            x1 = x;
+            y1 = y;
+            code1 = outCode(x1, y1, xmin, ymin, xmax, ymax);
+        }
+    }
+    if (code0 & code1)
+        return false;
+
+    // Rounding in the intersections can leave an end a hair outside
+    x0 = std::clamp(x0, xmin, xmax);
+    x1 = std::clamp(x1, xmin, xmax);
+    y0 = std::clamp(y0, ymin, ymax);
+    y1 = std::clamp(y1, ymin, ymax);
+    return true;
+}
@@ -0,0 +1,301 @@
+#ifndef RASTERIZER_H
+#define RASTERIZER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include "pixelkernels.h"
+
+// Clipped line, circle and point drawing on packed 32-bit framebuffers,
+// shared by the AVS scopes and the Geiss waveform effects. Shapes are clipped
+// once up front, so the per-pixel loops run without bounds checks.
+//
+// Coordinates are in pixels, with pixel (x, y) covering [x, x+1) x [y, y+1);
+// float positions map to pixels by truncation. How a pixel is written is
+// given by an op: Replace, Max or Add below, or anything with the same two
+// call operators (the coverage one is only needed by lineAA).
+namespace Rasterizer {
+    struct Surface {
+        uint32_t *pixels;
+        int width;
+        int height;
+    };
+
+    struct Point {
+        int x, y;
+    };
+
+    // Per-byte c * coverage / 256, coverage 0-256
+    inline uint32_t scale(uint32_t c, int coverage)
+    {
+        uint32_t rb = (((c & 0x00FF00FF) * coverage) >> 8) & 0x00FF00FF;
+        uint32_t ag = (((c >> 8) & 0x00FF00FF) * coverage) & 0xFF00FF00;
+        return rb | ag;
+    }
+
+    // Per-byte a + (b - a) * coverage / 256, coverage 0-256
+    inline uint32_t lerp(uint32_t a, uint32_t b, int coverage)
+    {
+        return scale(a, 256 - coverage) + scale(b, coverage);
+    }
+
+    struct Replace {
+        uint32_t color;
+        void operator()(uint32_t &p) const { p = color; }
+        void operator()(uint32_t &p, int coverage) const { p = lerp(p, color, coverage); }
+    };
+
+    // Per-byte maximum; never darkens
+    struct Max {
+        uint32_t color;
+        void operator()(uint32_t &p) const { p = PixelKernels::maxPixel(p, color); }
+        void operator()(uint32_t &p, int coverage) const { p = PixelKernels::maxPixel(p, scale(color, coverage)); }
+    };
+
+    // Per-byte saturating add
+    struct Add {
+        uint32_t color;
+        void operator()(uint32_t &p) const { p = PixelKernels::addSaturate(p, color); }
+        void operator()(uint32_t &p, int coverage) const { p = PixelKernels::addSaturate(p, scale(color, coverage)); }
+    };
+
+    // Cohen-Sutherland: trims the segment to [xmin, xmax] x [ymin, ymax].
+    // Returns false when nothing of it is left, or an end is not finite.
+    bool clipLine(float &x0, float &y0, float &x1, float &y1,
+                  float xmin, float ymin, float xmax, float ymax);
+
+    // Bresenham between two pixels already known to be on the surface
+    template <typename Op>
+    void lineUnclipped(const Surface &s, int x0, int y0, int x1, int y1, Op op)
+    {
+        int dx = x1 > x0 ? x1 - x0 : x0 - x1;
+        int dy = y1 > y0 ? y0 - y1 : y1 - y0;
+        int sx = x0 < x1 ? 1 : -1;
+        int sy = (y0 < y1 ? 1 : -1) * s.width;
+        int err = dx + dy;
+        uint32_t *p = s.pixels + y0 * s.width + x0;
+        uint32_t *end = s.pixels + y1 * s.width + x1;
+
+        for (;;) {
+            op(*p);
+            if (p == end)
+                break;
+            int e2 = 2 * err;
+            if (e2 >= dy) {
+                err += dy;
+                p += sx;
+            }
+            if (e2 <= dx) {
+                err += dx;
+                p += sy;
+            }
+        }
+    }
+
+    template <typename Op>
+    void line(const Surface &s, float x0, float y0, float x1, float y1, Op op)
+    {
+        // Up to the last float below the far edge: anything that truncates
+        // onto the surface is left alone
+        if (!clipLine(x0, y0, x1, y1, 0.0f, 0.0f, std::nextafter(float(s.width), 0.0f),
+                      std::nextafter(float(s.height), 0.0f)))
+            return;
+        lineUnclipped(s, static_cast<int>(x0), static_cast<int>(y0),
+                      static_cast<int>(x1), static_cast<int>(y1), op);
+    }
+
+    // A line drawn as a run of thickness pixels across its major axis at
+    // every step. Clipped against the surface grown by the half width, so
+    // only the runs need trimming.
+    template <typename Op>
+    void thickLine(const Surface &s, float x0, float y0, float x1, float y1, int thickness, Op op)
+    {
+        if (thickness <= 1) {
+            line(s, x0, y0, x1, y1, op);
+            return;
+        }
+        const int half = thickness / 2;
+        if (!clipLine(x0, y0, x1, y1, -half, -half, s.width - 1.0f + half, s.height - 1.0f + half))
+            return;
+
+        // Truncation toward zero would merge -0.5 into 0, so floor explicitly
+        auto toPixel = [](float v) { int i = static_cast<int>(v); return i > v ? i - 1 : i; };
+        int ix0 = toPixel(x0), iy0 = toPixel(y0);
+        int ix1 = toPixel(x1), iy1 = toPixel(y1);
+        int dx = ix1 > ix0 ? ix1 - ix0 : ix0 - ix1;
+        int dy = iy1 > iy0 ? iy0 - iy1 : iy1 - iy0;
+        int sx = ix0 < ix1 ? 1 : -1;
+        int sy = iy0 < iy1 ? 1 : -1;
+        int err = dx + dy;
+        const bool xMajor = dx >= -dy;
+
+        for (;;) {
+            if (xMajor) {
+                if (ix0 >= 0 && ix0 < s.width) {
+                    int top = std::max(iy0 - half, 0);
+                    int bottom = std::min(iy0 - half + thickness, s.height);
+                    uint32_t *p = s.pixels + top * s.width + ix0;
+                    for (int y = top; y < bottom; y++, p += s.width)
+                        op(*p);
+                }
+            } else if (iy0 >= 0 && iy0 < s.height) {
+                int left = std::max(ix0 - half, 0);
+                int right = std::min(ix0 - half + thickness, s.width);
+                uint32_t *p = s.pixels + iy0 * s.width;
+                for (int x = left; x < right; x++)
+                    op(p[x]);
+            }
+            if (ix0 == ix1 && iy0 == iy1)
+                break;
+            int e2 = 2 * err;
+            if (e2 >= dy) {
+                err += dy;
+                ix0 += sx;
+            }
+            if (e2 <= dx) {
+                err += dx;
+                iy0 += sy;
+            }
+        }
+    }
+
+    // Wu's antialiased line: two pixels across the major axis per step,
+    // weighted by how close the line passes to each
+    template <typename Op>
+    void lineAA(const Surface &s, float x0, float y0, float x1, float y1, Op op)
+    {
+        // Work in pixel centres
+        x0 -= 0.5f; y0 -= 0.5f;
+        x1 -= 0.5f; y1 -= 0.5f;
+        if (!clipLine(x0, y0, x1, y1, 0.0f, 0.0f, s.width - 1.0f, s.height - 1.0f))
+            return;
+
+        float adx = x1 > x0 ? x1 - x0 : x0 - x1;
+        float ady = y1 > y0 ? y1 - y0 : y0 - y1;
+        const bool xMajor = adx >= ady;
+        if (!xMajor) {
+            std::swap(x0, y0);
+            std::swap(x1, y1);
+        }
+        if (x0 > x1) {
+            std::swap(x0, x1);
+            std::swap(y0, y1);
+        }
+        // Major axis in u, minor in v
+        const int uStart = static_cast<int>(x0 + 0.5f);
+        const int uEnd = static_cast<int>(x1 + 0.5f);
+        const int vLimit = xMajor ? s.height : s.width;
+        const int uStride = xMajor ? 1 : s.width;
+        const int vStride = xMajor ? s.width : 1;
+        const float gradient = x1 > x0 ? (y1 - y0) / (x1 - x0) : 0.0f;
+        float v = y0 + gradient * (uStart - x0);
+
+        for (int u = uStart; u <= uEnd; u++, v += gradient) {
+            // Rounding the ends to whole steps can overshoot by half a step
+            float vc = std::clamp(v, 0.0f, vLimit - 1.0f);
+            int iv = static_cast<int>(vc);
+            int frac = static_cast<int>((vc - iv) * 256.0f);
+            uint32_t *p = s.pixels + u * uStride + iv * vStride;
+            op(*p, 256 - frac);
+            if (frac > 0 && iv + 1 < vLimit)
+                op(p[vStride], frac);
+        }
+    }
+
+    // Batch of single pixels; ones off the surface are skipped
+    template <typename Op>
+    void points(const Surface &s, const Point *pts, int count, Op op)
+    {
+        for (int i = 0; i < count; i++) {
+            if (static_cast<unsigned>(pts[i].x) < static_cast<unsigned>(s.width)
+                && static_cast<unsigned>(pts[i].y) < static_cast<unsigned>(s.height))
+                op(s.pixels[pts[i].y * s.width + pts[i].x]);
+        }
+    }
+
+    // Batch of filled discs of the given radius centred on each point. The
+    // disc's row spans are worked out once for the whole batch; sprites wholly
+    // on the surface are drawn without per-row trimming.
+    template <typename Op>
+    void pointSprites(const Surface &s, const Point *pts, int count, int radius, Op op)
+    {
+        if (radius <= 0) {
+            points(s, pts, count, op);
+            return;
+        }
+        static constexpr int MAX_RADIUS = 15;
+        radius = std::min(radius, MAX_RADIUS);
+        int span[MAX_RADIUS + 1];
+        for (int dy = 0; dy <= radius; dy++) {
+            int dx = radius;
+            while (dx * dx + dy * dy > radius * radius + radius)
+                dx--;
+            span[dy] = dx;
+        }
+
+        for (int i = 0; i < count; i++) {
+            const int cx = pts[i].x, cy = pts[i].y;
+            if (cx + radius < 0 || cx - radius >= s.width || cy + radius < 0 || cy - radius >= s.height)
+                continue;
+            const bool inside = cx - radius >= 0 && cx + radius < s.width
+                             && cy - radius >= 0 && cy + radius < s.height;
+            for (int dy = -radius; dy <= radius; dy++) {
+                int y = cy + dy;
+                int half = span[dy < 0 ? -dy : dy];
+                int left = cx - half, right = cx + half;
+                if (!inside) {
+                    if (y < 0 || y >= s.height)
+                        continue;
+                    left = std::max(left, 0);
+                    right = std::min(right, s.width - 1);
+                }
+                uint32_t *row = s.pixels + y * s.width;
+                for (int x = left; x <= right; x++)
+                    op(row[x]);
+            }
+        }
+    }
+
+    // Midpoint circle outline. Circles wholly on the surface skip the
+    // per-pixel bounds checks.
+    template <typename Op>
+    void circle(const Surface &s, int cx, int cy, int radius, Op op)
+    {
+        if (radius <= 0)
+            return;
+        if (cx + radius < 0 || cx - radius >= s.width || cy + radius < 0 || cy - radius >= s.height)
+            return;
+        const bool inside = cx - radius >= 0 && cx + radius < s.width
+                         && cy - radius >= 0 && cy + radius < s.height;
+
+        auto plot = [&](int x, int y) {
+            if (inside || (static_cast<unsigned>(x) < static_cast<unsigned>(s.width)
+                           && static_cast<unsigned>(y) < static_cast<unsigned>(s.height)))
+                op(s.pixels[y * s.width + x]);
+        };
+
+        int x = radius;
+        int y = 0;
+        int err = 1 - radius;
+        while (x >= y) {
+            plot(cx + x, cy + y);
+            plot(cx - x, cy + y);
+            plot(cx + x, cy - y);
+            plot(cx - x, cy - y);
+            plot(cx + y, cy + x);
+            plot(cx - y, cy + x);
+            plot(cx + y, cy - x);
+            plot(cx - y, cy - x);
+            y++;
+            if (err < 0) {
+                err += 2 * y + 1;
+            } else {
+                x--;
+                err += 2 * (y - x) + 1;
+            }
+        }
+    }
+}
+
+#endif // RASTERIZER_H
@@ -1,6 +1,28 @@
 #include "scale.h"
 
+#include <QDebug>
 #include <QFile>
+#include <QSettings>
+#include <algorithm>
+
+namespace {
+    int currentScale = 0; // not read yet
+}
+
+void setUiScale(int scale)
+{
+    const int clamped = std::clamp(scale, 1, MAX_UI_SCALE);
+    if (clamped != scale)
+        qWarning() << "[scale] UI scale" << scale << "out of range, using" << clamped;
+    currentScale = clamped;
+}
+
+int uiScale()
+{
+    if (currentScale == 0)
+        setUiScale(QSettings().value("ui/scale", MAX_UI_SCALE).toInt());
+    return currentScale;
+}
 
 QString getStylesheet(QString name)
 {
@@ -1,11 +1,22 @@
 #ifndef SCALE_H
 #define SCALE_H
 
-#define UI_SCALE 4
 #define IS_EMBEDDED
 
 #include <QString>
 
+// Screen pixels per skin pixel, 1 to 4: the sizes in .ui files and the skin
+// bitmaps are all at 1x. Taken from the "ui/scale" setting the first time
+// it's asked for, so it must not be read before the application's name is
+// set, e.g. from a static initializer.
+int uiScale();
+// Overrides the setting, e.g. from the command line; only before the first
+// widget is built
+void setUiScale(int scale);
+
+#define UI_SCALE uiScale()
+#define MAX_UI_SCALE 4
+
 QString getStylesheet(QString name);
 
 #endif // SCALE_H
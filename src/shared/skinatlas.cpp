@@ -0,0 +1,137 @@
+#include "skinatlas.h"
+#include "scale.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QPainter>
+#include <QStandardPaths>
+#include <QVector>
+#include <algorithm>
+
+namespace {
+    // The shipped :/assets copies are the skin at this scale (scale-skin.sh)
+    constexpr int ASSETS_SCALE = 4;
+    // Sprites are a few dozen pixels wide at 1x; rows this wide keep the
+    // atlas roughly square
+    constexpr int ATLAS_WIDTH_1X = 256;
+    constexpr int PADDING = 1;
+
+    struct Sprite {
+        QString name;
+        QImage image;
+    };
+}
+
+SkinAtlas &SkinAtlas::instance()
+{
+    // Never deleted: a pixmap must not outlive the application
+    static SkinAtlas *atlas = new SkinAtlas(UI_SCALE);
+    return *atlas;
+}
+
+SkinAtlas::SkinAtlas(int scale)
+    : m_scale(scale)
+{
+    QDir skin(":/skin");
+    QVector<Sprite> sprites;
+    for (const QString &file : skin.entryList({"*.png"}, QDir::Files, QDir::Name)) {
+        QImage image(skin.filePath(file));
+        if (image.isNull()) {
+            qWarning() << "[skin] Could not load" << file;
+            continue;
+        }
+        // FastTransformation samples the nearest pixel, which for a whole
+        // factor repeats each one scale x scale times
+        image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied)
+                    .scaled(image.size() * m_scale, Qt::IgnoreAspectRatio, Qt::FastTransformation);
+        sprites.append({QFileInfo(file).completeBaseName(), image});
+    }
+
+    // Shelf packing, tallest first so each shelf wastes little height
+    std::sort(sprites.begin(), sprites.end(), [](const Sprite &a, const Sprite &b) {
+        return a.image.height() > b.image.height();
+    });
+    int width = ATLAS_WIDTH_1X * m_scale;
+    for (const Sprite &s : sprites)
+        width = std::max(width, s.image.width());
+    int x = 0, y = 0, shelfHeight = 0;
+    for (const Sprite &s : sprites) {
+        if (x + s.image.width() > width) {
+            x = 0;
+            y += shelfHeight + PADDING;
+            shelfHeight = 0;
+        }
+        m_cells.insert(s.name, QRect(QPoint(x, y), s.image.size()));
+        x += s.image.width() + PADDING;
+        shelfHeight = std::max(shelfHeight, s.image.height());
+    }
+
+    m_image = QImage(width, std::max(1, y + shelfHeight), QImage::Format_ARGB32_Premultiplied);
+    m_image.fill(Qt::transparent);
+    QPainter painter(&m_image);
+    painter.setCompositionMode(QPainter::CompositionMode_Source);
+    for (const Sprite &s : sprites)
+        painter.drawImage(m_cells.value(s.name).topLeft(), s.image);
+    painter.end();
+    m_pixmap = QPixmap::fromImage(m_image);
+}
+
+void SkinAtlas::install()
+{
+    QStringList paths;
+    if (UI_SCALE != ASSETS_SCALE) {
+        const QString dir = instance().exportSprites();
+        if (!dir.isEmpty())
+            paths << dir;
+        else
+            qWarning() << "[skin] Using the 4x sprites, scaled while painting";
+    }
+    paths << ":/assets";
+    QDir::setSearchPaths("skin", paths);
+}
+
+QPixmap SkinAtlas::sprite(const QString &name) const
+{
+    const QRect cell = rect(name);
+    if (cell.isEmpty()) {
+        qWarning() << "[skin] No sprite named" << name;
+        return QPixmap();
+    }
+    return m_pixmap.copy(cell);
+}
+
+void SkinAtlas::draw(QPainter &painter, const QPoint &at, const QString &name) const
+{
+    const QRect cell = rect(name);
+    if (!cell.isEmpty())
+        painter.drawPixmap(at, m_pixmap, cell);
+}
+
+QString SkinAtlas::exportSprites() const
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation)
+                        + "/skin/" + QString::number(m_scale) + "x";
+    if (!QDir().mkpath(dir))
+        return QString();
+
+    // The skin is compiled in, so sprites written after the binary was
+    // built are still current
+    const QString stamp = dir + "/.complete";
+    const QFileInfo binary(QCoreApplication::applicationFilePath());
+    const QFileInfo written(stamp);
+    if (written.exists() && written.lastModified() >= binary.lastModified())
+        return dir;
+
+    for (auto it = m_cells.constBegin(); it != m_cells.constEnd(); ++it) {
+        if (!m_image.copy(it.value()).save(dir + "/" + it.key() + ".png"))
+            return QString();
+    }
+    QFile done(stamp);
+    if (!done.open(QFile::WriteOnly) || done.write(QByteArray::number(m_scale)) < 0)
+        return QString();
+    qDebug() << "[skin] Wrote" << m_cells.size() << "sprites to" << dir;
+    return dir;
+}
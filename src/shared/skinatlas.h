@@ -0,0 +1,51 @@
+#ifndef SKINATLAS_H
+#define SKINATLAS_H
+
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QRect>
+#include <QString>
+
+class QPainter;
+
+// The skin's bitmaps (skin/*.png, drawn at 1x) scaled to UI_SCALE once at
+// startup and packed into one pixmap. Scaling is nearest-neighbour by a
+// whole factor, so skin pixels stay square and sharp, and widgets blit
+// their sprite's cell as is instead of having QPainter resample it on
+// every paint.
+//
+// Stylesheets can only name image files, so install() also puts the
+// sprites on the "skin:" search path, e.g. url(skin:play.png). At 4x that
+// is the prescaled copies shipped in :/assets; at other scales the atlas
+// writes its cells to a cache directory, refreshed when the binary is newer
+// than them.
+class SkinAtlas
+{
+public:
+    // Built on first use, at UI_SCALE
+    static SkinAtlas &instance();
+    // Registers the "skin:" search path; call once before building widgets
+    static void install();
+
+    int scale() const { return m_scale; }
+    const QPixmap &pixmap() const { return m_pixmap; }
+    // Cell of a sprite in pixmap(), by file name without .png; empty if
+    // the skin has no such sprite
+    QRect rect(const QString &name) const { return m_cells.value(name); }
+    QPixmap sprite(const QString &name) const;
+    void draw(QPainter &painter, const QPoint &at, const QString &name) const;
+
+private:
+    explicit SkinAtlas(int scale);
+    // Writes every cell as its own PNG; returns the directory, or an empty
+    // string if it couldn't be written
+    QString exportSprites() const;
+
+    int m_scale;
+    QImage m_image;
+    QPixmap m_pixmap;
+    QHash<QString, QRect> m_cells;
+};
+
+#endif // SKINATLAS_H
@@ -1,73 +1,192 @@
 #include "systemaudiocontrol.h"
 #include <QDebug>
+#include <QSettings>
+#include <algorithm>
+#include <poll.h>
+
+const int POLL_INTERVAL_MS = 10000;
 
 SystemAudioControl::SystemAudioControl(QObject *parent)
     : QObject{parent} {
-    init();
-    loadAlsaSettings();
+    QSettings settings;
+    device = settings.value("mixer/device", "default").toString();
+    elementName = settings.value("mixer/element", "Master").toString();
+
+    softwareGain = settings.value("mixer/softwareGain", false).toBool();
+    if(softwareGain) {
+        volume = settings.value("mixer/volume", volume).toInt();
+        balance = settings.value("mixer/balance", balance).toInt();
+        return;
+    }
 
-    // Start periodically polling for updates on volume settings
+    // Fallback for when there are no mixer events to wait for
     pollTimer = new QTimer(this);
-    pollTimer->setInterval(10000);
-    connect(pollTimer, &QTimer::timeout, this, QOverload<>::of(&SystemAudioControl::loadAlsaSettings));
-    pollTimer->start();
+    pollTimer->setInterval(POLL_INTERVAL_MS);
+    connect(pollTimer, &QTimer::timeout, this, &SystemAudioControl::poll);
+
+    init();
+    loadAlsaSettings();
+    if(!watchEvents()) {
+        pollTimer->start();
+    }
 }
 
 SystemAudioControl::~SystemAudioControl() {
-    snd_mixer_close(handle);
+    close();
 }
 
 void SystemAudioControl::init() {
+    const QByteArray deviceName = device.toLocal8Bit();
+    const QByteArray name = elementName.toLocal8Bit();
+
     // Open the mixer
     if (snd_mixer_open(&handle, 0) < 0) {
         qDebug() << "Cannot open mixer";
+        handle = nullptr;
         return;
     }
 
     // Attach the mixer
-    if (snd_mixer_attach(handle, "default") < 0) {
-        qDebug() << "Cannot attach mixer";
-        snd_mixer_close(handle);
+    if (snd_mixer_attach(handle, deviceName.constData()) < 0) {
+        qDebug() << "Cannot attach mixer" << device;
+        close();
         return;
     }
 
+    // Reading events must not block once they run out
+    snd_hctl_t *hctl;
+    if (snd_mixer_get_hctl(handle, deviceName.constData(), &hctl) == 0) {
+        snd_hctl_nonblock(hctl, 1);
+    }
+
     // Register the mixer
     if (snd_mixer_selem_register(handle, NULL, NULL) < 0) {
         qDebug() << "Cannot register mixer";
-        snd_mixer_close(handle);
+        close();
         return;
     }
 
     // Load the mixer
     if (snd_mixer_load(handle) < 0) {
         qDebug() << "Cannot load mixer";
-        snd_mixer_close(handle);
+        close();
         return;
     }
 
     // Set the element ID
+    snd_mixer_selem_id_t *sid;
     snd_mixer_selem_id_alloca(&sid);
     snd_mixer_selem_id_set_index(sid, 0);
-    snd_mixer_selem_id_set_name(sid, "Master");
+    snd_mixer_selem_id_set_name(sid, name.constData());
 
     // Get the mixer element
     elem = snd_mixer_find_selem(handle, sid);
     if (!elem) {
-        qDebug() << "Cannot find mixer element";
-        snd_mixer_close(handle);
+        qDebug() << "Cannot find mixer element" << elementName;
+        close();
         return;
     }
 
+    snd_mixer_elem_set_callback(elem, &SystemAudioControl::elemCallback);
+    snd_mixer_elem_set_callback_private(elem, this);
+
     initSuccess = true;
 }
 
+void SystemAudioControl::close() {
+    // May run from a notifier's own signal
+    for (QSocketNotifier *notifier : notifiers) {
+        notifier->setEnabled(false);
+        notifier->deleteLater();
+    }
+    notifiers.clear();
+
+    if(handle) {
+        snd_mixer_close(handle);
+    }
+    handle = nullptr;
+    elem = nullptr;
+    initSuccess = false;
+}
+
+bool SystemAudioControl::watchEvents() {
+    if(!initSuccess) return false;
+
+    int count = snd_mixer_poll_descriptors_count(handle);
+    if(count <= 0) return false;
+
+    QVector<pollfd> fds(count);
+    count = snd_mixer_poll_descriptors(handle, fds.data(), count);
+    for (int i = 0; i < count; i++) {
+        if(!(fds[i].events & POLLIN)) continue;
+        QSocketNotifier *notifier = new QSocketNotifier(fds[i].fd, QSocketNotifier::Read, this);
+        connect(notifier, &QSocketNotifier::activated, this, &SystemAudioControl::handleEvents);
+        notifiers.append(notifier);
+    }
+
+    if(notifiers.isEmpty()) {
+        qDebug() << "Mixer has nothing to watch, polling instead";
+        return false;
+    }
+    return true;
+}
+
+void SystemAudioControl::handleEvents() {
+    if(!initSuccess) return;
+
+    // Runs elemCallback() for each change to the element
+    int res = snd_mixer_handle_events(handle);
+
+    // The card went away, e.g. a USB DAC was unplugged. Wait for it to
+    // come back the old way.
+    if(res < 0 || !elem) {
+        qDebug() << "Lost mixer" << device << "- polling until it's back";
+        close();
+        pollTimer->start();
+    }
+}
+
+int SystemAudioControl::elemCallback(snd_mixer_elem_t *elem, unsigned int mask) {
+    SystemAudioControl *self = static_cast<SystemAudioControl *>(snd_mixer_elem_get_callback_private(elem));
+
+    // Closing the mixer has to wait until handleEvents() is back
+    if(mask == SND_CTL_EVENT_MASK_REMOVE) {
+        self->elem = nullptr;
+        return 0;
+    }
+
+    if(mask & SND_CTL_EVENT_MASK_VALUE) {
+        self->loadAlsaSettings();
+    }
+    return 0;
+}
+
+void SystemAudioControl::poll() {
+    // Need to re-init in order to get fresh values
+    // Otherwise we get the same values always
+    close();
+    init();
+    loadAlsaSettings();
+
+    if(watchEvents()) {
+        qDebug() << "Watching mixer" << device << "for changes";
+        pollTimer->stop();
+    }
+}
+
 void SystemAudioControl::setVolume(int volume) {
     this->volume = volume;
+    if(softwareGain) {
+        QSettings().setValue("mixer/volume", volume);
+    }
     applyAlsaSettings();
 }
 
 void SystemAudioControl::setBalance(int balance) {
     this->balance = balance;
+    if(softwareGain) {
+        QSettings().setValue("mixer/balance", balance);
+    }
     applyAlsaSettings();
 }
 
@@ -87,54 +206,47 @@ void SystemAudioControl::applyAlsaSettings() {
     // Get the volume range
     snd_mixer_selem_get_playback_volume_range(elem, &min, &max);
 
-    long targetVolume = volume * (max - min) / 100 + min;
+    long targetVolume = volume * (max - min) / 100;
 
     // Calculate the left and right volumes based on the balance
-    long leftVolume = (balance <= 0) ? targetVolume : targetVolume - (balance * targetVolume) / 100;
-    long rightVolume = (balance >= 0) ? targetVolume : targetVolume + (balance * targetVolume) / 100;
+    long leftVolume = min + ((balance <= 0) ? targetVolume : targetVolume - (balance * targetVolume) / 100);
+    long rightVolume = min + ((balance >= 0) ? targetVolume : targetVolume + (balance * targetVolume) / 100);
 
     // Set the left and right volumes
     snd_mixer_selem_set_playback_volume(elem, SND_MIXER_SCHN_FRONT_LEFT, leftVolume);
     snd_mixer_selem_set_playback_volume(elem, SND_MIXER_SCHN_FRONT_RIGHT, rightVolume);
+
+    appliedLeft = leftVolume;
+    appliedRight = rightVolume;
 }
 
 void SystemAudioControl::loadAlsaSettings() {
-
-    // Need to re-init in order to get fresh values
-    // Otherwise we get the same values always
-    if(initSuccess) {
-        snd_mixer_close(handle);
-    }
-    init();
-
     if(!initSuccess) return;
 
     long min, max, leftVolume, rightVolume;
 
-
     // Get the volume range
     snd_mixer_selem_get_playback_volume_range(elem, &min, &max);
+    if(max <= min) return;
 
     // Get the left and right volumes
     snd_mixer_selem_get_playback_volume(elem, SND_MIXER_SCHN_FRONT_LEFT, &leftVolume);
     snd_mixer_selem_get_playback_volume(elem, SND_MIXER_SCHN_FRONT_RIGHT, &rightVolume);
 
-    //qDebug() << "min: " << min << "max: " << max;
-    //qDebug() << "leftVolume: " << leftVolume << "rightVolume: " << rightVolume;
+    if(leftVolume == appliedLeft && rightVolume == appliedRight) return;
+    appliedLeft = -1;
+    appliedRight = -1;
 
-    // Scale to 0-100 scale
-    leftVolume = leftVolume / ((max - min) / 100 + min);
-    rightVolume = rightVolume / ((max - min) / 100 + min);
-
-    //qDebug() << "scaled leftVolume: " << leftVolume << "scaled rightVolume: " << rightVolume;
-
-    // Derive target volume
+    // Derive target volume, scaled to 0-100
     int oldVolume = volume;
-    volume = leftVolume >= rightVolume ? leftVolume : rightVolume;
+    long louder = std::max(leftVolume, rightVolume) - min;
+    volume = qRound(louder * 100.0 / (max - min));
 
-    // Derive balance
+    // Derive balance; at zero volume there is none to derive, so keep it
     int oldBalance = balance;
-    balance = (rightVolume - leftVolume) * (100.0 / volume);
+    if(louder > 0) {
+        balance = qRound((rightVolume - leftVolume) * 100.0 / louder);
+    }
 
     if(oldVolume != volume) {
         emit volumeChanged(volume);
@@ -143,6 +255,4 @@ void SystemAudioControl::loadAlsaSettings() {
     if(oldBalance != balance) {
         emit balanceChanged(balance);
     }
-
-    //qDebug() << "Volume: " << volume << "Balance: " << balance;
 }
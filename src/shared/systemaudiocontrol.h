@@ -2,9 +2,22 @@
 #define SYSTEMAUDIOCONTROL_H
 
 #include <QObject>
+#include <QSocketNotifier>
+#include <QString>
 #include <QTimer>
+#include <QVector>
 #include <alsa/asoundlib.h>
 
+// Volume and balance of one ALSA mixer element, "Master" on the default
+// device unless the mixer/device and mixer/element settings say otherwise.
+// Changes made elsewhere (amixer, hardware knobs, PipeWire) arrive as mixer
+// events on the control device's file descriptors. If the mixer can't be
+// opened or watched, a timer re-opens and re-reads it every 10 s instead,
+// and switches back to events once it can.
+//
+// With mixer/softwareGain set the mixer isn't touched at all: volume and
+// balance are only kept here, and saved, for the coordinator to hand to
+// sources that apply them to their own stream.
 class SystemAudioControl: public QObject {
     Q_OBJECT
 public:
@@ -17,26 +30,43 @@ public:
     int getVolume();
     int getBalance();
 
+    bool isSoftwareGain() const { return softwareGain; }
+
 signals:
     void volumeChanged(int volume);
     void balanceChanged(int balance);
 
 private:
-    snd_mixer_t *handle;
-    snd_mixer_selem_id_t *sid;
-    snd_mixer_elem_t *elem;
+    snd_mixer_t *handle = nullptr;
+    snd_mixer_elem_t *elem = nullptr;
+
+    QString device;
+    QString elementName;
 
+    QVector<QSocketNotifier *> notifiers;
     QTimer *pollTimer = nullptr;
 
     bool initSuccess = false;
+    bool softwareGain = false;
 
     int volume = 100; // 0 to 100
     int balance = 0; // -100 to 100
 
+    // Levels last written by applyAlsaSettings(). Their change event
+    // leaves volume and balance as they are, so rounding in the conversion
+    // can't nudge the sliders while they're dragged.
+    long appliedLeft = -1;
+    long appliedRight = -1;
+
     void init();
+    void close();
+    bool watchEvents();
+    void handleEvents();
+    void poll();
     void applyAlsaSettings();
     void loadAlsaSettings();
 
+    static int elemCallback(snd_mixer_elem_t *elem, unsigned int mask);
 };
 
 #endif // SYSTEMAUDIOCONTROL_H
@@ -0,0 +1,134 @@
+#include "thermalmonitor.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QSettings>
+#include <algorithm>
+
+namespace {
+    // First line of a sysfs attribute as a number, -1 if unreadable
+    long long readNumber(const QString &path)
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly))
+            return -1;
+        bool ok = false;
+        long long value = file.readLine().trimmed().toLongLong(&ok);
+        return ok ? value : -1;
+    }
+
+    const char *stateName(ThermalMonitor::State state)
+    {
+        switch (state) {
+        case ThermalMonitor::Warm: return "warm";
+        case ThermalMonitor::Hot: return "hot";
+        default: return "normal";
+        }
+    }
+}
+
+ThermalMonitor::ThermalMonitor(const QString &sysfsRoot, QObject *parent)
+    : QObject(parent)
+{
+    QSettings settings;
+    m_root = sysfsRoot.isEmpty() ? settings.value("thermal/sysfsRoot", "/sys").toString() : sysfsRoot;
+    m_warm = settings.value("thermal/warmC", 70).toInt() * 1000;
+    m_hot = settings.value("thermal/hotC", 77).toInt() * 1000;
+    m_hysteresis = settings.value("thermal/hysteresisC", 3).toInt() * 1000;
+    m_warmFps = settings.value("thermal/warmFps", 20).toInt();
+    m_hotFps = settings.value("thermal/hotFps", 12).toInt();
+
+    QDir thermal(m_root + "/class/thermal");
+    for (const QString &zone : thermal.entryList({"thermal_zone*"}, QDir::Dirs, QDir::Name))
+        m_zones << thermal.filePath(zone + "/temp");
+
+    // One directory per policy on current kernels, per CPU on older ones
+    QDir cpufreq(m_root + "/devices/system/cpu/cpufreq");
+    for (const QString &policy : cpufreq.entryList({"policy*"}, QDir::Dirs, QDir::Name))
+        m_policies << cpufreq.filePath(policy);
+    if (m_policies.isEmpty()) {
+        QDir cpus(m_root + "/devices/system/cpu");
+        for (const QString &cpu : cpus.entryList({"cpu[0-9]*"}, QDir::Dirs, QDir::Name)) {
+            if (QFile::exists(cpus.filePath(cpu + "/cpufreq")))
+                m_policies << cpus.filePath(cpu + "/cpufreq");
+        }
+    }
+
+    if (m_zones.isEmpty() || readTemperature() < 0) {
+        qDebug() << "[thermal] no thermal zones under" << m_root << "- frame rates stay uncapped";
+        return;
+    }
+
+    m_timer.setInterval(settings.value("thermal/pollMs", 2000).toInt());
+    connect(&m_timer, &QTimer::timeout, this, &ThermalMonitor::poll);
+    m_timer.start();
+    poll();
+}
+
+int ThermalMonitor::frameRateCap() const
+{
+    switch (m_state) {
+    case Warm: return m_warmFps;
+    case Hot: return m_hotFps;
+    default: return 0;
+    }
+}
+
+int ThermalMonitor::readTemperature() const
+{
+    long long hottest = -1;
+    for (const QString &zone : m_zones)
+        hottest = std::max(hottest, readNumber(zone));
+    return static_cast<int>(hottest);
+}
+
+bool ThermalMonitor::readThrottled() const
+{
+    for (const QString &policy : m_policies) {
+        long long limit = readNumber(policy + "/scaling_max_freq");
+        long long hardware = readNumber(policy + "/cpuinfo_max_freq");
+        if (limit > 0 && hardware > 0 && limit < hardware)
+            return true;
+    }
+    return false;
+}
+
+void ThermalMonitor::poll()
+{
+    int temperature = readTemperature();
+    if (temperature < 0)
+        return; // keep the last state through a failed read
+    m_temperature = temperature;
+    m_throttled = readThrottled();
+
+    State target = Normal;
+    if (temperature >= m_hot)
+        target = Hot;
+    else if (temperature >= m_warm)
+        target = Warm;
+
+    // Cooling down only counts once the reading is hysteresisC under the
+    // threshold of the state being left
+    if (target < m_state) {
+        State held = Normal;
+        if (temperature >= m_hot - m_hysteresis)
+            held = Hot;
+        else if (temperature >= m_warm - m_hysteresis)
+            held = Warm;
+        target = std::max(target, std::min(m_state, held));
+    }
+
+    // The kernel capping the clock means it is hotter than the zones admit
+    if (m_throttled && target < Hot)
+        target = static_cast<State>(target + 1);
+
+    if (target == m_state)
+        return;
+
+    int oldCap = frameRateCap();
+    m_state = target;
+    qDebug() << "[thermal]" << stateName(m_state) << "at" << temperature / 1000.0 << "C"
+             << (m_throttled ? "(cpufreq capped)" : "") << "- frame cap" << frameRateCap();
+    if (frameRateCap() != oldCap)
+        emit frameRateCapChanged(frameRateCap());
+}
@@ -0,0 +1,72 @@
+#ifndef THERMALMONITOR_H
+#define THERMALMONITOR_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+// Watches SoC temperature and CPU frequency through sysfs and caps the frame
+// rate of the visualizers and the screensaver before the kernel starts
+// throttling. A fanless Pi left on Geiss heats up over 20 minutes or so;
+// once the firmware clocks the CPU down, audio underruns, so it's better to
+// give up frames early.
+//
+// The hottest of <root>/class/thermal/thermal_zone*/temp decides the state:
+// Warm from warmC, Hot from hotC, each left again hysteresisC below its
+// threshold. A cpufreq policy whose scaling_max_freq sits under
+// cpuinfo_max_freq means the kernel is throttling already, which counts as
+// one state hotter. All of it comes from QSettings "thermal/...":
+//
+//   sysfsRoot   "/sys"   point at a fake tree to try it on any machine
+//   pollMs      2000
+//   warmC       70       warmFps 20
+//   hotC        77       hotFps  12
+//   hysteresisC 3
+//
+// Without any readable thermal zone the monitor stays Normal and idle.
+class ThermalMonitor : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum State { Normal, Warm, Hot };
+
+    // An empty root takes thermal/sysfsRoot
+    explicit ThermalMonitor(const QString &sysfsRoot = QString(), QObject *parent = nullptr);
+
+    State state() const { return m_state; }
+    // Frame rate ceiling for the current state, 0 for none
+    int frameRateCap() const;
+    // Last reading in millidegrees Celsius, -1 if none
+    int temperature() const { return m_temperature; }
+    bool throttled() const { return m_throttled; }
+
+public slots:
+    // Reads sysfs and updates the state; runs on the poll timer
+    void poll();
+
+signals:
+    void frameRateCapChanged(int fps);
+
+private:
+    int readTemperature() const;
+    bool readThrottled() const;
+
+    QString m_root;
+    QStringList m_zones;    // temp files
+    QStringList m_policies; // cpufreq policy directories
+    QTimer m_timer;
+
+    int m_warm;
+    int m_hot;
+    int m_hysteresis;
+    int m_warmFps;
+    int m_hotFps;
+
+    State m_state = Normal;
+    int m_temperature = -1;
+    bool m_throttled = false;
+};
+
+#endif // THERMALMONITOR_H
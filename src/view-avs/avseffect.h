@@ -2,8 +2,12 @@
 #define AVSEFFECT_H
 
 #include <QString>
+#include <QStringList>
+#include <cstddef>
+#include <cstdint>
 
 class AvsFramebuffer;
+class AvsFramebufferPool;
 class AvsAudioData;
 
 class AvsEffect
@@ -12,7 +16,49 @@ public:
     virtual ~AvsEffect() = default;
     virtual void render(AvsFramebuffer &fb, const AvsAudioData &audio) = 0;
     virtual QString name() const = 0;
+
+    // Read/write declaration used to alias buffers and skip copies. False
+    // means the effect overwrites every pixel without looking at the incoming
+    // frame, so an effect list can skip copying the parent frame in.
+    virtual bool readsFrame() const { return true; }
+    // Named pool targets the effect uses, allocated when the preset loads
+    virtual QStringList renderTargets() const { return {}; }
+    // Private tables and state, excluding pool buffers
+    virtual size_t memoryUsage() const { return 0; }
+
+    virtual void setPool(AvsFramebufferPool *p) { pool = p; }
+    // QualityGovernor::Level the engine is running at. Effects with a
+    // cheaper mode switch to it at the level named after them.
+    virtual void setQualityLevel(int level) { qualityLevel = level; }
+
+    // Fusion: effects that only look at each pixel (Pointwise) or its 3x3
+    // neighbourhood (Stencil3x3) can be run band by band by the engine, so a
+    // run of them makes one pass over memory instead of one each. They
+    // implement beginFrame() for per-frame state and renderRows(), which
+    // works in place on rows [y0, y1). A stencil also gets the row above y0
+    // as it was before this effect ran (nullptr when y0 is 0); rows from y1
+    // on are untouched by it. render() must equal beginFrame() followed by
+    // renderRows() over the whole frame.
+    enum class Access { Frame, Pointwise, Stencil3x3 };
+    virtual Access access() const { return Access::Frame; }
+    virtual void beginFrame(AvsFramebuffer &, const AvsAudioData &) {}
+    virtual void renderRows(uint32_t *, int /*width*/, int /*height*/, int /*y0*/, int /*y1*/,
+                            const uint32_t * /*above*/) {}
+
+    // Tiling: a tile-safe effect's frame splits into row bands that the
+    // engine renders on several threads at once, after one beginFrame() on
+    // the render thread. Pointwise effects are tiled through renderRows();
+    // the others implement renderTile(), which may read any row of src and
+    // writes only rows [y0, y1) of dst (the pool scratch buffer, swapped in
+    // afterwards). Effects whose state runs from one pixel to the next, such
+    // as SuperScope, Starfield or Grain, stay whole-frame and run alone.
+    virtual bool tileSafe() const { return false; }
+    virtual void renderTile(const uint32_t * /*src*/, uint32_t * /*dst*/, int /*width*/,
+                            int /*height*/, int /*y0*/, int /*y1*/) {}
+
     bool enabled = true;
+    AvsFramebufferPool *pool = nullptr; // set by AvsEngine::addEffect
+    int qualityLevel = 0;               // set by AvsEngine::addEffect
 };
 
 #endif // AVSEFFECT_H
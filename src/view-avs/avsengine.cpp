@@ -15,9 +15,14 @@
 #include "avsmosaic.h"
 #include "avsbufferblend.h"
 #include "avsclock.h"
+#include "avseffectlist.h"
+#include "avspresetloader.h"
+#include "pixelkernels.h"
+#include <QDebug>
 
 AvsEngine::AvsEngine()
     : m_frontBuffer(AVS_FB_WIDTH, AVS_FB_HEIGHT)
+    , m_pool(AVS_FB_WIDTH, AVS_FB_HEIGHT)
     , m_transitionBuffer(AVS_FB_WIDTH, AVS_FB_HEIGHT)
 {
     initPresets();
@@ -26,9 +31,18 @@ AvsEngine::AvsEngine()
 
 void AvsEngine::addEffect(std::unique_ptr<AvsEffect> effect)
 {
+    effect->setPool(&m_pool);
+    effect->setQualityLevel(m_qualityLevel);
     m_effects.push_back(std::move(effect));
 }
 
+void AvsEngine::setQualityLevel(int level)
+{
+    m_qualityLevel = level;
+    for (auto &effect : m_effects)
+        effect->setQualityLevel(level);
+}
+
 void AvsEngine::clearEffects()
 {
     m_effects.clear();
@@ -36,33 +50,59 @@ void AvsEngine::clearEffects()
 
 const QImage &AvsEngine::renderFrame(const AvsAudioData &audioData)
 {
-    for (auto &effect : m_effects) {
-        if (effect->enabled) {
+    m_fusedRuns = 0;
+    m_fusedEffects = 0;
+    m_tiledEffects = 0;
+    bool tiled = m_tiles.threadCount() > 1;
+
+    for (size_t i = 0; i < m_effects.size(); i++) {
+        AvsEffect *effect = m_effects[i].get();
+        if (!effect->enabled)
+            continue;
+
+        // Gather the run of fusable effects starting here; disabled ones in
+        // between don't break it
+        m_fusedRun.clear();
+        size_t end = i;
+        for (; m_fusion && end < m_effects.size(); end++) {
+            AvsEffect *e = m_effects[end].get();
+            if (!e->enabled)
+                continue;
+            if (e->access() == AvsEffect::Access::Frame)
+                break;
+            // Across threads only pointwise effects fuse; a stencil needs
+            // rows of the neighbouring bands, which other threads are changing
+            if (tiled && (e->access() != AvsEffect::Access::Pointwise || !e->tileSafe()))
+                break;
+            m_fusedRun.push_back(e);
+        }
+
+        if (m_fusedRun.size() >= 2) {
+            int count = static_cast<int>(m_fusedRun.size());
+            if (tiled)
+                renderTiled(m_fusedRun.data(), count, audioData);
+            else
+                renderFused(m_fusedRun.data(), count, audioData);
+            i = end - 1;
+        } else if (tiled && effect->tileSafe()) {
+            renderTiled(effect, audioData);
+        } else {
             effect->render(m_frontBuffer, audioData);
         }
     }
 
     m_hasRenderedFrame = true;
+    m_pool.endFrame();
 
     // Crossfade: blend old snapshot (fading out) with new frame
     if (m_transitioning && m_transitionFramesRemaining > 0) {
-        float oldAlpha = static_cast<float>(m_transitionFramesRemaining) / TRANSITION_DURATION;
-        float newAlpha = 1.0f - oldAlpha;
-
-        const uint32_t *oldPx = m_transitionBuffer.pixels();
-        uint32_t *newPx = m_frontBuffer.pixels();
-        int count = m_frontBuffer.pixelCount();
-
-        for (int i = 0; i < count; ++i) {
-            uint32_t o = oldPx[i];
-            uint32_t n = newPx[i];
-
-            int r = static_cast<int>(((o >> 16) & 0xFF) * oldAlpha + ((n >> 16) & 0xFF) * newAlpha);
-            int g = static_cast<int>(((o >> 8) & 0xFF) * oldAlpha + ((n >> 8) & 0xFF) * newAlpha);
-            int b = static_cast<int>((o & 0xFF) * oldAlpha + (n & 0xFF) * newAlpha);
-
-            newPx[i] = 0xFF000000 | (r << 16) | (g << 8) | b;
-        }
+        int oldAlpha = m_transitionFramesRemaining * 256 / TRANSITION_DURATION;
+        int w = m_frontBuffer.width();
+        m_tiles.run(m_frontBuffer.height(), BAND_ROWS, [&](int y0, int y1) {
+            PixelKernels::alphaBlend(m_frontBuffer.pixels() + y0 * w,
+                                     m_transitionBuffer.pixels() + y0 * w,
+                                     (y1 - y0) * w, oldAlpha);
+        });
 
         --m_transitionFramesRemaining;
         if (m_transitionFramesRemaining <= 0)
@@ -73,6 +113,109 @@ const QImage &AvsEngine::renderFrame(const AvsAudioData &audioData)
     return m_frameImage;
 }
 
+// Renders a run of per-pixel effects band by band. The run is split into
+// stages at each stencil; stage s works BAND_ROWS rows behind stage
+// s - 1, so when a stencil reaches a band the band below has already been
+// through everything before it. The row above a band has already been
+// overwritten by then, so each stencil stage keeps a copy of it.
+void AvsEngine::renderFused(AvsEffect *const *run, int count, const AvsAudioData &audio)
+{
+    int w = m_frontBuffer.width();
+    int h = m_frontBuffer.height();
+    uint32_t *px = m_frontBuffer.pixels();
+
+    for (int k = 0; k < count; k++)
+        run[k]->beginFrame(m_frontBuffer, audio);
+
+    // Stage boundaries: stage s covers run[starts[s]] .. run[starts[s + 1] - 1]
+    std::vector<int> &starts = m_fusedStages;
+    starts.assign(1, 0);
+    for (int k = 1; k < count; k++) {
+        if (run[k]->access() == AvsEffect::Access::Stencil3x3)
+            starts.push_back(k);
+    }
+    int stages = static_cast<int>(starts.size());
+    starts.push_back(count);
+
+    m_fusedRows.resize(static_cast<size_t>(stages) * 2 * w);
+
+    int bands = (h + BAND_ROWS - 1) / BAND_ROWS;
+    for (int t = 0; t < bands + stages - 1; t++) {
+        for (int s = 0; s < stages; s++) {
+            int band = t - s;
+            if (band < 0 || band >= bands)
+                continue;
+            int y0 = band * BAND_ROWS;
+            int y1 = std::min(h, y0 + BAND_ROWS);
+
+            for (int k = starts[s]; k < starts[s + 1]; k++) {
+                AvsEffect *e = run[k];
+                if (e->access() != AvsEffect::Access::Stencil3x3) {
+                    e->renderRows(px, w, h, y0, y1, nullptr);
+                    continue;
+                }
+
+                // Save this band's last row before the stencil changes it;
+                // it is the next band's row above
+                uint32_t *saved = &m_fusedRows[static_cast<size_t>(s) * 2 * w];
+                uint32_t *above = saved + (band % 2) * w;
+                uint32_t *next = saved + ((band + 1) % 2) * w;
+                std::copy(px + (y1 - 1) * w, px + y1 * w, next);
+                e->renderRows(px, w, h, y0, y1, y0 > 0 ? above : nullptr);
+            }
+        }
+    }
+
+    m_fusedRuns++;
+    m_fusedEffects += count;
+}
+
+// Tiled form of a fused run: every effect in it is pointwise, so each band
+// goes through the whole run on whichever thread picks it up
+void AvsEngine::renderTiled(AvsEffect *const *run, int count, const AvsAudioData &audio)
+{
+    int w = m_frontBuffer.width();
+    int h = m_frontBuffer.height();
+    uint32_t *px = m_frontBuffer.pixels();
+
+    for (int k = 0; k < count; k++)
+        run[k]->beginFrame(m_frontBuffer, audio);
+
+    m_tiles.run(h, BAND_ROWS, [&](int y0, int y1) {
+        for (int k = 0; k < count; k++)
+            run[k]->renderRows(px, w, h, y0, y1, nullptr);
+    });
+
+    m_fusedRuns++;
+    m_fusedEffects += count;
+    m_tiledEffects += count;
+}
+
+void AvsEngine::renderTiled(AvsEffect *effect, const AvsAudioData &audio)
+{
+    int w = m_frontBuffer.width();
+    int h = m_frontBuffer.height();
+
+    effect->beginFrame(m_frontBuffer, audio);
+
+    if (effect->access() == AvsEffect::Access::Pointwise) {
+        uint32_t *px = m_frontBuffer.pixels();
+        m_tiles.run(h, BAND_ROWS, [&](int y0, int y1) {
+            effect->renderRows(px, w, h, y0, y1, nullptr);
+        });
+    } else {
+        AvsFramebuffer &out = m_pool.scratch();
+        const uint32_t *src = m_frontBuffer.pixels();
+        uint32_t *dst = out.pixels();
+        m_tiles.run(h, BAND_ROWS, [&](int y0, int y1) {
+            effect->renderTile(src, dst, w, h, y0, y1);
+        });
+        m_frontBuffer.swap(out);
+    }
+
+    m_tiledEffects++;
+}
+
 void AvsEngine::loadPreset(int index)
 {
     if (index < 0 || index >= static_cast<int>(m_presets.size()))
@@ -86,9 +229,17 @@ void AvsEngine::loadPreset(int index)
     }
 
     m_presetIndex = index;
+    m_presetQuality = QualityGovernor::AUTO;
     clearEffects();
+    m_pool.releaseTargets();
     m_frontBuffer.clear();
     m_presets[index].builder(*this);
+
+    // Allocate declared targets now rather than on the first frame
+    for (const auto &effect : m_effects) {
+        for (const QString &target : effect->renderTargets())
+            m_pool.target(target);
+    }
 }
 
 void AvsEngine::nextPreset()
@@ -121,6 +272,22 @@ QString AvsEngine::presetName() const
     return QString();
 }
 
+AvsEngine::Stats AvsEngine::stats() const
+{
+    Stats s;
+    int frameBytes = m_frontBuffer.pixelCount() * static_cast<int>(sizeof(uint32_t));
+    s.buffers = 2 + m_pool.bufferCount(); // front + transition snapshot
+    s.bufferBytes = 2 * static_cast<size_t>(frameBytes) + m_pool.bytesAllocated();
+    for (const auto &effect : m_effects)
+        s.effectBytes += effect->memoryUsage();
+    s.copiesPerFrame = m_pool.copiesLastFrame();
+    s.fusedRuns = m_fusedRuns;
+    s.fusedEffects = m_fusedEffects;
+    s.threads = m_tiles.threadCount();
+    s.tiledEffects = m_tiledEffects;
+    return s;
+}
+
 void AvsEngine::initPresets()
 {
     // 0: Classic Scope — the original Phase 1 preset
@@ -204,7 +371,7 @@ void AvsEngine::initPresets()
         scope->drawMode = AvsSuperScope::Lines;
         scope->color = 0xFFFF4444; // red
         e.addEffect(std::move(scope));
-        e.addEffect(std::make_unique<AvsMovement>(AvsMovement::SwirlOut));
+        e.addEffect(std::make_unique<AvsMovement>(AvsMovement::SwirlOut, false)); // grain hides the blockiness
     }});
 
     // 8: Beat Pulse
@@ -284,7 +451,7 @@ void AvsEngine::initPresets()
         scope->color = 0xFFFFFFFF; // white
         e.addEffect(std::move(scope));
         e.addEffect(std::make_unique<AvsGrain>(12, true));
-        e.addEffect(std::make_unique<AvsMovement>(AvsMovement::Tunnel));
+        e.addEffect(std::make_unique<AvsMovement>(AvsMovement::Tunnel, false));
     }});
 
     // 15: Clockwork — old digits trail into a zoom tunnel, current time stays crisp
@@ -294,4 +461,63 @@ void AvsEngine::initPresets()
         e.addEffect(std::make_unique<AvsStarfield>(60, 0.012f));
         e.addEffect(std::make_unique<AvsClock>(0xFF00FFFF, 3, true)); // cyan, scale 3, blinking colon
     }});
+
+    // 16: Afterglow — trails live in their own effect list buffer and are added
+    // under a crisp scope that is redrawn from black every frame
+    m_presets.push_back({"Afterglow", [](AvsEngine &e) {
+        e.addEffect(std::make_unique<AvsClearScreen>(0xFF000000));
+        auto trails = std::make_unique<AvsEffectList>("trails", AvsEffectList::Ignore, AvsEffectList::Additive);
+        trails->addEffect(std::make_unique<AvsFadeOut>(3));
+        auto ring = std::make_unique<AvsSuperScope>();
+        ring->shapePreset = AvsSuperScope::Circle;
+        ring->drawMode = AvsSuperScope::Lines;
+        ring->color = 0xFF8040FF; // violet
+        trails->addEffect(std::move(ring));
+        trails->addEffect(std::make_unique<AvsBlur>(1));
+        trails->addEffect(std::make_unique<AvsMovement>(AvsMovement::Tunnel));
+        e.addEffect(std::move(trails));
+        auto scope = std::make_unique<AvsSuperScope>();
+        scope->shapePreset = AvsSuperScope::Oscilloscope;
+        scope->drawMode = AvsSuperScope::Lines;
+        scope->color = 0xFFFFFFFF; // white
+        e.addEffect(std::move(scope));
+    }});
+
+    // 17: Lissajous — scripted scope swept through a scripted polar swirl
+    m_presets.push_back({"Lissajous", [](AvsEngine &e) {
+        e.addEffect(std::make_unique<AvsFadeOut>(5));
+        auto move = std::make_unique<AvsDynamicMovement>();
+        move->setCode("", "t = t + 0.02", "",
+                      "d = d * (0.97 + 0.01 * sin(t)); r = r + 0.015 * cos(d * 6 - t)");
+        e.addEffect(std::move(move));
+        auto scope = std::make_unique<AvsSuperScope>();
+        scope->setCode("n = 320",
+                       "t = t - 0.03; p = p + if(b, 0.5, 0.005)",
+                       "",
+                       "a = i * $pi * 2; x = sin(a * 3 + t) * (0.6 + v * 0.3); y = cos(a * 2 + p) * 0.8;"
+                       "red = 0.5 + 0.5 * sin(a + t); green = 0.4; blue = 1 - red");
+        e.addEffect(std::move(scope));
+    }});
+
+    // User presets from the preset directory. The file is read again each
+    // time the preset loads, so edits show up without a restart.
+    for (const QString &path : AvsPresetLoader::presetFiles()) {
+        AvsPresetLoader::Preset preset;
+        QString error;
+        if (!AvsPresetLoader::load(path, preset, &error)) {
+            qWarning() << "[avs] skipping preset" << path << error;
+            continue;
+        }
+        m_presets.push_back({preset.name, [path](AvsEngine &e) {
+            AvsPresetLoader::Preset preset;
+            QString error;
+            if (!AvsPresetLoader::load(path, preset, &error)) {
+                qWarning() << "[avs] failed to reload preset" << path << error;
+                return;
+            }
+            e.setPresetQuality(preset.quality);
+            for (auto &effect : AvsPresetLoader::createEffects(preset))
+                e.addEffect(std::move(effect));
+        }});
+    }
 }
@@ -2,8 +2,11 @@
 #define AVSENGINE_H
 
 #include "avsframebuffer.h"
+#include "avsframebufferpool.h"
 #include "avseffect.h"
 #include "avsaudiodata.h"
+#include "avstilescheduler.h"
+#include "qualitygovernor.h"
 #include <QImage>
 #include <QString>
 #include <memory>
@@ -26,11 +29,64 @@ public:
     int presetCount() const;
     QString presetName() const;
 
+    // Buffer usage of the active preset
+    struct Stats {
+        int buffers = 0;         // full-size framebuffers, engine + pool
+        size_t bufferBytes = 0;
+        size_t effectBytes = 0;  // effect-private tables and state
+        int copiesPerFrame = 0;  // full-frame copies in the last frame
+        int fusedRuns = 0;       // fused per-pixel passes in the last frame
+        int fusedEffects = 0;    // effects rendered inside those passes
+        int threads = 1;         // render threads, including the caller
+        int tiledEffects = 0;    // effects split across them in the last frame
+    };
+    Stats stats() const;
+
+    // Consecutive Pointwise/Stencil3x3 effects render as one banded pass.
+    // Off renders them one at a time; the output is identical
+    // (tests/avsfusioncheck.cpp).
+    void setFusionEnabled(bool enabled) { m_fusion = enabled; }
+    bool fusionEnabled() const { return m_fusion; }
+
+    // Tile-safe effects are split into row bands across this many threads;
+    // the rest run whole-frame in between as barriers. 0 picks the core
+    // count, capped at AvsTileScheduler::MAX_THREADS; 1 (the default)
+    // renders everything on the calling thread.
+    void setRenderThreads(int threads) { m_tiles.setThreadCount(threads); }
+    int renderThreads() const { return m_tiles.threadCount(); }
+
+    // QualityGovernor::Level passed on to every effect, kept across presets
+    void setQualityLevel(int level);
+    int qualityLevel() const { return m_qualityLevel; }
+    // Level the active preset pins itself to, QualityGovernor::AUTO if none.
+    // Preset builders set it after clearEffects().
+    void setPresetQuality(int level) { m_presetQuality = level; }
+    int presetQuality() const { return m_presetQuality; }
+
 private:
     AvsFramebuffer m_frontBuffer;
+    AvsFramebufferPool m_pool;
     QImage m_frameImage;
     std::vector<std::unique_ptr<AvsEffect>> m_effects;
 
+    void renderFused(AvsEffect *const *run, int count, const AvsAudioData &audio);
+    void renderTiled(AvsEffect *const *run, int count, const AvsAudioData &audio);
+    void renderTiled(AvsEffect *effect, const AvsAudioData &audio);
+    bool m_fusion = true;
+    // 8 rows of 320 px is 10 KiB, so a band stays in L1 across a fused run,
+    // and a 100-row frame makes 13 bands to balance across the threads
+    static constexpr int BAND_ROWS = 8;
+    AvsTileScheduler m_tiles{1};
+    int m_tiledEffects = 0;
+    std::vector<AvsEffect *> m_fusedRun;
+    std::vector<int> m_fusedStages;
+    std::vector<uint32_t> m_fusedRows; // per stencil: saved row above the band, next one
+    int m_fusedRuns = 0;
+    int m_fusedEffects = 0;
+
+    int m_qualityLevel = 0;
+    int m_presetQuality = QualityGovernor::AUTO;
+
     int m_presetIndex = 0;
     struct PresetDef {
         QString name;
@@ -1,4 +1,5 @@
 #include "avsframebuffer.h"
+#include <algorithm>
 #include <cstring>
 
 AvsFramebuffer::AvsFramebuffer(int width, int height)
@@ -43,9 +44,16 @@ void AvsFramebuffer::copyFrom(const AvsFramebuffer &other)
     }
 }
 
+void AvsFramebuffer::swap(AvsFramebuffer &other)
+{
+    std::swap(m_width, other.m_width);
+    std::swap(m_height, other.m_height);
+    m_pixels.swap(other.m_pixels);
+}
+
 QImage AvsFramebuffer::toImage() const
 {
     return QImage(reinterpret_cast<const uchar *>(m_pixels.data()),
                   m_width, m_height, m_width * sizeof(uint32_t),
-                  QImage::Format_ARGB32);
+                  QImage::Format_RGB32); // alpha is always 0xFF
 }
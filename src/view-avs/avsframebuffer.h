@@ -21,6 +21,7 @@ public:
 
     void clear(uint32_t color = 0xFF000000);
     void copyFrom(const AvsFramebuffer &other);
+    void swap(AvsFramebuffer &other);
     QImage toImage() const;
 
 private:
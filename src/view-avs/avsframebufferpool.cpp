@@ -0,0 +1,51 @@
+#include "avsframebufferpool.h"
+
+AvsFramebufferPool::AvsFramebufferPool(int width, int height)
+    : m_width(width), m_height(height), m_scratch(width, height)
+{
+}
+
+AvsFramebuffer &AvsFramebufferPool::scratch()
+{
+    return m_scratch;
+}
+
+AvsFramebuffer &AvsFramebufferPool::target(const QString &name)
+{
+    auto &slot = m_targets[name];
+    if (!slot)
+        slot = std::make_unique<AvsFramebuffer>(m_width, m_height);
+    return *slot;
+}
+
+void AvsFramebufferPool::releaseTargets()
+{
+    m_targets.clear();
+}
+
+void AvsFramebufferPool::copy(AvsFramebuffer &dst, const AvsFramebuffer &src)
+{
+    dst.copyFrom(src);
+    ++m_copies;
+}
+
+void AvsFramebufferPool::endFrame()
+{
+    m_copiesLastFrame = m_copies;
+    m_copies = 0;
+}
+
+int AvsFramebufferPool::bufferCount() const
+{
+    return 1 + static_cast<int>(m_targets.size());
+}
+
+size_t AvsFramebufferPool::bytesAllocated() const
+{
+    return static_cast<size_t>(bufferCount()) * m_width * m_height * sizeof(uint32_t);
+}
+
+int AvsFramebufferPool::copiesLastFrame() const
+{
+    return m_copiesLastFrame;
+}
@@ -0,0 +1,44 @@
+#ifndef AVSFRAMEBUFFERPOOL_H
+#define AVSFRAMEBUFFERPOOL_H
+
+#include "avsframebuffer.h"
+#include <QString>
+#include <cstddef>
+#include <map>
+#include <memory>
+
+// Buffers shared by every effect in the active preset. Effects that cannot
+// work in place write into scratch() and then swap it with the frame, so no
+// effect needs its own copy of the framebuffer. Longer-lived buffers (effect
+// list sub-frames, echo accumulators) are named render targets that persist
+// across frames until the preset changes.
+class AvsFramebufferPool
+{
+public:
+    AvsFramebufferPool(int width, int height);
+
+    // Contents are undefined on entry
+    AvsFramebuffer &scratch();
+
+    // Created black on first use, kept until releaseTargets()
+    AvsFramebuffer &target(const QString &name);
+    void releaseTargets();
+
+    // Full-frame copies go through here so they show up in the stats
+    void copy(AvsFramebuffer &dst, const AvsFramebuffer &src);
+
+    void endFrame();
+    int bufferCount() const;        // scratch + named targets
+    size_t bytesAllocated() const;
+    int copiesLastFrame() const;
+
+private:
+    int m_width;
+    int m_height;
+    AvsFramebuffer m_scratch;
+    std::map<QString, std::unique_ptr<AvsFramebuffer>> m_targets;
+    int m_copies = 0;
+    int m_copiesLastFrame = 0;
+};
+
+#endif // AVSFRAMEBUFFERPOOL_H
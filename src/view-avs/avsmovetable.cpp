@@ -0,0 +1,134 @@
+#include "avsmovetable.h"
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+AvsMoveEntry AvsMoveTable::entryFor(float srcX, float srcY, int width, int height)
+{
+    AvsMoveEntry e;
+
+    // Negated so NaN also lands outside
+    if (!(srcX >= 0.0f && srcY >= 0.0f && srcX <= width - 1 && srcY <= height - 1)) {
+        e.srcIndex = -1;
+        e.fracX = 0;
+        e.fracY = 0;
+        return e;
+    }
+
+    // Keep the 2x2 neighbourhood inside the frame: the last row/column is
+    // reached with a full fraction from its neighbour instead
+    int ix = std::min(static_cast<int>(srcX), width - 2);
+    int iy = std::min(static_cast<int>(srcY), height - 2);
+
+    e.srcIndex = iy * width + ix;
+    e.fracX = static_cast<uint8_t>(std::min(255, static_cast<int>((srcX - ix) * 256.0f)));
+    e.fracY = static_cast<uint8_t>(std::min(255, static_cast<int>((srcY - iy) * 256.0f)));
+    return e;
+}
+
+AvsMoveEntry AvsMoveTable::entryForFixed(int32_t srcX, int32_t srcY, int width, int height)
+{
+    AvsMoveEntry e;
+
+    if (srcX < 0 || srcY < 0 || srcX > ((width - 1) << 16) || srcY > ((height - 1) << 16)) {
+        e.srcIndex = -1;
+        e.fracX = 0;
+        e.fracY = 0;
+        return e;
+    }
+
+    int ix = std::min(srcX >> 16, width - 2);
+    int iy = std::min(srcY >> 16, height - 2);
+
+    e.srcIndex = iy * width + ix;
+    e.fracX = static_cast<uint8_t>(std::min(255, (srcX - (ix << 16)) >> 8));
+    e.fracY = static_cast<uint8_t>(std::min(255, (srcY - (iy << 16)) >> 8));
+    return e;
+}
+
+// Vertical then horizontal lerp with 8-bit weights out of 256. The SIMD
+// versions below use the same order and truncation so all paths are bit-exact.
+static inline uint32_t bilerpScalar(const uint32_t *p, int width, uint32_t fx, uint32_t fy)
+{
+    uint32_t ifx = 256 - fx;
+    uint32_t ify = 256 - fy;
+
+    uint32_t p00 = p[0], p01 = p[1];
+    uint32_t p10 = p[width], p11 = p[width + 1];
+
+    // Two channels per multiply: 0x00RR00BB and 0x00AA00GG
+    uint32_t lRB = (((p00 & 0x00FF00FF) * ify + (p10 & 0x00FF00FF) * fy) >> 8) & 0x00FF00FF;
+    uint32_t lAG = ((((p00 >> 8) & 0x00FF00FF) * ify + ((p10 >> 8) & 0x00FF00FF) * fy) >> 8) & 0x00FF00FF;
+    uint32_t rRB = (((p01 & 0x00FF00FF) * ify + (p11 & 0x00FF00FF) * fy) >> 8) & 0x00FF00FF;
+    uint32_t rAG = ((((p01 >> 8) & 0x00FF00FF) * ify + ((p11 >> 8) & 0x00FF00FF) * fy) >> 8) & 0x00FF00FF;
+
+    uint32_t rb = ((lRB * ifx + rRB * fx) >> 8) & 0x00FF00FF;
+    uint32_t ag = (lAG * ifx + rAG * fx) & 0xFF00FF00;
+    return rb | ag;
+}
+
+static inline uint32_t bilerp(const uint32_t *p, int width, uint32_t fx, uint32_t fy)
+{
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(256);
+
+    // 16-bit lanes: [p00 | p01] and [p10 | p11]
+    __m128i top = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)), zero);
+    __m128i bot = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p + width)), zero);
+
+    __m128i wy = _mm_set1_epi16(static_cast<short>(fy));
+    __m128i v = _mm_add_epi16(_mm_mullo_epi16(top, _mm_sub_epi16(full, wy)),
+                              _mm_mullo_epi16(bot, wy));
+    v = _mm_srli_epi16(v, 8); // [left | right]
+
+    __m128i wx = _mm_set1_epi16(static_cast<short>(fx));
+    wx = _mm_unpacklo_epi64(_mm_sub_epi16(full, wx), wx);
+    __m128i hsum = _mm_mullo_epi16(v, wx);
+    hsum = _mm_add_epi16(hsum, _mm_srli_si128(hsum, 8));
+    hsum = _mm_srli_epi16(hsum, 8);
+
+    return static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_packus_epi16(hsum, hsum)));
+#elif defined(__ARM_NEON)
+    uint16x8_t top = vmovl_u8(vld1_u8(reinterpret_cast<const uint8_t *>(p)));
+    uint16x8_t bot = vmovl_u8(vld1_u8(reinterpret_cast<const uint8_t *>(p + width)));
+
+    uint16x8_t v = vmlaq_n_u16(vmulq_n_u16(top, static_cast<uint16_t>(256 - fy)),
+                               bot, static_cast<uint16_t>(fy));
+    v = vshrq_n_u16(v, 8); // [left | right]
+
+    uint16x4_t hsum = vmla_n_u16(vmul_n_u16(vget_low_u16(v), static_cast<uint16_t>(256 - fx)),
+                                 vget_high_u16(v), static_cast<uint16_t>(fx));
+    hsum = vshr_n_u16(hsum, 8);
+
+    uint8x8_t packed = vmovn_u16(vcombine_u16(hsum, hsum));
+    return vget_lane_u32(vreinterpret_u32_u8(packed), 0);
+#else
+    return bilerpScalar(p, width, fx, fy);
+#endif
+}
+
+void AvsMoveTable::apply(const uint32_t *src, uint32_t *dst, const AvsMoveEntry *table,
+                         int count, int width, bool bilinear)
+{
+    if (!bilinear) {
+        for (int i = 0; i < count; i++) {
+            int32_t s = table[i].srcIndex;
+            dst[i] = (s >= 0) ? src[s] : 0xFF000000;
+        }
+        return;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const AvsMoveEntry &e = table[i];
+        if (e.srcIndex < 0) {
+            dst[i] = 0xFF000000;
+            continue;
+        }
+        dst[i] = bilerp(src + e.srcIndex, width, e.fracX, e.fracY);
+    }
+}
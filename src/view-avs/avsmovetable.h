@@ -0,0 +1,27 @@
+#ifndef AVSMOVETABLE_H
+#define AVSMOVETABLE_H
+
+#include <cstdint>
+
+// One destination pixel of a precomputed displacement map. The source
+// position is stored as the absolute index of its top-left neighbour plus an
+// 8-bit subpixel fraction in each axis, matching the AVS "bilinear" flag.
+struct AvsMoveEntry {
+    int32_t srcIndex; // -1 = source lies outside the frame (black)
+    uint8_t fracX;    // 0-255 between srcIndex and srcIndex + 1
+    uint8_t fracY;    // 0-255 between srcIndex and srcIndex + width
+};
+
+namespace AvsMoveTable {
+    // Build the entry for a source position in pixel coordinates
+    AvsMoveEntry entryFor(float srcX, float srcY, int width, int height);
+    // Same from a 16.16 fixed-point position, for incrementally stepped maps
+    AvsMoveEntry entryForFixed(int32_t srcX, int32_t srcY, int width, int height);
+
+    // Resample src into dst through the table. src and dst must not alias.
+    // bilinear = false takes the top-left neighbour only (the old blocky path).
+    void apply(const uint32_t *src, uint32_t *dst, const AvsMoveEntry *table,
+               int count, int width, bool bilinear);
+}
+
+#endif // AVSMOVETABLE_H
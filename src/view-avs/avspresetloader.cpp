@@ -0,0 +1,256 @@
+#include "avspresetloader.h"
+#include "avsblur.h"
+#include "avsbufferblend.h"
+#include "avsclearscreen.h"
+#include "avscolormodifier.h"
+#include "avsdynamicmovement.h"
+#include "avsfadeout.h"
+#include "avsgrain.h"
+#include "avsmirror.h"
+#include "avsmovement.h"
+#include "avsstarfield.h"
+#include "avssuperscope.h"
+#include "avswater.h"
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSettings>
+#include <QStandardPaths>
+#include <algorithm>
+
+namespace {
+
+QString keyValue(const AvsPresetLoader::Section &s, const char *key, const QString &fallback = QString())
+{
+    return s.keys.value(key, fallback);
+}
+
+int intValue(const AvsPresetLoader::Section &s, const char *key, int fallback)
+{
+    bool ok = false;
+    int v = s.keys.value(key).toInt(&ok);
+    return ok ? v : fallback;
+}
+
+float floatValue(const AvsPresetLoader::Section &s, const char *key, float fallback)
+{
+    bool ok = false;
+    float v = s.keys.value(key).toFloat(&ok);
+    return ok ? v : fallback;
+}
+
+bool boolValue(const AvsPresetLoader::Section &s, const char *key, bool fallback)
+{
+    QString v = s.keys.value(key).toLower();
+    if (v == "1" || v == "true" || v == "yes" || v == "on")
+        return true;
+    if (v == "0" || v == "false" || v == "no" || v == "off")
+        return false;
+    return fallback;
+}
+
+// #RRGGBB or 0xAARRGGBB
+uint32_t colorValue(const AvsPresetLoader::Section &s, const char *key, uint32_t fallback)
+{
+    QString v = s.keys.value(key);
+    bool ok = false;
+    uint32_t c = 0;
+    if (v.startsWith("#") && v.length() == 7)
+        c = 0xFF000000 | v.mid(1).toUInt(&ok, 16);
+    else if (v.startsWith("0x"))
+        c = v.mid(2).toUInt(&ok, 16);
+    return ok ? c : fallback;
+}
+
+// Index of value in names, or fallback
+int enumValue(const AvsPresetLoader::Section &s, const char *key,
+              const QStringList &names, int fallback)
+{
+    int idx = names.indexOf(s.keys.value(key).toLower());
+    return idx >= 0 ? idx : fallback;
+}
+
+std::unique_ptr<AvsEffect> createEffect(const AvsPresetLoader::Section &s)
+{
+    const QString &fx = s.effect;
+
+    if (fx == "clearscreen")
+        return std::make_unique<AvsClearScreen>(colorValue(s, "color", 0xFF000000));
+    if (fx == "fadeout")
+        return std::make_unique<AvsFadeOut>(intValue(s, "speed", 4));
+    if (fx == "blur")
+        return std::make_unique<AvsBlur>(intValue(s, "passes", 1));
+    if (fx == "grain")
+        return std::make_unique<AvsGrain>(intValue(s, "amount", 8), boolValue(s, "beat", true));
+    if (fx == "starfield")
+        return std::make_unique<AvsStarfield>(intValue(s, "count", 128), floatValue(s, "speed", 0.02f));
+    if (fx == "water")
+        return std::make_unique<AvsWater>(floatValue(s, "damping", 0.98f), floatValue(s, "beat", 50.0f));
+    if (fx == "bufferblend")
+        return std::make_unique<AvsBufferBlend>(floatValue(s, "ratio", 0.7f), keyValue(s, "target", "echo"));
+
+    if (fx == "mirror") {
+        auto mode = enumValue(s, "mode", {"horizontal", "vertical", "both"}, AvsMirror::Horizontal);
+        return std::make_unique<AvsMirror>(static_cast<AvsMirror::Mode>(mode));
+    }
+
+    if (fx == "colormodifier") {
+        auto mode = enumValue(s, "mode", {"invert", "grayscale", "hueshift", "brightnessboost"},
+                              AvsColorModifier::Invert);
+        return std::make_unique<AvsColorModifier>(static_cast<AvsColorModifier::Mode>(mode));
+    }
+
+    if (fx == "movement") {
+        auto type = enumValue(s, "type", {"zoomin", "zoomout", "swirl", "swirlout", "tunnel", "suckin"},
+                              AvsMovement::ZoomIn);
+        return std::make_unique<AvsMovement>(static_cast<AvsMovement::MovementType>(type),
+                                             boolValue(s, "bilinear", true));
+    }
+
+    if (fx == "superscope") {
+        auto scope = std::make_unique<AvsSuperScope>();
+        scope->color = colorValue(s, "color", scope->color);
+        scope->drawMode = static_cast<AvsSuperScope::DrawMode>(
+            enumValue(s, "drawmode", {"points", "lines"}, AvsSuperScope::Lines));
+        scope->sourceType = static_cast<AvsSuperScope::SourceType>(
+            enumValue(s, "source", {"waveform", "spectrum"}, AvsSuperScope::Waveform));
+        scope->lineWidth = std::clamp(intValue(s, "linewidth", 1), 1, 16);
+        scope->antialias = boolValue(s, "antialias", false);
+        scope->setCode(keyValue(s, "init"), keyValue(s, "frame"),
+                       keyValue(s, "beat"), keyValue(s, "point"));
+        return scope;
+    }
+
+    if (fx == "dynamicmovement") {
+        auto move = std::make_unique<AvsDynamicMovement>();
+        move->rectangular = boolValue(s, "rectangular", false);
+        move->bilinear = boolValue(s, "bilinear", true);
+        QString grid = keyValue(s, "grid").toLower();
+        if (grid == "0" || grid == "off") {
+            move->gridWidth = 0;
+            move->gridHeight = 0;
+        } else if (!grid.isEmpty()) {
+            // "16x12"
+            QStringList size = grid.split('x');
+            if (size.size() == 2) {
+                move->gridWidth = size[0].trimmed().toInt();
+                move->gridHeight = size[1].trimmed().toInt();
+            }
+        }
+        move->setCode(keyValue(s, "init"), keyValue(s, "frame"),
+                      keyValue(s, "beat"), keyValue(s, "pixel"));
+        return move;
+    }
+
+    return nullptr;
+}
+
+} // namespace
+
+QString AvsPresetLoader::presetDirectory()
+{
+    QString fallback = QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation) + "/avs";
+    return QSettings().value("avs/presetDir", fallback).toString();
+}
+
+QStringList AvsPresetLoader::presetFiles()
+{
+    QDir dir(presetDirectory());
+    QStringList files;
+    for (const QString &entry : dir.entryList({"*.avs"}, QDir::Files, QDir::Name))
+        files << dir.filePath(entry);
+    return files;
+}
+
+bool AvsPresetLoader::parse(const QString &text, Preset &out, QString *error)
+{
+    out = Preset();
+    QString *current = nullptr;
+    const QStringList lines = text.split('\n');
+
+    for (int n = 0; n < lines.size(); n++) {
+        const QString &raw = lines[n];
+        QString line = raw.trimmed();
+        if (line.isEmpty() || line.startsWith("#"))
+            continue;
+
+        // Indented lines continue the previous value
+        if (current && (raw.startsWith(" ") || raw.startsWith("\t"))) {
+            current->append('\n').append(line);
+            continue;
+        }
+
+        if (line.startsWith("[")) {
+            if (!line.endsWith("]")) {
+                if (error)
+                    *error = QString("line %1: missing ']'").arg(n + 1);
+                return false;
+            }
+            Section section;
+            section.effect = line.mid(1, line.length() - 2).trimmed().toLower();
+            section.line = n + 1;
+            out.sections.push_back(section);
+            current = nullptr;
+            continue;
+        }
+
+        int eq = line.indexOf('=');
+        if (eq <= 0) {
+            if (error)
+                *error = QString("line %1: expected key = value").arg(n + 1);
+            return false;
+        }
+        QString key = line.left(eq).trimmed().toLower();
+        QString value = line.mid(eq + 1).trimmed();
+
+        if (out.sections.empty()) {
+            if (key == "name") {
+                out.name = value;
+            } else if (key == "quality") {
+                int level = QualityGovernor::parseLevel(value.toLower().toUtf8().constData());
+                if (level == QualityGovernor::INVALID)
+                    qWarning() << "[avs] line" << n + 1 << "unknown quality" << value;
+                else
+                    out.quality = level;
+            }
+            current = nullptr;
+            continue;
+        }
+        QHash<QString, QString> &keys = out.sections.back().keys;
+        keys.insert(key, value);
+        current = &keys[key];
+    }
+
+    return true;
+}
+
+bool AvsPresetLoader::load(const QString &path, Preset &out, QString *error)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        if (error)
+            *error = file.errorString();
+        return false;
+    }
+    if (!parse(QString::fromUtf8(file.readAll()), out, error))
+        return false;
+    if (out.name.isEmpty())
+        out.name = QFileInfo(path).completeBaseName();
+    return true;
+}
+
+std::vector<std::unique_ptr<AvsEffect>> AvsPresetLoader::createEffects(const Preset &preset)
+{
+    std::vector<std::unique_ptr<AvsEffect>> effects;
+    for (const Section &section : preset.sections) {
+        auto effect = createEffect(section);
+        if (!effect) {
+            qWarning() << "[avs]" << preset.name << "line" << section.line
+                       << "unknown effect" << section.effect;
+            continue;
+        }
+        effects.push_back(std::move(effect));
+    }
+    return effects;
+}
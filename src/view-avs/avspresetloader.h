@@ -0,0 +1,50 @@
+#ifndef AVSPRESETLOADER_H
+#define AVSPRESETLOADER_H
+
+#include "avseffect.h"
+#include "qualitygovernor.h"
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <memory>
+#include <vector>
+
+// Text presets so scripted effects can be written without a rebuild:
+//
+//   name = Lissajous
+//   [fadeout]
+//   speed = 6
+//   [superscope]
+//   init = n = 400
+//   point = x = sin(i * $pi * 6 + t);
+//     y = cos(i * $pi * 4) * 0.8
+//
+// "[effect]" starts a section, "key = value" sets a parameter and lines that
+// start with whitespace continue the previous value. '#' starts a comment
+// line. See docs/AVS_PRESETS.md for the effect and key reference.
+namespace AvsPresetLoader {
+    struct Section {
+        QString effect;
+        QHash<QString, QString> keys;
+        int line = 0;
+    };
+
+    struct Preset {
+        QString name;
+        int quality = QualityGovernor::AUTO; // or a QualityGovernor::Level to pin
+        std::vector<Section> sections;
+    };
+
+    // QSettings "avs/presetDir", default <config>/avs
+    QString presetDirectory();
+    // *.avs files in the preset directory, sorted by name
+    QStringList presetFiles();
+
+    bool parse(const QString &text, Preset &out, QString *error = nullptr);
+    bool load(const QString &path, Preset &out, QString *error = nullptr);
+
+    // Unknown effects and bad values are logged and skipped
+    std::vector<std::unique_ptr<AvsEffect>> createEffects(const Preset &preset);
+}
+
+#endif // AVSPRESETLOADER_H
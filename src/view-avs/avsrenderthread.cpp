@@ -0,0 +1,126 @@
+#include "avsrenderthread.h"
+#include "pixelkernels.h"
+#include <QElapsedTimer>
+#include <algorithm>
+
+AvsRenderThread::AvsRenderThread(QObject *parent)
+    : QThread(parent)
+{
+    m_status.presetName = m_engine.presetName();
+    m_status.stats = m_engine.stats();
+}
+
+AvsRenderThread::~AvsRenderThread()
+{
+    stop();
+}
+
+void AvsRenderThread::stop()
+{
+    requestInterruption();
+    wait();
+}
+
+AvsRenderThread::Status AvsRenderThread::status() const
+{
+    QMutexLocker l(&m_statusMutex);
+    return m_status;
+}
+
+void AvsRenderThread::applyPresetQuality()
+{
+    m_governor.setForcedLevel(m_engine.presetQuality());
+    m_governor.reset();
+    m_engine.setQualityLevel(m_governor.level());
+}
+
+void AvsRenderThread::setOutputSize(const QSize &size)
+{
+    uint32_t packed = 0;
+    if (!size.isEmpty())
+        packed = uint32_t(std::min(size.width(), 0xFFFF)) << 16 | uint32_t(std::min(size.height(), 0xFFFF));
+    m_outputSize.store(packed, std::memory_order_relaxed);
+}
+
+void AvsRenderThread::publishFrame(const QImage &frame)
+{
+    // The engine's image wraps its own buffer, which the next frame
+    // overwrites, so the frame goes into a slot the view can keep, scaled
+    // on the way
+    uint32_t packed = m_outputSize.load(std::memory_order_relaxed);
+    QSize size = packed ? QSize(packed >> 16, packed & 0xFFFF) : frame.size();
+
+    QImage &slot = m_frames.writeSlot();
+    if (slot.size() != size || slot.format() != frame.format())
+        slot = QImage(size, frame.format());
+    PixelKernels::scaleNearest(reinterpret_cast<const uint32_t *>(frame.constBits()),
+                               frame.width(), frame.height(), frame.bytesPerLine() / 4,
+                               reinterpret_cast<uint32_t *>(slot.bits()),
+                               slot.width(), slot.height(), slot.bytesPerLine() / 4);
+}
+
+void AvsRenderThread::run()
+{
+    {
+        QMutexLocker l(&m_statusMutex);
+        m_status.frames = 0;
+        m_status.missed = 0;
+        m_status.dropped = 0;
+    }
+
+    applyPresetQuality();
+
+    QElapsedTimer clock;
+    clock.start();
+    qint64 next = 0; // start of the next frame slot, in microseconds
+
+    while (!isInterruptionRequested()) {
+        int step = m_presetStep.exchange(0, std::memory_order_relaxed);
+        bool presetStepped = step != 0;
+        for (; step > 0; step--)
+            m_engine.nextPreset();
+        for (; step < 0; step++)
+            m_engine.prevPreset();
+        if (presetStepped)
+            applyPresetQuality();
+
+        m_audio.fetch();
+        qint64 started = clock.nsecsElapsed();
+        const QImage &frame = m_engine.renderFrame(m_audio.readSlot());
+        if (m_governor.addFrame((clock.nsecsElapsed() - started) / 1000))
+            m_engine.setQualityLevel(m_governor.level());
+        publishFrame(frame);
+        bool dropped = m_frames.publish();
+
+        {
+            QMutexLocker l(&m_statusMutex);
+            m_status.presetName = m_engine.presetName();
+            m_status.stats = m_engine.stats();
+            m_status.quality = m_governor.level();
+            m_status.qualityForced = m_governor.isForced();
+            m_status.frameCostUs = m_governor.averageCostUs();
+            m_status.frames++;
+            if (dropped)
+                m_status.dropped++;
+        }
+        if (presetStepped)
+            emit presetChanged(m_engine.presetName());
+        emit frameReady();
+
+        // Keep to the frame grid; a frame that overruns its slot skips the
+        // slots it ran into rather than rendering late ones back to back
+        qint64 interval = m_governor.frameIntervalUs();
+        int cap = m_frameRateCap.load(std::memory_order_relaxed);
+        if (cap > 0)
+            interval = std::max<qint64>(interval, 1000000 / cap);
+        next += interval;
+        qint64 now = clock.nsecsElapsed() / 1000;
+        if (now > next) {
+            qint64 late = (now - next) / interval + 1;
+            next += late * interval;
+            QMutexLocker l(&m_statusMutex);
+            m_status.missed += late;
+        }
+        usleep(static_cast<unsigned long>(next - now));
+    }
+}
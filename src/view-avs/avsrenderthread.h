@@ -0,0 +1,83 @@
+#ifndef AVSRENDERTHREAD_H
+#define AVSRENDERTHREAD_H
+
+#include <QThread>
+#include <QImage>
+#include <QMutex>
+#include <QSize>
+#include <QString>
+#include <atomic>
+#include "avsengine.h"
+#include "avsaudiodata.h"
+#include "avstriplebuffer.h"
+
+// Runs the AVS engine on its own thread at a fixed frame rate, so a heavy
+// preset never stalls input, painting or the API server on the GUI thread.
+// Finished frames go out through a triple buffer the view picks the newest
+// one from; audio analysis comes in through another. The engine belongs to
+// this thread while it runs; the GUI side only sends preset steps and reads
+// the published status. A QualityGovernor fed with each frame's render time
+// picks the quality level and frame rate. Frames are scaled to the view's
+// size here too, so painting them is a 1:1 blit.
+class AvsRenderThread : public QThread
+{
+    Q_OBJECT
+
+public:
+    struct Status {
+        QString presetName;
+        AvsEngine::Stats stats;
+        quint64 frames = 0;  // frames rendered since start()
+        quint64 missed = 0;  // frame slots the renderer overran
+        quint64 dropped = 0; // frames replaced before the view showed them
+        QualityGovernor::Level quality = QualityGovernor::Full;
+        bool qualityForced = false; // pinned by the preset
+        qint64 frameCostUs = 0;     // smoothed render time per frame
+    };
+
+    explicit AvsRenderThread(QObject *parent = nullptr);
+    ~AvsRenderThread() override;
+
+    // Only while the thread is stopped
+    AvsEngine &engine() { return m_engine; }
+
+    void stop();
+
+    // GUI side
+    void stepPreset(int delta) { m_presetStep.fetch_add(delta, std::memory_order_relaxed); }
+    // Ceiling on top of the governor's rate, 0 for none
+    void setFrameRateCap(int fps) { m_frameRateCap.store(fps, std::memory_order_relaxed); }
+    // Size frames are published at, scaled nearest-neighbour from the
+    // engine's framebuffer; an empty size publishes them as rendered
+    void setOutputSize(const QSize &size);
+    AvsTripleBuffer<AvsAudioData> &audio() { return m_audio; }
+    AvsTripleBuffer<QImage> &frames() { return m_frames; }
+    Status status() const;
+
+    static constexpr int FRAME_INTERVAL_US = 33333; // 30 FPS at full quality
+
+signals:
+    // Emitted from the render thread after each publish
+    void frameReady();
+    void presetChanged(const QString &name);
+
+protected:
+    void run() override;
+
+private:
+    void publishFrame(const QImage &frame);
+    void applyPresetQuality();
+
+    AvsEngine m_engine;
+    QualityGovernor m_governor{FRAME_INTERVAL_US};
+    AvsTripleBuffer<AvsAudioData> m_audio;
+    AvsTripleBuffer<QImage> m_frames;
+    std::atomic<int> m_presetStep{0};
+    std::atomic<int> m_frameRateCap{0};
+    std::atomic<uint32_t> m_outputSize{0}; // width << 16 | height, 0 for native
+
+    mutable QMutex m_statusMutex;
+    Status m_status;
+};
+
+#endif // AVSRENDERTHREAD_H
@@ -0,0 +1,776 @@
+#include "avsscript.h"
+#include "avsaudiodata.h"
+#include <QByteArray>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+namespace {
+
+enum Op : uint8_t {
+    OpMov, OpAdd, OpSub, OpMul, OpDiv, OpMod, OpPow, OpNeg, OpNot,
+    OpEq, OpNe, OpLt, OpGt, OpLe, OpGe, OpAnd, OpOr,
+    OpSin, OpCos, OpTan, OpAsin, OpAcos, OpAtan, OpAtan2,
+    OpSqrt, OpSqr, OpInvSqrt, OpExp, OpLog, OpLog10,
+    OpAbs, OpSign, OpMin, OpMax, OpFloor, OpCeil,
+    OpSelect, OpRand, OpGetOsc, OpGetSpec
+};
+
+struct FunctionDef {
+    const char *name;
+    int op;      // -1 for the ones the parser builds itself
+    int arity;
+};
+
+constexpr int FnIf = -1;
+constexpr int FnAssign = -2;
+
+const FunctionDef FUNCTIONS[] = {
+    {"sin", OpSin, 1}, {"cos", OpCos, 1}, {"tan", OpTan, 1},
+    {"asin", OpAsin, 1}, {"acos", OpAcos, 1}, {"atan", OpAtan, 1},
+    {"atan2", OpAtan2, 2}, {"sqrt", OpSqrt, 1}, {"sqr", OpSqr, 1},
+    {"invsqrt", OpInvSqrt, 1}, {"pow", OpPow, 2}, {"exp", OpExp, 1},
+    {"log", OpLog, 1}, {"log10", OpLog10, 1}, {"abs", OpAbs, 1},
+    {"sign", OpSign, 1}, {"min", OpMin, 2}, {"max", OpMax, 2},
+    {"floor", OpFloor, 1}, {"ceil", OpCeil, 1}, {"equal", OpEq, 2},
+    {"above", OpGt, 2}, {"below", OpLt, 2}, {"band", OpAnd, 2},
+    {"bor", OpOr, 2}, {"bnot", OpNot, 1}, {"rand", OpRand, 1},
+    {"getosc", OpGetOsc, 3}, {"getspec", OpGetSpec, 3},
+    {"if", FnIf, 3}, {"assign", FnAssign, 2},
+};
+
+bool isPure(int op)
+{
+    return op != OpRand && op != OpGetOsc && op != OpGetSpec;
+}
+
+// Scalar semantics shared by the VM loops and constant folding. Division and
+// modulo by zero yield 0 as in EEL.
+inline float safeDiv(float a, float b) { return b != 0.0f ? a / b : 0.0f; }
+inline float intMod(float a, float b)
+{
+    int ib = static_cast<int>(b);
+    return ib != 0 ? static_cast<float>(static_cast<int>(a) % ib) : 0.0f;
+}
+inline float truth(bool v) { return v ? 1.0f : 0.0f; }
+inline float nearlyEqual(float a, float b) { return truth(fabsf(a - b) < 0.00001f); }
+inline float sign(float a) { return a > 0.0f ? 1.0f : (a < 0.0f ? -1.0f : 0.0f); }
+inline float invSqrt(float a) { return a > 0.0f ? 1.0f / sqrtf(a) : 0.0f; }
+
+float foldOp(int op, float a, float b, float c)
+{
+    switch (op) {
+    case OpMov: return a;
+    case OpAdd: return a + b;
+    case OpSub: return a - b;
+    case OpMul: return a * b;
+    case OpDiv: return safeDiv(a, b);
+    case OpMod: return intMod(a, b);
+    case OpPow: return powf(a, b);
+    case OpNeg: return -a;
+    case OpNot: return truth(a == 0.0f);
+    case OpEq: return nearlyEqual(a, b);
+    case OpNe: return 1.0f - nearlyEqual(a, b);
+    case OpLt: return truth(a < b);
+    case OpGt: return truth(a > b);
+    case OpLe: return truth(a <= b);
+    case OpGe: return truth(a >= b);
+    case OpAnd: return truth(a != 0.0f && b != 0.0f);
+    case OpOr: return truth(a != 0.0f || b != 0.0f);
+    case OpSin: return sinf(a);
+    case OpCos: return cosf(a);
+    case OpTan: return tanf(a);
+    case OpAsin: return asinf(a);
+    case OpAcos: return acosf(a);
+    case OpAtan: return atanf(a);
+    case OpAtan2: return atan2f(a, b);
+    case OpSqrt: return sqrtf(fabsf(a));
+    case OpSqr: return a * a;
+    case OpInvSqrt: return invSqrt(a);
+    case OpExp: return expf(a);
+    case OpLog: return logf(a);
+    case OpLog10: return log10f(a);
+    case OpAbs: return fabsf(a);
+    case OpSign: return sign(a);
+    case OpMin: return std::min(a, b);
+    case OpMax: return std::max(a, b);
+    case OpFloor: return floorf(a);
+    case OpCeil: return ceilf(a);
+    case OpSelect: return a != 0.0f ? b : c;
+    default: return 0.0f;
+    }
+}
+
+// Average of `width` (fraction of the buffer) samples around `band` (0-1)
+float sampleBand(const float *data, int size, float band, float width)
+{
+    int center = std::clamp(static_cast<int>(band * size), 0, size - 1);
+    int half = std::max(0, static_cast<int>(width * size * 0.5f));
+    int lo = std::max(0, center - half);
+    int hi = std::min(size - 1, center + half);
+    float sum = 0.0f;
+    for (int i = lo; i <= hi; i++)
+        sum += data[i];
+    return sum / (hi - lo + 1);
+}
+
+} // namespace
+
+struct AvsScript::Node {
+    enum Kind { Num, Var, Apply, Assign, If, Seq };
+
+    Kind kind;
+    int op = 0;
+    float value = 0.0f;
+    int slot = -1;
+    std::vector<std::unique_ptr<Node>> args;
+
+    explicit Node(Kind k) : kind(k) {}
+};
+
+// Recursive descent over the lower-cased source. Errors are sticky: the
+// first one is kept and parsing unwinds with placeholder nodes.
+class AvsScript::Parser
+{
+public:
+    using NodePtr = std::unique_ptr<Node>;
+
+    Parser(AvsScript &script, const QString &source)
+        : m_script(script), m_src(source.toLower().toStdString()) {}
+
+    NodePtr parseProgram()
+    {
+        NodePtr seq = parseSeq();
+        if (!atEnd())
+            fail(std::string("unexpected '") + m_src[m_pos] + "'");
+        return seq;
+    }
+
+    bool failed() const { return !m_error.empty(); }
+    QString error() const { return QString::fromStdString(m_error); }
+
+private:
+    AvsScript &m_script;
+    std::string m_src;
+    size_t m_pos = 0;
+    std::string m_error;
+
+    void fail(const std::string &msg)
+    {
+        if (m_error.empty())
+            m_error = "column " + std::to_string(m_pos + 1) + ": " + msg;
+    }
+
+    static NodePtr number(float v)
+    {
+        NodePtr n = std::make_unique<Node>(Node::Num);
+        n->value = v;
+        return n;
+    }
+
+    static NodePtr apply(int op, NodePtr a, NodePtr b = nullptr)
+    {
+        NodePtr n = std::make_unique<Node>(Node::Apply);
+        n->op = op;
+        n->args.push_back(std::move(a));
+        if (b)
+            n->args.push_back(std::move(b));
+        return n;
+    }
+
+    char peek(size_t ahead = 0) const
+    {
+        return m_pos + ahead < m_src.size() ? m_src[m_pos + ahead] : '\0';
+    }
+
+    void skipSpace()
+    {
+        while (m_pos < m_src.size()) {
+            if (isspace(static_cast<unsigned char>(peek()))) {
+                m_pos++;
+            } else if (peek() == '/' && peek(1) == '/') {
+                while (m_pos < m_src.size() && peek() != '\n')
+                    m_pos++;
+            } else if (peek() == '/' && peek(1) == '*') {
+                size_t end = m_src.find("*/", m_pos + 2);
+                m_pos = (end == std::string::npos) ? m_src.size() : end + 2;
+            } else {
+                break;
+            }
+        }
+    }
+
+    bool atEnd()
+    {
+        skipSpace();
+        return m_pos >= m_src.size();
+    }
+
+    bool accept(const char *tok)
+    {
+        skipSpace();
+        size_t len = strlen(tok);
+        if (m_src.compare(m_pos, len, tok) != 0)
+            return false;
+        // Don't take "=" out of "==" or "<" out of "<="
+        if (len == 1 && peek(1) == '=' && strchr("=<>!+-*/%", tok[0]))
+            return false;
+        m_pos += len;
+        return true;
+    }
+
+    NodePtr parseSeq()
+    {
+        NodePtr seq = std::make_unique<Node>(Node::Seq);
+        while (!failed()) {
+            if (accept(";"))
+                continue;
+            if (atEnd() || peek() == ')' || peek() == ',')
+                break;
+            seq->args.push_back(parseAssign());
+            if (!accept(";"))
+                break;
+        }
+        return seq;
+    }
+
+    NodePtr parseAssign()
+    {
+        NodePtr lhs = parseOr();
+        static const struct { const char *tok; int op; } ops[] = {
+            {"+=", OpAdd}, {"-=", OpSub}, {"*=", OpMul}, {"/=", OpDiv}, {"%=", OpMod}, {"=", -1},
+        };
+        for (const auto &o : ops) {
+            if (!accept(o.tok))
+                continue;
+            if (lhs->kind != Node::Var) {
+                fail("assignment to something that is not a variable");
+                return lhs;
+            }
+            int slot = lhs->slot;
+            NodePtr rhs = parseAssign();
+            if (o.op >= 0)
+                rhs = apply(o.op, std::move(lhs), std::move(rhs));
+            NodePtr n = std::make_unique<Node>(Node::Assign);
+            n->slot = slot;
+            n->args.push_back(std::move(rhs));
+            return n;
+        }
+        return lhs;
+    }
+
+    NodePtr parseOr()
+    {
+        NodePtr n = parseAnd();
+        while (!failed() && accept("||"))
+            n = apply(OpOr, std::move(n), parseAnd());
+        return n;
+    }
+
+    NodePtr parseAnd()
+    {
+        NodePtr n = parseCompare();
+        while (!failed() && accept("&&"))
+            n = apply(OpAnd, std::move(n), parseCompare());
+        return n;
+    }
+
+    NodePtr parseCompare()
+    {
+        NodePtr n = parseAdd();
+        while (!failed()) {
+            if (accept("=="))      n = apply(OpEq, std::move(n), parseAdd());
+            else if (accept("!=")) n = apply(OpNe, std::move(n), parseAdd());
+            else if (accept("<=")) n = apply(OpLe, std::move(n), parseAdd());
+            else if (accept(">=")) n = apply(OpGe, std::move(n), parseAdd());
+            else if (accept("<"))  n = apply(OpLt, std::move(n), parseAdd());
+            else if (accept(">"))  n = apply(OpGt, std::move(n), parseAdd());
+            else break;
+        }
+        return n;
+    }
+
+    NodePtr parseAdd()
+    {
+        NodePtr n = parseMul();
+        while (!failed()) {
+            if (accept("+"))      n = apply(OpAdd, std::move(n), parseMul());
+            else if (accept("-")) n = apply(OpSub, std::move(n), parseMul());
+            else break;
+        }
+        return n;
+    }
+
+    NodePtr parseMul()
+    {
+        NodePtr n = parseUnary();
+        while (!failed()) {
+            if (accept("*"))      n = apply(OpMul, std::move(n), parseUnary());
+            else if (accept("/")) n = apply(OpDiv, std::move(n), parseUnary());
+            else if (accept("%")) n = apply(OpMod, std::move(n), parseUnary());
+            else break;
+        }
+        return n;
+    }
+
+    NodePtr parseUnary()
+    {
+        if (accept("-"))
+            return apply(OpNeg, parseUnary());
+        if (accept("+"))
+            return parseUnary();
+        if (accept("!"))
+            return apply(OpNot, parseUnary());
+        NodePtr n = parsePrimary();
+        if (!failed() && accept("^"))
+            n = apply(OpPow, std::move(n), parseUnary());
+        return n;
+    }
+
+    size_t scanDigits()
+    {
+        const size_t start = m_pos;
+        while (isdigit(static_cast<unsigned char>(peek())))
+            m_pos++;
+        return m_pos - start;
+    }
+
+    // strtof would follow LC_NUMERIC, which QApplication takes from the
+    // environment, so "0.5" stops at the '.' under a comma-decimal locale.
+    // The digits are scanned here and converted in the C locale instead.
+    NodePtr parseNumber()
+    {
+        const size_t start = m_pos;
+        const size_t intDigits = scanDigits();
+        size_t fracStart = m_pos;
+        size_t fracDigits = 0;
+        if (peek() == '.') {
+            m_pos++;
+            fracStart = m_pos;
+            fracDigits = scanDigits();
+        }
+        if (intDigits == 0 && fracDigits == 0) {
+            m_pos = start;
+            fail("bad number");
+            m_pos++;
+            return number(0.0f);
+        }
+
+        // Written out in full, 0.5 rather than .5 and 5.0 rather than 5.
+        QByteArray literal = intDigits ? QByteArray(m_src.data() + start, intDigits) : QByteArray("0");
+        literal += '.';
+        literal += fracDigits ? QByteArray(m_src.data() + fracStart, fracDigits) : QByteArray("0");
+
+        // An exponent only counts with digits after it
+        if (peek() == 'e') {
+            const size_t expStart = m_pos++;
+            if (peek() == '+' || peek() == '-')
+                m_pos++;
+            if (scanDigits() > 0)
+                literal += QByteArray(m_src.data() + expStart, m_pos - expStart);
+            else
+                m_pos = expStart;
+        }
+
+        return number(literal.toFloat());
+    }
+
+    NodePtr parsePrimary()
+    {
+        if (atEnd()) {
+            fail("unexpected end of code");
+            return number(0.0f);
+        }
+
+        if (accept("(")) {
+            NodePtr inner = parseSeq();
+            if (!accept(")"))
+                fail("missing ')'");
+            return inner;
+        }
+
+        char ch = peek();
+        if (isdigit(static_cast<unsigned char>(ch)) || ch == '.')
+            return parseNumber();
+
+        if (isalpha(static_cast<unsigned char>(ch)) || ch == '_' || ch == '$') {
+            size_t start = m_pos++;
+            while (isalnum(static_cast<unsigned char>(peek())) || peek() == '_')
+                m_pos++;
+            std::string ident = m_src.substr(start, m_pos - start);
+
+            if (ident[0] == '$') {
+                if (ident == "$pi")  return number(static_cast<float>(M_PI));
+                if (ident == "$e")   return number(2.71828182845904523536f);
+                if (ident == "$phi") return number(1.61803398874989484820f);
+                fail("unknown constant " + ident);
+                return number(0.0f);
+            }
+
+            if (accept("("))
+                return parseCall(ident);
+
+            NodePtr n = std::make_unique<Node>(Node::Var);
+            n->slot = m_script.variable(QString::fromStdString(ident));
+            return n;
+        }
+
+        fail(std::string("unexpected '") + ch + "'");
+        return number(0.0f);
+    }
+
+    NodePtr parseCall(const std::string &ident)
+    {
+        const FunctionDef *fn = nullptr;
+        for (const FunctionDef &f : FUNCTIONS) {
+            if (ident == f.name) {
+                fn = &f;
+                break;
+            }
+        }
+        if (!fn) {
+            fail("unknown function " + ident);
+            return number(0.0f);
+        }
+
+        std::vector<NodePtr> args;
+        if (!accept(")")) {
+            do {
+                args.push_back(parseAssign());
+            } while (!failed() && accept(","));
+            if (!accept(")"))
+                fail("missing ')' after arguments to " + ident);
+        }
+        if (failed())
+            return number(0.0f);
+        if (static_cast<int>(args.size()) != fn->arity) {
+            fail(ident + " takes " + std::to_string(fn->arity) + " arguments");
+            return number(0.0f);
+        }
+
+        if (fn->op == FnAssign) {
+            if (args[0]->kind != Node::Var) {
+                fail("assign() needs a variable");
+                return number(0.0f);
+            }
+            NodePtr n = std::make_unique<Node>(Node::Assign);
+            n->slot = args[0]->slot;
+            n->args.push_back(std::move(args[1]));
+            return n;
+        }
+
+        NodePtr n = std::make_unique<Node>(fn->op == FnIf ? Node::If : Node::Apply);
+        n->op = fn->op;
+        n->args = std::move(args);
+        return n;
+    }
+};
+
+// Evaluates pure operations on constants at compile time
+void AvsScript::foldConstants(Node &n)
+{
+    for (auto &arg : n.args)
+        foldConstants(*arg);
+
+    auto isNum = [](const std::unique_ptr<Node> &p) { return p->kind == Node::Num; };
+
+    if (n.kind == Node::Apply && isPure(n.op) && std::all_of(n.args.begin(), n.args.end(), isNum)) {
+        float a = n.args.size() > 0 ? n.args[0]->value : 0.0f;
+        float b = n.args.size() > 1 ? n.args[1]->value : 0.0f;
+        float c = n.args.size() > 2 ? n.args[2]->value : 0.0f;
+        n.value = foldOp(n.op, a, b, c);
+        n.kind = Node::Num;
+        n.args.clear();
+    } else if (n.kind == Node::If && isNum(n.args[0])) {
+        // Only the taken branch survives, assignments included
+        std::unique_ptr<Node> taken = std::move(n.args[n.args[0]->value != 0.0f ? 1 : 2]);
+        n = std::move(*taken);
+    }
+}
+
+// Lowers the folded tree to instructions. cond is the slot holding the
+// combined condition of the enclosing if() branches, or -1; assignments
+// under a condition become selects so untaken branches leave values alone.
+class AvsScript::CodeGen
+{
+public:
+    CodeGen(AvsScript &script, Program &program) : m_script(script), m_program(program) {}
+
+    void statement(const Node &n)
+    {
+        m_nextTemp = 0; // temporaries only live for one statement
+        gen(n, -1, -1);
+    }
+
+private:
+    AvsScript &m_script;
+    Program &m_program;
+    int m_nextTemp = 0;
+
+    int temp()
+    {
+        if (m_nextTemp >= static_cast<int>(m_script.m_temps.size()))
+            m_script.m_temps.push_back(m_script.newSlot(0.0f));
+        return m_script.m_temps[m_nextTemp++];
+    }
+
+    void emit(int op, int dst, int a, int b = 0, int c = 0)
+    {
+        m_program.code.push_back({static_cast<uint8_t>(op), dst, a, b, c});
+    }
+
+    int gen(const Node &n, int hint, int cond)
+    {
+        switch (n.kind) {
+        case Node::Num:
+            return m_script.constant(n.value);
+
+        case Node::Var:
+            return n.slot;
+
+        case Node::Apply: {
+            int a = n.args.size() > 0 ? gen(*n.args[0], -1, cond) : 0;
+            int b = n.args.size() > 1 ? gen(*n.args[1], -1, cond) : 0;
+            int c = n.args.size() > 2 ? gen(*n.args[2], -1, cond) : 0;
+            int dst = hint >= 0 ? hint : temp();
+            emit(n.op, dst, a, b, c);
+            return dst;
+        }
+
+        case Node::Assign: {
+            if (cond < 0) {
+                int r = gen(*n.args[0], n.slot, cond);
+                if (r != n.slot)
+                    emit(OpMov, n.slot, r);
+            } else {
+                int r = gen(*n.args[0], -1, cond);
+                emit(OpSelect, n.slot, cond, r, n.slot);
+            }
+            return n.slot;
+        }
+
+        case Node::If: {
+            // A plain variable condition is that variable's own slot, which
+            // either branch may assign (if(x, x = 0, 5)), so take a copy
+            int c = temp();
+            emit(OpMov, c, gen(*n.args[0], -1, cond));
+            int thenCond = c;
+            int elseCond = temp();
+            emit(OpNot, elseCond, c);
+            if (cond >= 0) {
+                thenCond = temp();
+                emit(OpAnd, thenCond, cond, c);
+                emit(OpAnd, elseCond, cond, elseCond);
+            }
+            int t = gen(*n.args[1], -1, thenCond);
+            int e = gen(*n.args[2], -1, elseCond);
+            int dst = hint >= 0 && cond < 0 ? hint : temp();
+            emit(OpSelect, dst, c, t, e);
+            return dst;
+        }
+
+        case Node::Seq: {
+            int last = m_script.constant(0.0f);
+            for (size_t i = 0; i < n.args.size(); i++)
+                last = gen(*n.args[i], i + 1 == n.args.size() ? hint : -1, cond);
+            return last;
+        }
+        }
+        return 0;
+    }
+};
+
+AvsScript::AvsScript()
+{
+    constant(0.0f); // slot 0: operand for unused instruction inputs
+}
+
+int AvsScript::newSlot(float initial)
+{
+    m_values.push_back(initial);
+    m_persistent.push_back(false);
+    return static_cast<int>(m_values.size()) - 1;
+}
+
+int AvsScript::constant(float v)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    int existing = m_constants.value(bits, -1);
+    if (existing >= 0)
+        return existing;
+    int slot = newSlot(v);
+    m_constants.insert(bits, slot);
+    return slot;
+}
+
+int AvsScript::variable(const QString &name)
+{
+    QString key = name.toLower();
+    int existing = m_variables.value(key, -1);
+    if (existing >= 0)
+        return existing;
+    int slot = newSlot(0.0f);
+    m_persistent[slot] = true;
+    m_variables.insert(key, slot);
+    return slot;
+}
+
+bool AvsScript::compile(const QString &source, Program &out, QString *error)
+{
+    out = Program();
+
+    Parser parser(*this, source);
+    std::unique_ptr<Node> root = parser.parseProgram();
+    if (parser.failed()) {
+        if (error)
+            *error = parser.error();
+        return false;
+    }
+
+    foldConstants(*root);
+
+    CodeGen gen(*this, out);
+    if (root->kind == Node::Seq) {
+        for (const auto &stmt : root->args)
+            gen.statement(*stmt);
+    } else {
+        gen.statement(*root);
+    }
+
+    // Reading a variable before writing it makes each point depend on the
+    // previous one (t = t + 1 in per-point code)
+    std::vector<bool> written(m_values.size(), false);
+    std::vector<bool> writtenAnywhere(m_values.size(), false);
+    for (const Instr &in : out.code)
+        writtenAnywhere[in.dst] = true;
+    for (const Instr &in : out.code) {
+        for (int src : {in.a, in.b, in.c}) {
+            if (m_persistent[src] && writtenAnywhere[src] && !written[src])
+                out.carriesState = true;
+        }
+        written[in.dst] = true;
+    }
+
+    return true;
+}
+
+void AvsScript::run(const Program &program)
+{
+    execute(program, m_values.data(), 1, 1);
+}
+
+void AvsScript::beginBatch()
+{
+    size_t slots = m_values.size();
+    m_batch.resize(slots * BATCH);
+    for (size_t s = 0; s < slots; s++)
+        std::fill_n(&m_batch[s * BATCH], BATCH, m_values[s]);
+}
+
+void AvsScript::runBatch(const Program &program, int count)
+{
+    execute(program, m_batch.data(), BATCH, count);
+}
+
+void AvsScript::endBatch(int lastLane)
+{
+    if (lastLane < 0)
+        return;
+    for (size_t s = 0; s < m_values.size(); s++) {
+        if (m_persistent[s])
+            m_values[s] = m_batch[s * BATCH + lastLane];
+    }
+}
+
+void AvsScript::execute(const Program &program, float *regs, int stride, int count)
+{
+    for (const Instr &in : program.code) {
+        float *d = regs + static_cast<size_t>(in.dst) * stride;
+        const float *a = regs + static_cast<size_t>(in.a) * stride;
+        const float *b = regs + static_cast<size_t>(in.b) * stride;
+        const float *c = regs + static_cast<size_t>(in.c) * stride;
+
+// One tight loop per opcode so the compiler can vectorize the simple ones
+#define AVS_LANES(expr) for (int l = 0; l < count; l++) { d[l] = (expr); } break;
+
+        switch (in.op) {
+        case OpMov:     AVS_LANES(a[l])
+        case OpAdd:     AVS_LANES(a[l] + b[l])
+        case OpSub:     AVS_LANES(a[l] - b[l])
+        case OpMul:     AVS_LANES(a[l] * b[l])
+        case OpDiv:     AVS_LANES(safeDiv(a[l], b[l]))
+        case OpMod:     AVS_LANES(intMod(a[l], b[l]))
+        case OpPow:     AVS_LANES(powf(a[l], b[l]))
+        case OpNeg:     AVS_LANES(-a[l])
+        case OpNot:     AVS_LANES(truth(a[l] == 0.0f))
+        case OpEq:      AVS_LANES(nearlyEqual(a[l], b[l]))
+        case OpNe:      AVS_LANES(1.0f - nearlyEqual(a[l], b[l]))
+        case OpLt:      AVS_LANES(truth(a[l] < b[l]))
+        case OpGt:      AVS_LANES(truth(a[l] > b[l]))
+        case OpLe:      AVS_LANES(truth(a[l] <= b[l]))
+        case OpGe:      AVS_LANES(truth(a[l] >= b[l]))
+        case OpAnd:     AVS_LANES(truth(a[l] != 0.0f && b[l] != 0.0f))
+        case OpOr:      AVS_LANES(truth(a[l] != 0.0f || b[l] != 0.0f))
+        case OpSin:     AVS_LANES(sinf(a[l]))
+        case OpCos:     AVS_LANES(cosf(a[l]))
+        case OpTan:     AVS_LANES(tanf(a[l]))
+        case OpAsin:    AVS_LANES(asinf(a[l]))
+        case OpAcos:    AVS_LANES(acosf(a[l]))
+        case OpAtan:    AVS_LANES(atanf(a[l]))
+        case OpAtan2:   AVS_LANES(atan2f(a[l], b[l]))
+        case OpSqrt:    AVS_LANES(sqrtf(fabsf(a[l])))
+        case OpSqr:     AVS_LANES(a[l] * a[l])
+        case OpInvSqrt: AVS_LANES(invSqrt(a[l]))
+        case OpExp:     AVS_LANES(expf(a[l]))
+        case OpLog:     AVS_LANES(logf(a[l]))
+        case OpLog10:   AVS_LANES(log10f(a[l]))
+        case OpAbs:     AVS_LANES(fabsf(a[l]))
+        case OpSign:    AVS_LANES(sign(a[l]))
+        case OpMin:     AVS_LANES(std::min(a[l], b[l]))
+        case OpMax:     AVS_LANES(std::max(a[l], b[l]))
+        case OpFloor:   AVS_LANES(floorf(a[l]))
+        case OpCeil:    AVS_LANES(ceilf(a[l]))
+        case OpSelect:  AVS_LANES(a[l] != 0.0f ? b[l] : c[l])
+
+        case OpRand:
+            for (int l = 0; l < count; l++) {
+                m_rng ^= m_rng << 13;
+                m_rng ^= m_rng >> 17;
+                m_rng ^= m_rng << 5;
+                int range = std::max(1, static_cast<int>(a[l]));
+                d[l] = static_cast<float>(m_rng % range);
+            }
+            break;
+
+        case OpGetOsc:
+            for (int l = 0; l < count; l++) {
+                if (!m_audio) {
+                    d[l] = 0.0f;
+                    continue;
+                }
+                int ch = static_cast<int>(c[l]);
+                const float *wave = ch == 1 ? m_audio->waveformLeft
+                                  : ch == 2 ? m_audio->waveformRight
+                                            : m_audio->waveformMono;
+                d[l] = sampleBand(wave, AVS_WAVEFORM_SIZE, a[l], b[l]);
+            }
+            break;
+
+        case OpGetSpec:
+            for (int l = 0; l < count; l++) {
+                d[l] = m_audio ? sampleBand(m_audio->spectrumMono, AVS_SPECTRUM_SIZE, a[l], b[l])
+                               : 0.0f;
+            }
+            break;
+        }
+#undef AVS_LANES
+    }
+}
@@ -0,0 +1,91 @@
+#ifndef AVSSCRIPT_H
+#define AVSSCRIPT_H
+
+#include <QString>
+#include <QHash>
+#include <cstdint>
+#include <vector>
+
+class AvsAudioData;
+
+// Small EEL-style expression language for scripted effects (SuperScope,
+// Dynamic Movement). Code is parsed once, constant-folded and compiled to a
+// register bytecode; every instruction runs over a batch of lanes so per-point
+// and per-pixel code is evaluated for many points per dispatch.
+//
+// Syntax: statements separated by ';', assignment (= += -= *= /= %=),
+// + - * / % ^ (pow), comparisons, && || !, parentheses, // and /* */
+// comments, $pi $e $phi. Functions: sin cos tan asin acos atan atan2 sqrt sqr
+// invsqrt pow exp log log10 abs sign min max floor ceil equal above below
+// band bor bnot rand if assign getosc getspec. Variable names are
+// case-insensitive and start at 0. if(c, a, b) only applies the assignments
+// of the branch that is taken.
+class AvsScript
+{
+public:
+    struct Instr {
+        uint8_t op;
+        int32_t dst;
+        int32_t a;
+        int32_t b;
+        int32_t c;
+    };
+
+    struct Program {
+        std::vector<Instr> code;
+        // A variable is read before this program writes it, so each point
+        // depends on the previous one and batching would change the result
+        bool carriesState = false;
+        bool isEmpty() const { return code.empty(); }
+    };
+
+    static constexpr int BATCH = 64;
+
+    AvsScript();
+
+    // Slot of a named variable, created on first use
+    int variable(const QString &name);
+    float &value(int slot) { return m_values[slot]; }
+    // The host resets this variable before every evaluation (skip in
+    // SuperScope), so reading it first does not carry state between points
+    void setTransient(int slot) { m_persistent[slot] = false; }
+
+    // On failure returns false, leaves out empty and describes the problem
+    bool compile(const QString &source, Program &out, QString *error = nullptr);
+
+    void setAudio(const AvsAudioData *audio) { m_audio = audio; }
+    void run(const Program &program);
+
+    // Batched evaluation of a program that does not carry state:
+    // beginBatch() broadcasts the current values to every lane once, then
+    // for each chunk fill the input lanes, runBatch() and read the output
+    // lanes. endBatch() keeps the values of the last evaluated lane.
+    void beginBatch();
+    float *lanes(int slot) { return &m_batch[static_cast<size_t>(slot) * BATCH]; }
+    void runBatch(const Program &program, int count);
+    void endBatch(int lastLane);
+
+    size_t memoryUsage() const { return (m_values.size() + m_batch.size()) * sizeof(float); }
+
+private:
+    struct Node;
+    class Parser;
+    class CodeGen;
+
+    static void foldConstants(Node &n);
+
+    void execute(const Program &program, float *regs, int stride, int count);
+    int constant(float v);
+    int newSlot(float initial);
+
+    std::vector<float> m_values;
+    std::vector<float> m_batch;
+    std::vector<bool> m_persistent; // named variables that keep their value between runs
+    QHash<QString, int> m_variables;
+    QHash<uint32_t, int> m_constants; // keyed by bit pattern
+    std::vector<int> m_temps;
+    const AvsAudioData *m_audio = nullptr;
+    uint32_t m_rng = 0x2545F491u;
+};
+
+#endif // AVSSCRIPT_H
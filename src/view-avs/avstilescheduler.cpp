@@ -0,0 +1,105 @@
+#include "avstilescheduler.h"
+#include <QThread>
+#include <algorithm>
+
+AvsTileScheduler::AvsTileScheduler(int threads)
+{
+    setThreadCount(threads);
+}
+
+AvsTileScheduler::~AvsTileScheduler()
+{
+    stopWorkers();
+}
+
+void AvsTileScheduler::setThreadCount(int threads)
+{
+    if (threads <= 0)
+        threads = QThread::idealThreadCount();
+    threads = std::clamp(threads, 1, MAX_THREADS);
+    if (threads == threadCount())
+        return;
+
+    stopWorkers();
+    m_quit = false;
+    // Workers start from the current generation so one that is slow to get
+    // going still picks up the first job
+    unsigned generation = m_generation;
+    for (int i = 1; i < threads; i++) {
+        QThread *t = QThread::create([this, generation]() { workerLoop(generation); });
+        t->setObjectName(QStringLiteral("avs-tile-%1").arg(i));
+        t->start();
+        m_workers.push_back(t);
+    }
+}
+
+void AvsTileScheduler::stopWorkers()
+{
+    {
+        QMutexLocker l(&m_mutex);
+        m_quit = true;
+        m_wake.wakeAll();
+    }
+    for (QThread *t : m_workers) {
+        t->wait();
+        delete t;
+    }
+    m_workers.clear();
+}
+
+void AvsTileScheduler::run(int height, int bandRows, const std::function<void(int, int)> &fn)
+{
+    int bands = (height + bandRows - 1) / bandRows;
+    if (m_workers.empty() || bands <= 1) {
+        for (int y0 = 0; y0 < height; y0 += bandRows)
+            fn(y0, std::min(height, y0 + bandRows));
+        return;
+    }
+
+    {
+        QMutexLocker l(&m_mutex);
+        m_job = &fn;
+        m_height = height;
+        m_bandRows = bandRows;
+        m_bands = bands;
+        m_nextBand.store(0, std::memory_order_relaxed);
+        m_pending = static_cast<int>(m_workers.size());
+        m_generation++;
+        m_wake.wakeAll();
+    }
+
+    takeBands();
+
+    QMutexLocker l(&m_mutex);
+    while (m_pending > 0)
+        m_done.wait(&m_mutex);
+    m_job = nullptr;
+}
+
+void AvsTileScheduler::takeBands()
+{
+    int band;
+    while ((band = m_nextBand.fetch_add(1, std::memory_order_relaxed)) < m_bands) {
+        int y0 = band * m_bandRows;
+        (*m_job)(y0, std::min(m_height, y0 + m_bandRows));
+    }
+}
+
+void AvsTileScheduler::workerLoop(unsigned seen)
+{
+    for (;;) {
+        QMutexLocker l(&m_mutex);
+        while (!m_quit && m_generation == seen)
+            m_wake.wait(&m_mutex);
+        if (m_quit)
+            return;
+        seen = m_generation;
+        l.unlock();
+
+        takeBands();
+
+        l.relock();
+        if (--m_pending == 0)
+            m_done.wakeAll();
+    }
+}
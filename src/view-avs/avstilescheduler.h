@@ -0,0 +1,54 @@
+#ifndef AVSTILESCHEDULER_H
+#define AVSTILESCHEDULER_H
+
+#include <QMutex>
+#include <QWaitCondition>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+class QThread;
+
+// Small persistent worker pool that runs a function over the row bands of a
+// frame. The calling thread takes bands as well, so a count of 1 has no
+// workers and runs everything inline. Workers sleep between jobs; a job is
+// a handful of wake-ups, cheap enough to issue several times per frame.
+class AvsTileScheduler
+{
+public:
+    static constexpr int MAX_THREADS = 4;
+
+    // threads includes the caller; 0 picks the core count, up to MAX_THREADS
+    explicit AvsTileScheduler(int threads = 0);
+    ~AvsTileScheduler();
+
+    void setThreadCount(int threads);
+    int threadCount() const { return static_cast<int>(m_workers.size()) + 1; }
+
+    // Calls fn(y0, y1) for each band of up to bandRows rows of [0, height),
+    // spread over the threads, and returns once every band is done. Bands
+    // may run in any order and at the same time.
+    void run(int height, int bandRows, const std::function<void(int, int)> &fn);
+
+private:
+    void workerLoop(unsigned seen);
+    void takeBands();
+    void stopWorkers();
+
+    std::vector<QThread *> m_workers;
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    QWaitCondition m_done;
+    bool m_quit = false;
+    unsigned m_generation = 0; // bumped for every job
+    int m_pending = 0;         // workers still on the current job
+
+    // The current job; written under m_mutex before the workers are woken
+    const std::function<void(int, int)> *m_job = nullptr;
+    int m_height = 0;
+    int m_bandRows = 0;
+    int m_bands = 0;
+    std::atomic<int> m_nextBand{0};
+};
+
+#endif // AVSTILESCHEDULER_H
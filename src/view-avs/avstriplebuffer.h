@@ -0,0 +1,48 @@
+#ifndef AVSTRIPLEBUFFER_H
+#define AVSTRIPLEBUFFER_H
+
+#include <atomic>
+
+// Lock-free hand-over of the latest value from one producer thread to one
+// consumer thread. Each side owns one of three slots and the third sits in
+// between: the producer fills writeSlot() and publish()es it, swapping it
+// into the middle; the consumer's fetch() swaps the middle slot in if it
+// holds something new. Neither side ever waits, and a slow consumer simply
+// skips the values it had no time for.
+template <typename T>
+class AvsTripleBuffer
+{
+public:
+    // Producer side. The slot keeps whatever it held two publishes ago.
+    T &writeSlot() { return m_slots[m_write]; }
+    // Returns true if the value it replaces in the middle was never fetched
+    bool publish()
+    {
+        int previous = m_middle.exchange(m_write | FRESH, std::memory_order_acq_rel);
+        m_write = previous & INDEX;
+        return (previous & FRESH) != 0;
+    }
+
+    // Consumer side. Returns false, keeping the current slot, when nothing
+    // was published since the last fetch.
+    bool fetch()
+    {
+        if ((m_middle.load(std::memory_order_relaxed) & FRESH) == 0)
+            return false;
+        int previous = m_middle.exchange(m_read, std::memory_order_acq_rel);
+        m_read = previous & INDEX;
+        return true;
+    }
+    const T &readSlot() const { return m_slots[m_read]; }
+
+private:
+    static constexpr int INDEX = 3;
+    static constexpr int FRESH = 4;
+
+    T m_slots[3];
+    int m_write = 0;
+    int m_read = 1;
+    std::atomic<int> m_middle{2};
+};
+
+#endif // AVSTRIPLEBUFFER_H
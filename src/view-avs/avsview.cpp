@@ -1,7 +1,10 @@
 #include "avsview.h"
+#include "framescheduler.h"
 #include <QPainter>
 #include <QMouseEvent>
 #include <QKeyEvent>
+#include <QSettings>
+#include <algorithm>
 
 AvsView::AvsView(QWidget *parent)
     : QWidget(parent)
@@ -11,31 +14,48 @@ AvsView::AvsView(QWidget *parent)
     QPalette pal = palette();
     pal.setColor(QPalette::Window, Qt::black);
     setPalette(pal);
+    // Every paint covers the whole widget
+    setAttribute(Qt::WA_OpaquePaintEvent);
 
     // Make sure we can receive key events
     setFocusPolicy(Qt::StrongFocus);
 
-    // Render timer at ~30 FPS
-    m_renderTimer = new QTimer(this);
-    m_renderTimer->setInterval(33);
-    connect(m_renderTimer, &QTimer::timeout, this, QOverload<>::of(&QWidget::update));
+    // Frames are rendered on their own thread at ~30 FPS and painted on
+    // the next frame tick after they arrive
+    m_renderer = new AvsRenderThread(this);
+    m_renderer->setObjectName("avs-render");
+    // Split tile-safe effects across cores; 0 = one thread per core
+    m_renderer->engine().setRenderThreads(QSettings().value("avs/renderThreads", 0).toInt());
+    m_presetName = m_renderer->status().presetName;
+    connect(m_renderer, &AvsRenderThread::frameReady, this, [this]() {
+        m_frameWaiting.store(true, std::memory_order_relaxed);
+    }, Qt::DirectConnection);
+    FrameScheduler::instance().subscribe(this, "avs", AvsRenderThread::FRAME_INTERVAL_US, [this]() {
+        if (m_frameWaiting.exchange(false, std::memory_order_relaxed))
+            update();
+    });
+    FrameScheduler::instance().setActive(this, false);
+    connect(m_renderer, &AvsRenderThread::presetChanged, this, &AvsView::onPresetChanged);
 
     // Auto-cycle timer
     m_autoCycleTimer = new QTimer(this);
     m_autoCycleTimer->setInterval(AUTO_CYCLE_INTERVAL_MS);
     connect(m_autoCycleTimer, &QTimer::timeout, this, [this]() {
-        m_engine.nextPreset();
-        onPresetChanged();
+        m_renderer->stepPreset(1);
     });
 }
 
 AvsView::~AvsView()
 {
+    m_renderer->stop();
 }
 
 void AvsView::setAudioData(const QByteArray &data, QAudioFormat format)
 {
+    // Analysis stays here so no chunk is skipped; only the result crosses
     m_audioData.processFromPcm(data, format);
+    m_renderer->audio().writeSlot() = m_audioData;
+    m_renderer->audio().publish();
 }
 
 void AvsView::setMetadata(QMediaMetaData metadata)
@@ -57,21 +77,34 @@ void AvsView::setMetadata(QMediaMetaData metadata)
 void AvsView::start()
 {
     m_running = true;
-    m_renderTimer->start();
+    m_renderer->start();
     if (m_autoCycleEnabled)
         m_autoCycleTimer->start();
+    FrameScheduler::instance().setActive(this, true);
     setFocus();
 }
 
 void AvsView::stop()
 {
     m_running = false;
-    m_renderTimer->stop();
+    m_renderer->stop();
     m_autoCycleTimer->stop();
+    FrameScheduler::instance().setActive(this, false);
+}
+
+void AvsView::setFrameRateCap(int fps)
+{
+    m_renderer->setFrameRateCap(fps);
+    // Frames can't come faster than the renderer makes them
+    int intervalUs = AvsRenderThread::FRAME_INTERVAL_US;
+    if (fps > 0)
+        intervalUs = std::max(intervalUs, 1000000 / fps);
+    FrameScheduler::instance().setInterval(this, intervalUs);
 }
 
-void AvsView::onPresetChanged()
+void AvsView::onPresetChanged(const QString &name)
 {
+    m_presetName = name;
     m_showPresetName = true;
     m_presetNameTimer.restart();
 
@@ -80,16 +113,32 @@ void AvsView::onPresetChanged()
         m_autoCycleTimer->start();
 }
 
+QImage AvsView::lastFrame()
+{
+    // Still the last one shown after stop()
+    m_renderer->frames().fetch();
+    return m_renderer->frames().readSlot();
+}
+
 void AvsView::paintEvent(QPaintEvent *)
 {
+    FrameScheduler::PaintTimer timed(this);
     QPainter painter(this);
 
     if (m_running) {
-        const QImage &frame = m_engine.renderFrame(m_audioData);
+        // Only the newest finished frame; ones that came in between are skipped
+        m_renderer->frames().fetch();
+        const QImage &frame = m_renderer->frames().readSlot();
 
-        // Disable smooth scaling for nearest-neighbor retro look
+        // Frames arrive scaled to the widget; one rendered before a resize
+        // is stretched, nearest-neighbour for the retro look
         painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
-        painter.drawImage(rect(), frame);
+        if (frame.isNull())
+            painter.fillRect(rect(), Qt::black); // first frame not out yet
+        else if (frame.size() == size())
+            painter.drawImage(QPoint(0, 0), frame);
+        else
+            painter.drawImage(rect(), frame);
 
         // Draw preset name OSD (top-left)
         if (m_showPresetName && m_presetNameTimer.isValid()) {
@@ -109,7 +158,7 @@ void AvsView::paintEvent(QPaintEvent *)
                 font.setBold(true);
                 painter.setFont(font);
 
-                QString text = m_engine.presetName();
+                QString text = m_presetName;
                 QRect textRect = rect().adjusted(8, 8, -8, -8);
 
                 // Shadow
@@ -162,6 +211,33 @@ void AvsView::paintEvent(QPaintEvent *)
     }
 }
 
+void AvsView::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    m_renderer->setOutputSize(size());
+}
+
+void AvsView::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    if (m_running && !m_renderer->isRunning()) {
+        m_renderer->start();
+        if (m_autoCycleEnabled)
+            m_autoCycleTimer->start();
+    }
+}
+
+void AvsView::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+    // Covered by another view without being stopped, e.g. by the
+    // screensaver; no point rendering frames nobody sees
+    if (m_running) {
+        m_renderer->stop();
+        m_autoCycleTimer->stop();
+    }
+}
+
 void AvsView::mousePressEvent(QMouseEvent *event)
 {
     m_pressPos = event->pos();
@@ -182,11 +258,10 @@ void AvsView::mouseReleaseEvent(QMouseEvent *event)
     if (m_swiping) {
         int dx = event->pos().x() - m_pressPos.x();
         if (dx > 0) {
-            m_engine.prevPreset(); // swipe right = previous
+            m_renderer->stepPreset(-1); // swipe right = previous
         } else {
-            m_engine.nextPreset(); // swipe left = next
+            m_renderer->stepPreset(1); // swipe left = next
         }
-        onPresetChanged();
     } else {
         // Tap = exit
         emit userActivityDetected();
@@ -197,12 +272,10 @@ void AvsView::keyPressEvent(QKeyEvent *event)
 {
     switch (event->key()) {
     case Qt::Key_Right:
-        m_engine.nextPreset();
-        onPresetChanged();
+        m_renderer->stepPreset(1);
         break;
     case Qt::Key_Left:
-        m_engine.prevPreset();
-        onPresetChanged();
+        m_renderer->stepPreset(-1);
         break;
     case Qt::Key_Up:
         m_autoCycleEnabled = true;
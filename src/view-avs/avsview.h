@@ -6,7 +6,8 @@
 #include <QAudioFormat>
 #include <QElapsedTimer>
 #include <QMediaMetaData>
-#include "avsengine.h"
+#include <atomic>
+#include "avsrenderthread.h"
 #include "avsaudiodata.h"
 
 class AvsView : public QWidget
@@ -17,35 +18,46 @@ public:
     explicit AvsView(QWidget *parent = nullptr);
     ~AvsView();
 
+    AvsRenderThread::Status renderStatus() const { return m_renderer->status(); }
+    QString presetName() const { return m_renderer->status().presetName; }
+    // Newest finished frame, without the OSD; null before the first one
+    QImage lastFrame();
+
 public slots:
     void setAudioData(const QByteArray &data, QAudioFormat format);
     void setMetadata(QMediaMetaData metadata);
     void start();
     void stop();
+    void setFrameRateCap(int fps); // thermal limit, 0 = none
 
 signals:
     void userActivityDetected();
 
 protected:
     void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
     void mouseMoveEvent(QMouseEvent *event) override;
     void mouseReleaseEvent(QMouseEvent *event) override;
     void keyPressEvent(QKeyEvent *event) override;
 
 private:
-    void onPresetChanged();
+    void onPresetChanged(const QString &name);
 
-    AvsEngine m_engine;
-    AvsAudioData m_audioData;
-    QTimer *m_renderTimer = nullptr;
+    AvsRenderThread *m_renderer = nullptr;
+    AvsAudioData m_audioData; // analysis state; each result is handed to the renderer
     bool m_running = false;
+    // Set by the render thread, taken by the next frame tick
+    std::atomic<bool> m_frameWaiting{false};
 
     // Swipe gesture tracking
     QPoint m_pressPos;
     bool m_swiping = false;
 
     // Preset name OSD
+    QString m_presetName;
     QElapsedTimer m_presetNameTimer;
     bool m_showPresetName = false;
     static constexpr int PRESET_NAME_DURATION_MS = 2000;
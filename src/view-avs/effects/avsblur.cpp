@@ -1,42 +1,64 @@
 #include "avsblur.h"
 #include "avsaudiodata.h"
+#include "avsframebuffer.h"
+#include "avsframebufferpool.h"
+#include "pixelkernels.h"
+#include "qualitygovernor.h"
 #include <algorithm>
 
 AvsBlur::AvsBlur(int passes)
     : passes(passes)
-    , m_temp(AVS_FB_WIDTH, AVS_FB_HEIGHT)
 {
 }
 
+int AvsBlur::activePasses() const
+{
+    return qualityLevel >= QualityGovernor::FewerPasses ? std::min(passes, 1) : passes;
+}
+
 void AvsBlur::render(AvsFramebuffer &fb, const AvsAudioData &)
 {
-    int w = fb.width();
-    int h = fb.height();
-
-    for (int p = 0; p < passes; ++p) {
-        m_temp.copyFrom(fb);
-        const uint32_t *src = m_temp.pixels();
-        uint32_t *dst = fb.pixels();
-
-        // Skip edge pixels (border row/col)
-        for (int y = 1; y < h - 1; ++y) {
-            for (int x = 1; x < w - 1; ++x) {
-                uint32_t sumR = 0, sumG = 0, sumB = 0;
-
-                for (int dy = -1; dy <= 1; ++dy) {
-                    for (int dx = -1; dx <= 1; ++dx) {
-                        uint32_t px = src[(y + dy) * w + (x + dx)];
-                        sumR += (px >> 16) & 0xFF;
-                        sumG += (px >> 8) & 0xFF;
-                        sumB += px & 0xFF;
-                    }
-                }
-
-                uint32_t r = sumR / 9;
-                uint32_t g = sumG / 9;
-                uint32_t b = sumB / 9;
-                dst[y * w + x] = 0xFF000000 | (r << 16) | (g << 8) | b;
-            }
-        }
+    const int count = activePasses();
+    for (int p = 0; p < count; ++p) {
+        AvsFramebuffer &out = pool->scratch();
+        // Edge pixels are not blurred; the kernel carries them over unchanged
+        PixelKernels::blur3x3(fb.pixels(), out.pixels(), fb.width(), fb.height());
+        fb.swap(out);
+    }
+}
+
+void AvsBlur::renderTile(const uint32_t *src, uint32_t *dst, int width, int height,
+                         int y0, int y1)
+{
+    for (int y = y0; y < y1; y++) {
+        const uint32_t *row = src + y * width;
+        if (y == 0 || y == height - 1)
+            std::copy(row, row + width, dst + y * width);
+        else
+            PixelKernels::blurRow3x3(row - width, row, row + width, dst + y * width, width);
+    }
+}
+
+void AvsBlur::renderRows(uint32_t *px, int width, int height, int y0, int y1, const uint32_t *above)
+{
+    // In place, so keep the unblurred row above and the current row aside
+    m_rowCopies.resize(static_cast<size_t>(width) * 2);
+    uint32_t *prev = m_rowCopies.data();
+    uint32_t *cur = prev + width;
+
+    // The first and last rows are border and stay as they are
+    int first = std::max(y0, 1);
+    int last = std::min(y1, height - 1);
+    if (first >= last)
+        return;
+
+    const uint32_t *rowAbove = (first == y0) ? above : px + (first - 1) * width;
+    std::copy(rowAbove, rowAbove + width, prev);
+
+    for (int y = first; y < last; y++) {
+        uint32_t *row = px + y * width;
+        std::copy(row, row + width, cur);
+        PixelKernels::blurRow3x3(prev, cur, row + width, row, width);
+        std::swap(prev, cur);
     }
 }
@@ -2,7 +2,7 @@
 #define AVSBLUR_H
 
 #include "avseffect.h"
-#include "avsframebuffer.h"
+#include <vector>
 
 class AvsBlur : public AvsEffect
 {
@@ -11,11 +11,21 @@ public:
 
     void render(AvsFramebuffer &fb, const AvsAudioData &audio) override;
     QString name() const override { return "Blur"; }
+    // Only a single pass fits the one-row halo of a fused band
+    Access access() const override { return activePasses() == 1 ? Access::Stencil3x3 : Access::Frame; }
+    void renderRows(uint32_t *px, int width, int height, int y0, int y1,
+                    const uint32_t *above) override;
+    bool tileSafe() const override { return activePasses() == 1; }
+    void renderTile(const uint32_t *src, uint32_t *dst, int width, int height,
+                    int y0, int y1) override;
 
     int passes;
 
 private:
-    AvsFramebuffer m_temp;
+    // One pass from QualityGovernor::FewerPasses on
+    int activePasses() const;
+
+    std::vector<uint32_t> m_rowCopies; // pre-blur copies of two rows
 };
 
 #endif // AVSBLUR_H
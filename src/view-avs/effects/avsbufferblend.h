@@ -2,20 +2,21 @@
 #define AVSBUFFERBLEND_H
 
 #include "avseffect.h"
-#include "avsframebuffer.h"
 
 class AvsBufferBlend : public AvsEffect
 {
 public:
-    explicit AvsBufferBlend(float blendRatio = 0.7f);
+    // target names the pool buffer holding the echo between frames
+    explicit AvsBufferBlend(float blendRatio = 0.7f, const QString &target = "echo");
 
     void render(AvsFramebuffer &fb, const AvsAudioData &audio) override;
     QString name() const override { return "BufferBlend"; }
+    QStringList renderTargets() const override { return {m_target}; }
 
     float blendRatio;
 
 private:
-    AvsFramebuffer m_accumulator;
+    QString m_target;
     bool m_firstFrame = true;
 };
 
@@ -11,6 +11,7 @@ public:
 
     void render(AvsFramebuffer &fb, const AvsAudioData &audio) override;
     QString name() const override { return "Clear Screen"; }
+    bool readsFrame() const override { return false; }
 
     uint32_t m_color;
 };
@@ -9,55 +9,100 @@ AvsColorModifier::AvsColorModifier(Mode mode)
 {
 }
 
-// HSV helper: convert RGB to HSV
-static void rgbToHsv(int r, int g, int b, float &h, float &s, float &v)
+// Hue rotation works on the HSV hexcone in integers: a pixel's largest and
+// smallest channel stay put, and the channels in between follow the hue
+// along a piecewise-linear ramp. Hue is counted in 256 steps per 60 degrees.
+namespace {
+
+constexpr int HUE_SEXTANT = 256;
+constexpr int HUE_CIRCLE = 6 * HUE_SEXTANT;
+
+// Everything the rotation needs that doesn't depend on the angle, so
+// nothing has to be rebuilt as the hue drifts from frame to frame
+struct HueTables {
+    // Each channel's share of (max - min) at a hue, 0-256
+    uint16_t ramp[HUE_CIRCLE][3];
+    // 65536 / d, rounded, for the hue division
+    int32_t reciprocal[256];
+
+    HueTables()
+    {
+        for (int h = 0; h < HUE_CIRCLE; h++) {
+            uint16_t up = static_cast<uint16_t>(h % HUE_SEXTANT);
+            uint16_t down = static_cast<uint16_t>(HUE_SEXTANT - up);
+            uint16_t full = HUE_SEXTANT;
+            uint16_t *w = ramp[h];
+            switch (h / HUE_SEXTANT) {
+            case 0:  w[0] = full; w[1] = up;   w[2] = 0;    break; // red to yellow
+            case 1:  w[0] = down; w[1] = full; w[2] = 0;    break; // yellow to green
+            case 2:  w[0] = 0;    w[1] = full; w[2] = up;   break; // green to cyan
+            case 3:  w[0] = 0;    w[1] = down; w[2] = full; break; // cyan to blue
+            case 4:  w[0] = up;   w[1] = 0;    w[2] = full; break; // blue to magenta
+            default: w[0] = full; w[1] = 0;    w[2] = down; break; // magenta to red
+            }
+        }
+        reciprocal[0] = 0;
+        for (int d = 1; d < 256; d++)
+            reciprocal[d] = (65536 + d / 2) / d;
+    }
+};
+
+const HueTables &hueTables()
+{
+    static const HueTables tables;
+    return tables;
+}
+
+} // namespace
+
+void AvsColorModifier::render(AvsFramebuffer &fb, const AvsAudioData &audio)
 {
-    float rf = r / 255.0f, gf = g / 255.0f, bf = b / 255.0f;
-    float maxc = std::max({rf, gf, bf});
-    float minc = std::min({rf, gf, bf});
-    float delta = maxc - minc;
-    v = maxc;
-    s = (maxc > 0.0f) ? delta / maxc : 0.0f;
-    if (delta < 0.0001f) {
-        h = 0.0f;
-    } else if (maxc == rf) {
-        h = 60.0f * fmodf((gf - bf) / delta + 6.0f, 6.0f);
-    } else if (maxc == gf) {
-        h = 60.0f * ((bf - rf) / delta + 2.0f);
-    } else {
-        h = 60.0f * ((rf - gf) / delta + 4.0f);
+    beginFrame(fb, audio);
+    renderRows(fb.pixels(), fb.width(), fb.height(), 0, fb.height(), nullptr);
+}
+
+void AvsColorModifier::beginFrame(AvsFramebuffer &, const AvsAudioData &)
+{
+    if (m_mode == HueShift) {
+        m_hueOffset = fmodf(m_hueOffset + 3.0f, 360.0f);
+        m_hueSteps = static_cast<int>(lroundf(m_hueOffset * HUE_SEXTANT / 60.0f)) % HUE_CIRCLE;
     }
+    if (m_mode != m_lutMode)
+        buildChannelLut();
 }
 
-// HSV helper: convert HSV to RGB
-static void hsvToRgb(float h, float s, float v, int &r, int &g, int &b)
+// Modes that treat each channel on its own become one table per channel,
+// rebuilt only when the mode changes. Invert stays a single XOR, which is
+// cheaper than any lookup.
+void AvsColorModifier::buildChannelLut()
 {
-    float c = v * s;
-    float x = c * (1.0f - fabsf(fmodf(h / 60.0f, 2.0f) - 1.0f));
-    float m = v - c;
-    float rf, gf, bf;
-    if (h < 60)      { rf = c; gf = x; bf = 0; }
-    else if (h < 120) { rf = x; gf = c; bf = 0; }
-    else if (h < 180) { rf = 0; gf = c; bf = x; }
-    else if (h < 240) { rf = 0; gf = x; bf = c; }
-    else if (h < 300) { rf = x; gf = 0; bf = c; }
-    else              { rf = c; gf = 0; bf = x; }
-    r = static_cast<int>((rf + m) * 255.0f);
-    g = static_cast<int>((gf + m) * 255.0f);
-    b = static_cast<int>((bf + m) * 255.0f);
+    m_lutMode = m_mode;
+    for (int v = 0; v < 256; v++) {
+        uint8_t out = static_cast<uint8_t>(v);
+        if (m_mode == BrightnessBoost)
+            out = static_cast<uint8_t>(std::min(255, v + 8));
+        m_channelLut[0][v] = m_channelLut[1][v] = m_channelLut[2][v] = out;
+    }
 }
 
-void AvsColorModifier::render(AvsFramebuffer &fb, const AvsAudioData &)
+void AvsColorModifier::renderRows(uint32_t *rows, int width, int, int y0, int y1, const uint32_t *)
 {
-    uint32_t *px = fb.pixels();
-    int count = fb.pixelCount();
+    uint32_t *px = rows + y0 * width;
+    int count = (y1 - y0) * width;
 
     switch (m_mode) {
     case Invert:
+        for (int i = 0; i < count; i++)
+            px[i] ^= 0x00FFFFFF;
+        break;
+
+    case BrightnessBoost:
         for (int i = 0; i < count; i++) {
             uint32_t p = px[i];
-            uint32_t a = p & 0xFF000000;
-            px[i] = a | (~p & 0x00FFFFFF);
+            uint32_t r = m_channelLut[0][(p >> 16) & 0xFF];
+            uint32_t g = m_channelLut[1][(p >> 8) & 0xFF];
+            uint32_t b = m_channelLut[2][p & 0xFF];
+            px[i] = (p & 0xFF000000) | (r << 16) | (g << 8) | b;
         }
         break;
 
@@ -72,31 +117,41 @@ void AvsColorModifier::render(AvsFramebuffer &fb, const AvsAudioData &)
         }
         break;
 
-    case HueShift:
-        m_hueOffset = fmodf(m_hueOffset + 3.0f, 360.0f);
+    case HueShift: {
+        const HueTables &t = hueTables();
+        int offset = m_hueSteps;
         for (int i = 0; i < count; i++) {
             uint32_t p = px[i];
             int r = (p >> 16) & 0xFF;
             int g = (p >> 8) & 0xFF;
             int b = p & 0xFF;
-            if (r == 0 && g == 0 && b == 0)
-                continue;
-            float h, s, v;
-            rgbToHsv(r, g, b, h, s, v);
-            h = fmodf(h + m_hueOffset, 360.0f);
-            hsvToRgb(h, s, v, r, g, b);
-            px[i] = (p & 0xFF000000) | (r << 16) | (g << 8) | b;
-        }
-        break;
+            int hi = std::max({r, g, b});
+            int lo = std::min({r, g, b});
+            int d = hi - lo;
+            if (d == 0)
+                continue; // grey has no hue
 
-    case BrightnessBoost:
-        for (int i = 0; i < count; i++) {
-            uint32_t p = px[i];
-            int r = std::min(255, static_cast<int>((p >> 16) & 0xFF) + 8);
-            int g = std::min(255, static_cast<int>((p >> 8) & 0xFF) + 8);
-            int b = std::min(255, static_cast<int>(p & 0xFF) + 8);
+            int inv = t.reciprocal[d];
+            int h;
+            if (hi == r)
+                h = ((g - b) * inv) >> 8;
+            else if (hi == g)
+                h = 2 * HUE_SEXTANT + (((b - r) * inv) >> 8);
+            else
+                h = 4 * HUE_SEXTANT + (((r - g) * inv) >> 8);
+            h += offset;
+            if (h < 0)
+                h += HUE_CIRCLE;
+            else if (h >= HUE_CIRCLE)
+                h -= HUE_CIRCLE;
+
+            const uint16_t *w = t.ramp[h];
+            r = lo + ((d * w[0] + 128) >> 8);
+            g = lo + ((d * w[1] + 128) >> 8);
+            b = lo + ((d * w[2] + 128) >> 8);
             px[i] = (p & 0xFF000000) | (r << 16) | (g << 8) | b;
         }
         break;
     }
+    }
 }
@@ -12,11 +12,21 @@ public:
 
     void render(AvsFramebuffer &fb, const AvsAudioData &audio) override;
     QString name() const override { return "Color Modifier"; }
+    Access access() const override { return Access::Pointwise; }
+    bool tileSafe() const override { return true; }
+    void beginFrame(AvsFramebuffer &fb, const AvsAudioData &audio) override;
+    void renderRows(uint32_t *px, int width, int height, int y0, int y1,
+                    const uint32_t *above) override;
 
     Mode m_mode;
 
 private:
+    void buildChannelLut();
+
     float m_hueOffset = 0.0f;
+    int m_hueSteps = 0;       // m_hueOffset in 1/256ths of 60 degrees
+    int m_lutMode = -1;       // mode m_channelLut was built for
+    uint8_t m_channelLut[3][256];
 };
 
 #endif // AVSCOLORMODIFIER_H
@@ -1,49 +1,280 @@
 #include "avsdynamicmovement.h"
 #include "avsframebuffer.h"
+#include "avsframebufferpool.h"
 #include "avsaudiodata.h"
+#include <QDebug>
+#include <algorithm>
 #include <cmath>
 
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
 AvsDynamicMovement::AvsDynamicMovement(float baseZoom, float beatMultiplier, bool rotate)
-    : m_baseZoom(baseZoom), m_beatMultiplier(beatMultiplier), m_rotate(rotate),
-      m_backBuffer(AVS_FB_WIDTH, AVS_FB_HEIGHT)
+    : m_baseZoom(baseZoom), m_beatMultiplier(beatMultiplier), m_rotate(rotate)
 {
 }
 
-void AvsDynamicMovement::render(AvsFramebuffer &fb, const AvsAudioData &audio)
+AvsDynamicMovement::~AvsDynamicMovement() = default;
+
+void AvsDynamicMovement::setCode(const QString &init, const QString &frame,
+                                 const QString &beat, const QString &pixel)
 {
-    int w = fb.width();
-    int h = fb.height();
-    float cx = w * 0.5f;
-    float cy = h * 0.5f;
+    m_script = std::make_unique<AvsScript>();
+    m_initDone = false;
+
+    m_x = m_script->variable("x");
+    m_y = m_script->variable("y");
+    m_d = m_script->variable("d");
+    m_r = m_script->variable("r");
+    m_b = m_script->variable("b");
+    m_w = m_script->variable("w");
+    m_h = m_script->variable("h");
+
+    // The host fills these in for every pixel
+    for (int slot : {m_x, m_y, m_d, m_r})
+        m_script->setTransient(slot);
+
+    const struct { const QString &source; AvsScript::Program &program; const char *label; } parts[] = {
+        {init, m_initCode, "init"}, {frame, m_frameCode, "frame"},
+        {beat, m_beatCode, "beat"}, {pixel, m_pixelCode, "pixel"},
+    };
+    for (const auto &part : parts) {
+        QString error;
+        if (!m_script->compile(part.source, part.program, &error))
+            qWarning() << "[avs] Dynamic Movement" << part.label << "code:" << error;
+    }
+}
+
+size_t AvsDynamicMovement::memoryUsage() const
+{
+    size_t tables = m_table.capacity() * sizeof(AvsMoveEntry)
+                  + (m_gridX.capacity() + m_gridY.capacity()) * sizeof(int32_t);
+    if (!m_script)
+        return tables;
+    size_t instrs = m_initCode.code.size() + m_frameCode.code.size()
+                  + m_beatCode.code.size() + m_pixelCode.code.size();
+    return instrs * sizeof(AvsScript::Instr) + m_script->memoryUsage() + tables;
+}
+
+void AvsDynamicMovement::beginTransform(const AvsAudioData &audio, int w, int h)
+{
+    m_cx = w * 0.5f;
+    m_cy = h * 0.5f;
+    m_scaleX = 2.0f / (w - 1);
+    m_scaleY = 2.0f / (h - 1);
+
+    if (!isScripted()) {
+        m_zoom = 1.0f + m_baseZoom * (1.0f + audio.beatDecay * m_beatMultiplier);
+        float rot = m_rotate ? 0.01f * audio.beatDecay : 0.0f;
+        m_cosR = cosf(rot);
+        m_sinR = sinf(rot);
+        return;
+    }
+
+    AvsScript &s = *m_script;
+    s.setAudio(&audio);
+    s.value(m_w) = static_cast<float>(w);
+    s.value(m_h) = static_cast<float>(h);
+    s.value(m_b) = audio.isBeat ? 1.0f : 0.0f;
+
+    if (!m_initDone) {
+        s.run(m_initCode);
+        m_initDone = true;
+    }
+    s.run(m_frameCode);
+    if (audio.isBeat)
+        s.run(m_beatCode);
+
+    m_lastLane = -1;
+    if (!m_pixelCode.carriesState)
+        s.beginBatch();
+}
+
+void AvsDynamicMovement::endTransform()
+{
+    if (isScripted() && !m_pixelCode.carriesState)
+        m_script->endBatch(m_lastLane);
+}
+
+void AvsDynamicMovement::transform(float *x, float *y, int count)
+{
+    if (!isScripted()) {
+        for (int i = 0; i < count; i++) {
+            float dx = x[i] - m_cx;
+            float dy = y[i] - m_cy;
+            x[i] = (dx * m_cosR - dy * m_sinR) * m_zoom + m_cx;
+            y[i] = (dx * m_sinR + dy * m_cosR) * m_zoom + m_cy;
+        }
+        return;
+    }
+
+    AvsScript &s = *m_script;
+    const float halfPi = static_cast<float>(M_PI * 0.5);
+
+    // Script coordinates are -1..1; polar mode also provides d and r
+    // (0 = up) and reads the result back from them
+    auto toPixels = [&](float &px, float &py, float sx, float sy, float d, float r) {
+        if (!rectangular) {
+            sx = sinf(r) * d;
+            sy = -cosf(r) * d;
+        }
+        px = (sx + 1.0f) / m_scaleX;
+        py = (sy + 1.0f) / m_scaleY;
+    };
+
+    if (m_pixelCode.carriesState) {
+        for (int i = 0; i < count; i++) {
+            float nx = x[i] * m_scaleX - 1.0f;
+            float ny = y[i] * m_scaleY - 1.0f;
+            s.value(m_x) = nx;
+            s.value(m_y) = ny;
+            if (!rectangular) {
+                s.value(m_d) = sqrtf(nx * nx + ny * ny);
+                s.value(m_r) = atan2f(ny, nx) + halfPi;
+            }
+            s.run(m_pixelCode);
+            toPixels(x[i], y[i], s.value(m_x), s.value(m_y), s.value(m_d), s.value(m_r));
+        }
+        return;
+    }
 
-    float zoom = 1.0f + m_baseZoom * (1.0f + audio.beatDecay * m_beatMultiplier);
-    float rot = m_rotate ? 0.01f * audio.beatDecay : 0.0f;
+    for (int base = 0; base < count; base += AvsScript::BATCH) {
+        int n = std::min(AvsScript::BATCH, count - base);
+        float *lx = s.lanes(m_x), *ly = s.lanes(m_y);
+        float *ld = s.lanes(m_d), *lr = s.lanes(m_r);
+        for (int l = 0; l < n; l++) {
+            lx[l] = x[base + l] * m_scaleX - 1.0f;
+            ly[l] = y[base + l] * m_scaleY - 1.0f;
+            if (!rectangular) {
+                ld[l] = sqrtf(lx[l] * lx[l] + ly[l] * ly[l]);
+                lr[l] = atan2f(ly[l], lx[l]) + halfPi;
+            }
+        }
 
-    float cosR = cosf(rot);
-    float sinR = sinf(rot);
+        s.runBatch(m_pixelCode, n);
 
-    m_backBuffer.copyFrom(fb);
-    const uint32_t *src = m_backBuffer.pixels();
-    uint32_t *dst = fb.pixels();
+        for (int l = 0; l < n; l++)
+            toPixels(x[base + l], y[base + l], lx[l], ly[l], ld[l], lr[l]);
+        m_lastLane = n - 1;
+    }
+}
 
+void AvsDynamicMovement::buildPerPixel(int w, int h)
+{
+    // A row at a time keeps the position buffers small
+    std::vector<float> xs(w), ys(w);
     for (int y = 0; y < h; y++) {
         for (int x = 0; x < w; x++) {
-            float dx = x - cx;
-            float dy = y - cy;
+            xs[x] = static_cast<float>(x);
+            ys[x] = static_cast<float>(y);
+        }
+        transform(xs.data(), ys.data(), w);
+        for (int x = 0; x < w; x++)
+            m_table[y * w + x] = AvsMoveTable::entryFor(xs[x], ys[x], w, h);
+    }
+}
+
+// Far enough outside any frame, and small enough in 16.16 (2^29) that the
+// differences and running sums in buildGrid() stay inside int32
+static constexpr float FIXED_LIMIT = 8192.0f;
+
+static inline int32_t toFixed(float v)
+{
+    // NaN and far-off positions both end up outside the frame
+    if (!(v > -FIXED_LIMIT))
+        return -(static_cast<int32_t>(FIXED_LIMIT) << 16);
+    return static_cast<int32_t>(std::min(v, FIXED_LIMIT) * 65536.0f);
+}
+
+void AvsDynamicMovement::buildGrid(int w, int h, int gw, int gh)
+{
+    // Vertex k of a row sits on pixel column k * w / gw, so the last one is
+    // one past the right edge and every cell is at least a pixel wide
+    int vw = gw + 1;
+    int vh = gh + 1;
+    std::vector<float> xs(vw * vh), ys(vw * vh);
+    for (int j = 0; j < vh; j++) {
+        for (int k = 0; k < vw; k++) {
+            xs[j * vw + k] = static_cast<float>(k * w / gw);
+            ys[j * vw + k] = static_cast<float>(j * h / gh);
+        }
+    }
+    transform(xs.data(), ys.data(), vw * vh);
+
+    m_gridX.resize(vw * vh);
+    m_gridY.resize(vw * vh);
+    for (int i = 0; i < vw * vh; i++) {
+        m_gridX[i] = toFixed(xs[i]);
+        m_gridY[i] = toFixed(ys[i]);
+    }
 
-            // Apply zoom and rotation
-            float rx = (dx * cosR - dy * sinR) * zoom;
-            float ry = (dx * sinR + dy * cosR) * zoom;
+    // Bilinear across each cell: step both edges down a row at a time, then
+    // step across the row between them, all in 16.16
+    for (int j = 0; j < gh; j++) {
+        int y0 = j * h / gh;
+        int y1 = (j + 1) * h / gh;
+        int cellH = y1 - y0;
 
-            int srcX = static_cast<int>(rx + cx);
-            int srcY = static_cast<int>(ry + cy);
+        for (int k = 0; k < gw; k++) {
+            int x0 = k * w / gw;
+            int x1 = (k + 1) * w / gw;
+            int cellW = x1 - x0;
 
-            int idx = y * w + x;
-            if (srcX >= 0 && srcX < w && srcY >= 0 && srcY < h) {
-                dst[idx] = src[srcY * w + srcX];
-            } else {
-                dst[idx] = 0xFF000000;
+            int tl = j * vw + k;
+            int bl = tl + vw;
+            int32_t lx = m_gridX[tl], ly = m_gridY[tl];
+            int32_t rx = m_gridX[tl + 1], ry = m_gridY[tl + 1];
+            int32_t lxStep = (m_gridX[bl] - lx) / cellH;
+            int32_t lyStep = (m_gridY[bl] - ly) / cellH;
+            int32_t rxStep = (m_gridX[bl + 1] - rx) / cellH;
+            int32_t ryStep = (m_gridY[bl + 1] - ry) / cellH;
+
+            for (int y = y0; y < y1; y++) {
+                int32_t px = lx, py = ly;
+                int32_t pxStep = (rx - lx) / cellW;
+                int32_t pyStep = (ry - ly) / cellW;
+                AvsMoveEntry *row = &m_table[y * w];
+                for (int x = x0; x < x1; x++) {
+                    row[x] = AvsMoveTable::entryForFixed(px, py, w, h);
+                    px += pxStep;
+                    py += pyStep;
+                }
+                lx += lxStep;
+                ly += lyStep;
+                rx += rxStep;
+                ry += ryStep;
             }
         }
     }
 }
+
+void AvsDynamicMovement::render(AvsFramebuffer &fb, const AvsAudioData &audio)
+{
+    beginFrame(fb, audio);
+    AvsFramebuffer &out = pool->scratch();
+    renderTile(fb.pixels(), out.pixels(), fb.width(), fb.height(), 0, fb.height());
+    fb.swap(out);
+}
+
+void AvsDynamicMovement::beginFrame(AvsFramebuffer &fb, const AvsAudioData &audio)
+{
+    int w = fb.width();
+    int h = fb.height();
+    m_table.resize(static_cast<size_t>(w) * h);
+
+    beginTransform(audio, w, h);
+    if (gridWidth > 0 && gridHeight > 0)
+        buildGrid(w, h, std::min(gridWidth, w), std::min(gridHeight, h));
+    else
+        buildPerPixel(w, h);
+    endTransform();
+}
+
+void AvsDynamicMovement::renderTile(const uint32_t *src, uint32_t *dst, int width, int,
+                                    int y0, int y1)
+{
+    size_t offset = static_cast<size_t>(y0) * width;
+    AvsMoveTable::apply(src, dst + offset, m_table.data() + offset,
+                        (y1 - y0) * width, width, bilinear);
+}
@@ -2,22 +2,73 @@
 #define AVSDYNAMICMOVEMENT_H
 
 #include "avseffect.h"
-#include "avsframebuffer.h"
+#include "avsmovetable.h"
+#include "avsscript.h"
+#include <memory>
+#include <vector>
 
 class AvsDynamicMovement : public AvsEffect
 {
 public:
     explicit AvsDynamicMovement(float baseZoom = 0.01f, float beatMultiplier = 3.0f, bool rotate = true);
+    ~AvsDynamicMovement() override;
 
     void render(AvsFramebuffer &fb, const AvsAudioData &audio) override;
     QString name() const override { return "Dynamic Movement"; }
+    size_t memoryUsage() const override;
+
+    // Scripted displacement in AVS Dynamic Movement terms; replaces the
+    // zoom/rotate transform when pixel code is set. Pixel code sees x/y
+    // (-1..1) and, unless rectangular, d (distance from centre) and r
+    // (angle, 0 = up); it moves them to the source position. Frame/beat/init
+    // code also sees b, w, h. Code that fails to compile is logged and left
+    // empty.
+    void setCode(const QString &init, const QString &frame,
+                 const QString &beat, const QString &pixel);
+    bool isScripted() const { return !m_pixelCode.isEmpty(); }
+
+    // The scripts and the displacement table run in beginFrame(); only the
+    // resampling is tiled
+    bool tileSafe() const override { return true; }
+    void beginFrame(AvsFramebuffer &fb, const AvsAudioData &audio) override;
+    void renderTile(const uint32_t *src, uint32_t *dst, int width, int height,
+                    int y0, int y1) override;
 
     float m_baseZoom;
     float m_beatMultiplier;
     bool m_rotate;
+    bool rectangular = false;
+    bool bilinear = true;
+
+    // The transform is evaluated on the corners of a gridWidth x gridHeight
+    // grid of cells and interpolated across each cell, like classic AVS.
+    // 0 in either evaluates every pixel, for presets whose displacement
+    // changes too sharply for the grid.
+    int gridWidth = 16;
+    int gridHeight = 12;
 
 private:
-    AvsFramebuffer m_backBuffer;
+    void beginTransform(const AvsAudioData &audio, int w, int h);
+    void endTransform();
+    // Destination pixel positions in, source pixel positions out
+    void transform(float *x, float *y, int count);
+    void buildPerPixel(int w, int h);
+    void buildGrid(int w, int h, int gw, int gh);
+
+    std::unique_ptr<AvsScript> m_script;
+    AvsScript::Program m_initCode, m_frameCode, m_beatCode, m_pixelCode;
+    bool m_initDone = false;
+    int m_x = 0, m_y = 0, m_d = 0, m_r = 0, m_b = 0, m_w = 0, m_h = 0;
+    int m_lastLane = -1;
+
+    // Per-frame transform state: pixel to -1..1 scale for scripts, or the
+    // built-in zoom/rotation about the centre
+    float m_scaleX = 1.0f, m_scaleY = 1.0f;
+    float m_cx = 0.0f, m_cy = 0.0f;
+    float m_zoom = 1.0f, m_cosR = 1.0f, m_sinR = 0.0f;
+
+    std::vector<int32_t> m_gridX, m_gridY; // 16.16 source position per vertex
+    std::vector<AvsMoveEntry> m_table;
 };
 
 #endif // AVSDYNAMICMOVEMENT_H
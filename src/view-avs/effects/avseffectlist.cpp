@@ -0,0 +1,142 @@
+#include "avseffectlist.h"
+#include "avsframebuffer.h"
+#include "avsframebufferpool.h"
+#include "pixelkernels.h"
+#include <algorithm>
+#include <cstdint>
+
+// Frames are opaque, so blending alpha like the colour channels keeps it at 0xFF
+static void blendInto(uint32_t *dst, const uint32_t *src, int count, AvsEffectList::BlendMode mode)
+{
+    switch (mode) {
+    case AvsEffectList::Ignore:
+        break;
+
+    case AvsEffectList::Replace:
+        std::copy(src, src + count, dst);
+        break;
+
+    case AvsEffectList::Additive:
+        PixelKernels::addSaturate(dst, src, count);
+        break;
+
+    case AvsEffectList::Maximum:
+        PixelKernels::maxBlend(dst, src, count);
+        break;
+
+    case AvsEffectList::Average:
+        PixelKernels::averageBlend(dst, src, count);
+        break;
+    }
+}
+
+AvsEffectList::AvsEffectList(const QString &target, BlendMode input, BlendMode output, bool clearEveryFrame)
+    : input(input), output(output), clearEveryFrame(clearEveryFrame), m_target(target)
+{
+}
+
+void AvsEffectList::addEffect(std::unique_ptr<AvsEffect> effect)
+{
+    effect->setPool(pool);
+    effect->setQualityLevel(qualityLevel);
+    m_effects.push_back(std::move(effect));
+}
+
+void AvsEffectList::setPool(AvsFramebufferPool *p)
+{
+    pool = p;
+    for (auto &effect : m_effects)
+        effect->setPool(p);
+}
+
+void AvsEffectList::setQualityLevel(int level)
+{
+    qualityLevel = level;
+    for (auto &effect : m_effects)
+        effect->setQualityLevel(level);
+}
+
+bool AvsEffectList::readsFrame() const
+{
+    if (aliasesParent())
+        return firstEffectReadsFrame();
+    if (output != Replace)
+        return true; // blended over, or passed through untouched
+    return input == Replace ? firstEffectReadsFrame() : input != Ignore;
+}
+
+QStringList AvsEffectList::renderTargets() const
+{
+    QStringList targets;
+    if (!aliasesParent())
+        targets << m_target;
+    for (const auto &effect : m_effects)
+        targets << effect->renderTargets();
+    return targets;
+}
+
+size_t AvsEffectList::memoryUsage() const
+{
+    size_t bytes = 0;
+    for (const auto &effect : m_effects)
+        bytes += effect->memoryUsage();
+    return bytes;
+}
+
+// Copying the parent in and copying the result straight back out is the same
+// as rendering on the parent, so no sub-frame is needed at all
+bool AvsEffectList::aliasesParent() const
+{
+    return input == Replace && output == Replace && !clearEveryFrame;
+}
+
+bool AvsEffectList::firstEffectReadsFrame() const
+{
+    for (const auto &effect : m_effects) {
+        if (effect->enabled)
+            return effect->readsFrame();
+    }
+    return true; // empty list passes the frame through
+}
+
+void AvsEffectList::renderChildren(AvsFramebuffer &fb, const AvsAudioData &audio)
+{
+    for (auto &effect : m_effects) {
+        if (effect->enabled)
+            effect->render(fb, audio);
+    }
+}
+
+void AvsEffectList::render(AvsFramebuffer &fb, const AvsAudioData &audio)
+{
+    if (aliasesParent()) {
+        renderChildren(fb, audio);
+        return;
+    }
+
+    AvsFramebuffer &sub = pool->target(m_target);
+    int count = fb.pixelCount();
+
+    if (clearEveryFrame && input != Replace)
+        sub.clear();
+
+    if (input == Replace) {
+        // Skip the copy when the first child overwrites it anyway
+        if (firstEffectReadsFrame())
+            pool->copy(sub, fb);
+    } else {
+        blendInto(sub.pixels(), fb.pixels(), count, input);
+    }
+
+    renderChildren(sub, audio);
+
+    if (output == Replace) {
+        // The sub-frame only needs to survive if the next frame builds on it
+        if (clearEveryFrame || input == Replace)
+            fb.swap(sub);
+        else
+            pool->copy(fb, sub);
+    } else {
+        blendInto(fb.pixels(), sub.pixels(), count, output);
+    }
+}
@@ -0,0 +1,43 @@
+#ifndef AVSEFFECTLIST_H
+#define AVSEFFECTLIST_H
+
+#include "avseffect.h"
+#include <memory>
+#include <vector>
+
+// Nested chain rendering into its own pool target and blending back into the
+// parent frame, like the AVS "Effect List". The sub-frame persists across
+// frames unless clearEveryFrame is set.
+class AvsEffectList : public AvsEffect
+{
+public:
+    enum BlendMode { Ignore, Replace, Additive, Maximum, Average };
+
+    explicit AvsEffectList(const QString &target, BlendMode input = Ignore,
+                           BlendMode output = Replace, bool clearEveryFrame = false);
+
+    void addEffect(std::unique_ptr<AvsEffect> effect);
+
+    void render(AvsFramebuffer &fb, const AvsAudioData &audio) override;
+    QString name() const override { return "Effect List"; }
+
+    bool readsFrame() const override;
+    QStringList renderTargets() const override;
+    size_t memoryUsage() const override;
+    void setPool(AvsFramebufferPool *p) override;
+    void setQualityLevel(int level) override;
+
+    BlendMode input;
+    BlendMode output;
+    bool clearEveryFrame;
+
+private:
+    QString m_target;
+    std::vector<std::unique_ptr<AvsEffect>> m_effects;
+
+    bool aliasesParent() const;
+    bool firstEffectReadsFrame() const;
+    void renderChildren(AvsFramebuffer &fb, const AvsAudioData &audio);
+};
+
+#endif // AVSEFFECTLIST_H
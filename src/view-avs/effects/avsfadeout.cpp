@@ -1,7 +1,6 @@
 #include "avsfadeout.h"
 #include "avsframebuffer.h"
-#include <algorithm>
-#include <cstdint>
+#include "pixelkernels.h"
 
 AvsFadeOut::AvsFadeOut(int speed)
     : m_speed(speed)
@@ -10,21 +9,10 @@ AvsFadeOut::AvsFadeOut(int speed)
 
 void AvsFadeOut::render(AvsFramebuffer &fb, const AvsAudioData &)
 {
-    uint32_t *px = fb.pixels();
-    int count = fb.pixelCount();
-    int spd = m_speed;
-
-    for (int i = 0; i < count; i++) {
-        uint32_t p = px[i];
-        int a = (p >> 24) & 0xFF;
-        int r = (p >> 16) & 0xFF;
-        int g = (p >> 8) & 0xFF;
-        int b = p & 0xFF;
-
-        r = std::max(0, r - spd);
-        g = std::max(0, g - spd);
-        b = std::max(0, b - spd);
+    PixelKernels::fadeToward(fb.pixels(), fb.pixelCount(), 0xFF000000, m_speed);
+}
 
-        px[i] = (a << 24) | (r << 16) | (g << 8) | b;
-    }
+void AvsFadeOut::renderRows(uint32_t *px, int width, int, int y0, int y1, const uint32_t *)
+{
+    PixelKernels::fadeToward(px + y0 * width, (y1 - y0) * width, 0xFF000000, m_speed);
 }
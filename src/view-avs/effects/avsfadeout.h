@@ -10,6 +10,10 @@ public:
 
     void render(AvsFramebuffer &fb, const AvsAudioData &audio) override;
     QString name() const override { return "Fade Out"; }
+    Access access() const override { return Access::Pointwise; }
+    bool tileSafe() const override { return true; }
+    void renderRows(uint32_t *px, int width, int height, int y0, int y1,
+                    const uint32_t *above) override;
 
     int m_speed; // 1-32
 };
@@ -19,15 +19,25 @@ uint32_t AvsGrain::xorshift32()
 
 void AvsGrain::render(AvsFramebuffer &fb, const AvsAudioData &audio)
 {
-    int amt = m_amount;
+    beginFrame(fb, audio);
+    renderRows(fb.pixels(), fb.width(), fb.height(), 0, fb.height(), nullptr);
+}
+
+void AvsGrain::beginFrame(AvsFramebuffer &, const AvsAudioData &audio)
+{
+    m_frameAmount = m_amount;
     if (m_beatReactive)
-        amt = static_cast<int>(amt + audio.beatDecay * amt * 2.0f);
+        m_frameAmount = static_cast<int>(m_amount + audio.beatDecay * m_amount * 2.0f);
+}
 
+void AvsGrain::renderRows(uint32_t *rows, int width, int, int y0, int y1, const uint32_t *)
+{
+    int amt = m_frameAmount;
     if (amt <= 0)
         return;
 
-    uint32_t *px = fb.pixels();
-    int count = fb.pixelCount();
+    uint32_t *px = rows + y0 * width;
+    int count = (y1 - y0) * width;
     int range = amt * 2;
 
     for (int i = 0; i < count; i++) {
@@ -10,12 +10,19 @@ public:
 
     void render(AvsFramebuffer &fb, const AvsAudioData &audio) override;
     QString name() const override { return "Grain"; }
+    // Pointwise, but the noise sequence follows pixel order, so bands must
+    // run top to bottom and can't be tiled
+    Access access() const override { return Access::Pointwise; }
+    void beginFrame(AvsFramebuffer &fb, const AvsAudioData &audio) override;
+    void renderRows(uint32_t *px, int width, int height, int y0, int y1,
+                    const uint32_t *above) override;
 
     int m_amount;
     bool m_beatReactive;
 
 private:
     uint32_t m_rng = 0xDEADBEEF;
+    int m_frameAmount = 0;
     uint32_t xorshift32();
 };
 
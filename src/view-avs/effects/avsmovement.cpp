@@ -1,19 +1,25 @@
 #include "avsmovement.h"
 #include "avsframebuffer.h"
+#include "avsframebufferpool.h"
 #include <cmath>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
-AvsMovement::AvsMovement(MovementType type)
-    : m_type(type), m_backBuffer(AVS_FB_WIDTH, AVS_FB_HEIGHT),
+AvsMovement::AvsMovement(MovementType type, bool bilinear)
+    : bilinear(bilinear), m_type(type),
       m_width(AVS_FB_WIDTH), m_height(AVS_FB_HEIGHT)
 {
     m_displaceTable.resize(m_width * m_height);
     buildTable();
 }
 
+size_t AvsMovement::memoryUsage() const
+{
+    return m_displaceTable.size() * sizeof(AvsMoveEntry);
+}
+
 void AvsMovement::setMovementType(MovementType type)
 {
     m_type = type;
@@ -82,29 +88,26 @@ void AvsMovement::buildTable()
             }
             }
 
-            int idx = y * m_width + x;
-            m_displaceTable[idx].srcX = static_cast<int>(srcX);
-            m_displaceTable[idx].srcY = static_cast<int>(srcY);
+            m_displaceTable[y * m_width + x] = AvsMoveTable::entryFor(srcX, srcY, m_width, m_height);
         }
     }
 }
 
 void AvsMovement::render(AvsFramebuffer &fb, const AvsAudioData &)
 {
-    m_backBuffer.copyFrom(fb);
-    const uint32_t *src = m_backBuffer.pixels();
-    uint32_t *dst = fb.pixels();
-    int w = m_width;
-    int h = m_height;
-
-    for (int i = 0; i < w * h; i++) {
-        int sx = m_displaceTable[i].srcX;
-        int sy = m_displaceTable[i].srcY;
+    // Resample into the shared scratch buffer and swap it in, instead of
+    // copying the frame aside first
+    AvsFramebuffer &out = pool->scratch();
+    AvsMoveTable::apply(fb.pixels(), out.pixels(), m_displaceTable.data(),
+                        m_width * m_height, m_width, bilinear);
+    fb.swap(out);
+}
 
-        if (sx >= 0 && sx < w && sy >= 0 && sy < h) {
-            dst[i] = src[sy * w + sx];
-        } else {
-            dst[i] = 0xFF000000; // black for out of bounds
-        }
-    }
+void AvsMovement::renderTile(const uint32_t *src, uint32_t *dst, int width, int,
+                             int y0, int y1)
+{
+    // Table entries hold absolute source indices, so a band is just a slice
+    size_t offset = static_cast<size_t>(y0) * width;
+    AvsMoveTable::apply(src, dst + offset, m_displaceTable.data() + offset,
+                        (y1 - y0) * width, width, bilinear);
 }
@@ -2,7 +2,7 @@
 #define AVSMOVEMENT_H
 
 #include "avseffect.h"
-#include "avsframebuffer.h"
+#include "avsmovetable.h"
 #include <vector>
 
 class AvsMovement : public AvsEffect
@@ -10,22 +10,23 @@ class AvsMovement : public AvsEffect
 public:
     enum MovementType { ZoomIn, ZoomOut, Swirl, SwirlOut, Tunnel, SuckIn };
 
-    explicit AvsMovement(MovementType type = ZoomIn);
+    // bilinear = false keeps the cheaper nearest-neighbour lookup
+    explicit AvsMovement(MovementType type = ZoomIn, bool bilinear = true);
 
     void render(AvsFramebuffer &fb, const AvsAudioData &audio) override;
     QString name() const override { return "Movement"; }
+    size_t memoryUsage() const override;
+    bool tileSafe() const override { return true; }
+    void renderTile(const uint32_t *src, uint32_t *dst, int width, int height,
+                    int y0, int y1) override;
 
     void setMovementType(MovementType type);
 
-private:
-    struct DisplaceEntry {
-        int srcX;
-        int srcY;
-    };
+    bool bilinear;
 
+private:
     MovementType m_type;
-    std::vector<DisplaceEntry> m_displaceTable;
-    AvsFramebuffer m_backBuffer;
+    std::vector<AvsMoveEntry> m_displaceTable;
     int m_width;
     int m_height;
 
@@ -1,6 +1,7 @@
 #include "avsring.h"
 #include "avsframebuffer.h"
 #include "avsaudiodata.h"
+#include "rasterizer.h"
 #include <algorithm>
 #include <cmath>
 
@@ -9,46 +10,9 @@ AvsRing::AvsRing(uint32_t color, int ringCount, float scaleY)
 {
 }
 
-void AvsRing::drawCircle(AvsFramebuffer &fb, int cx, int cy, int radius, uint32_t col)
-{
-    if (radius <= 0)
-        return;
-
-    uint32_t *px = fb.pixels();
-    int w = fb.width();
-    int h = fb.height();
-
-    // Midpoint circle algorithm
-    int x = radius;
-    int y = 0;
-    int err = 1 - radius;
-
-    auto plot = [&](int px_x, int px_y) {
-        if (px_x >= 0 && px_x < w && px_y >= 0 && px_y < h)
-            px[px_y * w + px_x] = col;
-    };
-
-    while (x >= y) {
-        plot(cx + x, cy + y);
-        plot(cx - x, cy + y);
-        plot(cx + x, cy - y);
-        plot(cx - x, cy - y);
-        plot(cx + y, cy + x);
-        plot(cx - y, cy + x);
-        plot(cx + y, cy - x);
-        plot(cx - y, cy - x);
-        y++;
-        if (err < 0) {
-            err += 2 * y + 1;
-        } else {
-            x--;
-            err += 2 * (y - x) + 1;
-        }
-    }
-}
-
 void AvsRing::render(AvsFramebuffer &fb, const AvsAudioData &audio)
 {
+    const Rasterizer::Surface surface{fb.pixels(), fb.width(), fb.height()};
     int w = fb.width();
     int h = fb.height();
     int cx = w / 2;
@@ -74,6 +38,6 @@ void AvsRing::render(AvsFramebuffer &fb, const AvsAudioData &audio)
         cb = std::min(cb, 255);
         uint32_t col = 0xFF000000 | (cr << 16) | (cg << 8) | cb;
 
-        drawCircle(fb, cx, cy, radius, col);
+        Rasterizer::circle(surface, cx, cy, radius, Rasterizer::Replace{col});
     }
 }
@@ -15,9 +15,6 @@ public:
     uint32_t m_color;
     int m_ringCount;
     float m_scaleY;
-
-private:
-    void drawCircle(AvsFramebuffer &fb, int cx, int cy, int radius, uint32_t col);
 };
 
 #endif // AVSRING_H
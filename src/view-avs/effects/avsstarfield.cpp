@@ -1,6 +1,7 @@
 #include "avsstarfield.h"
 #include "avsframebuffer.h"
 #include "avsaudiodata.h"
+#include "qualitygovernor.h"
 #include <algorithm>
 
 AvsStarfield::AvsStarfield(int starCount, float baseSpeed)
@@ -37,8 +38,9 @@ void AvsStarfield::render(AvsFramebuffer &fb, const AvsAudioData &audio)
     uint32_t *px = fb.pixels();
 
     float speed = m_baseSpeed * (1.0f + audio.beatDecay * 2.0f);
+    int count = qualityLevel >= QualityGovernor::FewerParticles ? m_starCount / 2 : m_starCount;
 
-    for (int i = 0; i < m_starCount; i++) {
+    for (int i = 0; i < count; i++) {
         Star &s = m_stars[i];
         s.z -= speed;
 
@@ -1,6 +1,8 @@
 #include "avssuperscope.h"
 #include "avsframebuffer.h"
 #include "avsaudiodata.h"
+#include "rasterizer.h"
+#include <QDebug>
 #include <cmath>
 #include <algorithm>
 
@@ -8,46 +10,172 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+// Upper bound on n so a runaway script can't stall the frame
+static constexpr int MAX_SCRIPTED_POINTS = 2048;
+
 AvsSuperScope::AvsSuperScope()
 {
 }
 
-void AvsSuperScope::setPixel(AvsFramebuffer &fb, int x, int y, uint32_t col)
+AvsSuperScope::~AvsSuperScope() = default;
+
+void AvsSuperScope::setCode(const QString &init, const QString &frame,
+                            const QString &beat, const QString &point)
 {
-    if (x >= 0 && x < fb.width() && y >= 0 && y < fb.height()) {
-        fb.pixels()[y * fb.width() + x] = col;
+    m_script = std::make_unique<AvsScript>();
+    m_initDone = false;
+
+    m_n = m_script->variable("n");
+    m_i = m_script->variable("i");
+    m_v = m_script->variable("v");
+    m_x = m_script->variable("x");
+    m_y = m_script->variable("y");
+    m_red = m_script->variable("red");
+    m_green = m_script->variable("green");
+    m_blue = m_script->variable("blue");
+    m_skip = m_script->variable("skip");
+    m_drawMode = m_script->variable("drawmode");
+    m_b = m_script->variable("b");
+    m_w = m_script->variable("w");
+    m_h = m_script->variable("h");
+
+    m_script->setTransient(m_skip);
+    m_script->value(m_n) = 100.0f;
+    m_script->value(m_drawMode) = (drawMode == Lines) ? 1.0f : 0.0f;
+
+    const struct { const QString &source; AvsScript::Program &program; const char *label; } parts[] = {
+        {init, m_initCode, "init"}, {frame, m_frameCode, "frame"},
+        {beat, m_beatCode, "beat"}, {point, m_pointCode, "point"},
+    };
+    for (const auto &part : parts) {
+        QString error;
+        if (!m_script->compile(part.source, part.program, &error))
+            qWarning() << "[avs] SuperScope" << part.label << "code:" << error;
     }
 }
 
-void AvsSuperScope::drawLine(AvsFramebuffer &fb, int x0, int y0, int x1, int y1, uint32_t col)
+size_t AvsSuperScope::memoryUsage() const
 {
-    // Bresenham's line algorithm
-    int dx = std::abs(x1 - x0);
-    int dy = -std::abs(y1 - y0);
-    int sx = (x0 < x1) ? 1 : -1;
-    int sy = (y0 < y1) ? 1 : -1;
-    int err = dx + dy;
-
-    for (;;) {
-        setPixel(fb, x0, y0, col);
-        if (x0 == x1 && y0 == y1)
-            break;
-        int e2 = 2 * err;
-        if (e2 >= dy) {
-            err += dy;
-            x0 += sx;
+    if (!m_script)
+        return 0;
+    size_t instrs = m_initCode.code.size() + m_frameCode.code.size()
+                  + m_beatCode.code.size() + m_pointCode.code.size();
+    return instrs * sizeof(AvsScript::Instr) + m_script->memoryUsage();
+}
+
+// Map normalized coords [-1,1] to pixel coords and draw a dot or a line
+// from the previous point. Points off the screen are clipped, not pinned
+// to its edge.
+void AvsSuperScope::plot(AvsFramebuffer &fb, float x, float y, uint32_t col, bool line,
+                         bool &hasPrev, float &prevPx, float &prevPy)
+{
+    const Rasterizer::Surface surface{fb.pixels(), fb.width(), fb.height()};
+    const Rasterizer::Replace op{col};
+    float px = (x + 1.0f) * 0.5f * fb.width();
+    float py = (y + 1.0f) * 0.5f * fb.height();
+
+    if (line && hasPrev) {
+        if (antialias && lineWidth <= 1)
+            Rasterizer::lineAA(surface, prevPx, prevPy, px, py, op);
+        else
+            Rasterizer::thickLine(surface, prevPx, prevPy, px, py, lineWidth, op);
+    } else if (px >= 0.0f && px < fb.width() && py >= 0.0f && py < fb.height()) {
+        const Rasterizer::Point dot{static_cast<int>(px), static_cast<int>(py)};
+        Rasterizer::pointSprites(surface, &dot, 1, lineWidth / 2, op);
+    }
+
+    hasPrev = true;
+    prevPx = px;
+    prevPy = py;
+}
+
+static inline uint32_t scriptColor(float r, float g, float b)
+{
+    auto channel = [](float c) { return static_cast<uint32_t>(std::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f); };
+    return 0xFF000000 | (channel(r) << 16) | (channel(g) << 8) | channel(b);
+}
+
+void AvsSuperScope::renderScripted(AvsFramebuffer &fb, const AvsAudioData &audio)
+{
+    AvsScript &s = *m_script;
+    s.setAudio(&audio);
+
+    s.value(m_w) = static_cast<float>(fb.width());
+    s.value(m_h) = static_cast<float>(fb.height());
+    s.value(m_b) = audio.isBeat ? 1.0f : 0.0f;
+    s.value(m_red) = ((color >> 16) & 0xFF) / 255.0f;
+    s.value(m_green) = ((color >> 8) & 0xFF) / 255.0f;
+    s.value(m_blue) = (color & 0xFF) / 255.0f;
+    s.value(m_skip) = 0.0f;
+
+    if (!m_initDone) {
+        s.run(m_initCode);
+        m_initDone = true;
+    }
+    s.run(m_frameCode);
+    if (audio.isBeat)
+        s.run(m_beatCode);
+
+    int n = std::clamp(static_cast<int>(s.value(m_n)), 1, MAX_SCRIPTED_POINTS);
+    bool lines = s.value(m_drawMode) > 0.5f;
+
+    const float *source = (sourceType == Spectrum) ? audio.spectrumMono : audio.waveformMono;
+    int sourceSize = (sourceType == Spectrum) ? AVS_SPECTRUM_SIZE : AVS_WAVEFORM_SIZE;
+    float step = n > 1 ? 1.0f / (n - 1) : 0.0f;
+    auto sampleAt = [&](int i) { return source[std::min(i * sourceSize / n, sourceSize - 1)]; };
+
+    bool hasPrev = false;
+    float prevPx = 0.0f, prevPy = 0.0f;
+
+    if (m_pointCode.carriesState) {
+        // Each point sees the previous one's variables: evaluate one at a time
+        for (int i = 0; i < n; i++) {
+            s.value(m_i) = i * step;
+            s.value(m_v) = sampleAt(i);
+            s.value(m_skip) = 0.0f;
+            s.run(m_pointCode);
+            if (s.value(m_skip) != 0.0f)
+                continue;
+            uint32_t col = scriptColor(s.value(m_red), s.value(m_green), s.value(m_blue));
+            plot(fb, s.value(m_x), s.value(m_y), col, lines, hasPrev, prevPx, prevPy);
         }
-        if (e2 <= dx) {
-            err += dx;
-            y0 += sy;
+        return;
+    }
+
+    s.beginBatch();
+    int last = -1;
+    for (int base = 0; base < n; base += AvsScript::BATCH) {
+        int count = std::min(AvsScript::BATCH, n - base);
+        float *li = s.lanes(m_i);
+        float *lv = s.lanes(m_v);
+        float *lskip = s.lanes(m_skip);
+        for (int l = 0; l < count; l++) {
+            li[l] = (base + l) * step;
+            lv[l] = sampleAt(base + l);
+            lskip[l] = 0.0f;
+        }
+
+        s.runBatch(m_pointCode, count);
+
+        const float *lx = s.lanes(m_x), *ly = s.lanes(m_y);
+        const float *lr = s.lanes(m_red), *lg = s.lanes(m_green), *lb = s.lanes(m_blue);
+        for (int l = 0; l < count; l++) {
+            if (lskip[l] != 0.0f)
+                continue;
+            plot(fb, lx[l], ly[l], scriptColor(lr[l], lg[l], lb[l]), lines, hasPrev, prevPx, prevPy);
         }
+        last = count - 1;
     }
+    s.endBatch(last);
 }
 
 void AvsSuperScope::render(AvsFramebuffer &fb, const AvsAudioData &audio)
 {
-    int w = fb.width();
-    int h = fb.height();
+    if (isScripted()) {
+        renderScripted(fb, audio);
+        return;
+    }
+
     int numPoints = AVS_WAVEFORM_SIZE;
 
     const float *source;
@@ -60,7 +188,8 @@ void AvsSuperScope::render(AvsFramebuffer &fb, const AvsAudioData &audio)
         sourceSize = AVS_WAVEFORM_SIZE;
     }
 
-    int prevPx = -1, prevPy = -1;
+    bool hasPrev = false;
+    float prevPx = 0.0f, prevPy = 0.0f;
     float n = static_cast<float>(numPoints);
 
     for (int i = 0; i < numPoints; i++) {
@@ -97,20 +226,6 @@ void AvsSuperScope::render(AvsFramebuffer &fb, const AvsAudioData &audio)
             break;
         }
 
-        // Map normalized coords [-1,1] to pixel coords
-        int px = static_cast<int>((x + 1.0f) * 0.5f * w);
-        int py = static_cast<int>((y + 1.0f) * 0.5f * h);
-
-        px = std::clamp(px, 0, w - 1);
-        py = std::clamp(py, 0, h - 1);
-
-        if (drawMode == Lines && i > 0 && prevPx >= 0) {
-            drawLine(fb, prevPx, prevPy, px, py, color);
-        } else {
-            setPixel(fb, px, py, color);
-        }
-
-        prevPx = px;
-        prevPy = py;
+        plot(fb, x, y, color, drawMode == Lines, hasPrev, prevPx, prevPy);
     }
 }
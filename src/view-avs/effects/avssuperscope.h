@@ -2,7 +2,9 @@
 #define AVSSUPERSCOPE_H
 
 #include "avseffect.h"
+#include "avsscript.h"
 #include <cstdint>
+#include <memory>
 
 class AvsSuperScope : public AvsEffect
 {
@@ -12,19 +14,39 @@ public:
     enum SourceType { Waveform, Spectrum };
 
     AvsSuperScope();
+    ~AvsSuperScope() override;
 
     void render(AvsFramebuffer &fb, const AvsAudioData &audio) override;
     QString name() const override { return "SuperScope"; }
+    size_t memoryUsage() const override;
+
+    // Scripted shape in AVS SuperScope terms; replaces shapePreset when point
+    // code is set. Variables: n (point count), i (0-1 along the scope),
+    // v (sample), x/y (-1..1), red/green/blue (0-1), skip, drawmode, b, w, h.
+    // Code that fails to compile is logged and left empty.
+    void setCode(const QString &init, const QString &frame,
+                 const QString &beat, const QString &point);
+    bool isScripted() const { return !m_pointCode.isEmpty(); }
 
     DrawMode drawMode = Lines;
     ShapePreset shapePreset = Oscilloscope;
     SourceType sourceType = Waveform;
     uint32_t color = 0xFF00FFFF; // cyan
     float scaleY = 0.8f;
+    int lineWidth = 1;      // pixels; dots become discs when wider than 1
+    bool antialias = false; // 1-pixel lines only
 
 private:
-    void drawLine(AvsFramebuffer &fb, int x0, int y0, int x1, int y1, uint32_t col);
-    void setPixel(AvsFramebuffer &fb, int x, int y, uint32_t col);
+    void renderScripted(AvsFramebuffer &fb, const AvsAudioData &audio);
+    void plot(AvsFramebuffer &fb, float x, float y, uint32_t col, bool line,
+              bool &hasPrev, float &prevPx, float &prevPy);
+
+    std::unique_ptr<AvsScript> m_script;
+    AvsScript::Program m_initCode, m_frameCode, m_beatCode, m_pointCode;
+    bool m_initDone = false;
+    int m_n = 0, m_i = 0, m_v = 0, m_x = 0, m_y = 0;
+    int m_red = 0, m_green = 0, m_blue = 0;
+    int m_skip = 0, m_drawMode = 0, m_b = 0, m_w = 0, m_h = 0;
 };
 
 #endif // AVSSUPERSCOPE_H
@@ -1,27 +1,260 @@
 #include "avswater.h"
 #include "avsframebuffer.h"
+#include "avsframebufferpool.h"
 #include "avsaudiodata.h"
 #include <algorithm>
+#include <cmath>
 #include <cstring>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// --- Fixed-point heightfield ---
+//
+// Heights are int16 in 1/16 pixel. They are clamped to +-5461 so the ripple
+// update's four neighbours minus twice the centre fit in 16 bits, which
+// still leaves +-341 pixels of height, far beyond anything the damping lets
+// build up. The update keeps that full sum and rounds the damped result;
+// truncating either step biases the damping and the water rings on about
+// twice as long as the float version. The SIMD paths do eight pixels per
+// step with the same integer arithmetic as the scalar ones, so all give the
+// same result. Widths and heights must fit in int16, which the 320x100 AVS
+// frame does easily.
+
+namespace {
+
+constexpr int HEIGHT_SHIFT = 4;
+constexpr int HEIGHT_LIMIT = 5461;
+
+// Height difference to a whole-pixel offset, truncated toward zero like the
+// float version's cast
+inline int toPixels(int gradient)
+{
+    return (gradient < 0 ? gradient + (1 << HEIGHT_SHIFT) - 1 : gradient) >> HEIGHT_SHIFT;
+}
+
+// cur = (sum of the 4 neighbours in prev / 2 - cur) * damp for x in [x0, x1)
+// of one interior row. damp is Q15, so the halving folds into the shift.
+void propagateScalar(const int16_t *prev, int16_t *cur, int w, int x0, int x1, int damp)
+{
+    for (int x = x0; x < x1; x++) {
+        int sum = prev[x - 1] + prev[x + 1] + prev[x - w] + prev[x + w];
+        int val = ((sum - 2 * cur[x]) * damp + 0x8000) >> 16;
+        cur[x] = static_cast<int16_t>(std::clamp(val, -HEIGHT_LIMIT, HEIGHT_LIMIT));
+    }
+}
+
+void refractScalar(const uint32_t *src, uint32_t *dst, const int16_t *height,
+                   int w, int h, int y, int x0, int x1)
+{
+    for (int x = x0; x < x1; x++) {
+        int srcX = std::clamp(x + toPixels(height[x + 1] - height[x - 1]), 0, w - 1);
+        int srcY = std::clamp(y + toPixels(height[x + w] - height[x - w]), 0, h - 1);
+        dst[x] = src[srcY * w + srcX];
+    }
+}
+
+#if defined(__SSE2__)
+
+inline __m128i load8(const int16_t *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+
+int propagateSimd(const int16_t *prev, int16_t *cur, int w, int x, int x1, int damp)
+{
+    const __m128i d = _mm_set1_epi16(static_cast<short>(damp));
+    const __m128i lower = _mm_set1_epi16(-HEIGHT_LIMIT);
+    const __m128i upper = _mm_set1_epi16(HEIGHT_LIMIT);
+    const __m128i round = _mm_set1_epi32(0x8000);
+    for (; x + 8 <= x1; x += 8) {
+        __m128i sum = _mm_add_epi16(_mm_add_epi16(load8(prev + x - 1), load8(prev + x + 1)),
+                                    _mm_add_epi16(load8(prev + x - w), load8(prev + x + w)));
+        __m128i c = load8(cur + x);
+        __m128i val = _mm_sub_epi16(_mm_sub_epi16(sum, c), c);
+        // 16x16 -> 32-bit product from the low and high halves, rounded
+        __m128i lo = _mm_mullo_epi16(val, d);
+        __m128i hi = _mm_mulhi_epi16(val, d);
+        __m128i p0 = _mm_srai_epi32(_mm_add_epi32(_mm_unpacklo_epi16(lo, hi), round), 16);
+        __m128i p1 = _mm_srai_epi32(_mm_add_epi32(_mm_unpackhi_epi16(lo, hi), round), 16);
+        __m128i r = _mm_min_epi16(_mm_max_epi16(_mm_packs_epi32(p0, p1), lower), upper);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(cur + x), r);
+    }
+    return x;
+}
+
+inline __m128i toPixels8(__m128i g)
+{
+    __m128i bias = _mm_and_si128(_mm_srai_epi16(g, 15), _mm_set1_epi16((1 << HEIGHT_SHIFT) - 1));
+    return _mm_srai_epi16(_mm_add_epi16(g, bias), HEIGHT_SHIFT);
+}
+
+int refractSimd(const uint32_t *src, uint32_t *dst, const int16_t *height,
+                int w, int h, int y, int x, int x1)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i maxX = _mm_set1_epi16(static_cast<short>(w - 1));
+    const __m128i maxY = _mm_set1_epi16(static_cast<short>(h - 1));
+    const __m128i width = _mm_set1_epi16(static_cast<short>(w));
+    const __m128i lanes = _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m128i row = _mm_set1_epi16(static_cast<short>(y));
+    alignas(16) int32_t index[8];
+
+    for (; x + 8 <= x1; x += 8) {
+        __m128i ox = toPixels8(_mm_sub_epi16(load8(height + x + 1), load8(height + x - 1)));
+        __m128i oy = toPixels8(_mm_sub_epi16(load8(height + x + w), load8(height + x - w)));
+
+        // Calm water doesn't move anything; most of the frame takes this
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_or_si128(ox, oy), zero)) == 0xFFFF) {
+            const __m128i *s = reinterpret_cast<const __m128i *>(src + y * w + x);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x), _mm_loadu_si128(s));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x + 4), _mm_loadu_si128(s + 1));
+            continue;
+        }
+
+        __m128i xs = _mm_add_epi16(_mm_set1_epi16(static_cast<short>(x)), lanes);
+        __m128i sx = _mm_min_epi16(_mm_max_epi16(_mm_add_epi16(xs, ox), zero), maxX);
+        __m128i sy = _mm_min_epi16(_mm_max_epi16(_mm_add_epi16(row, oy), zero), maxY);
+
+        // sy * w + sx in 32 bits
+        __m128i lo = _mm_mullo_epi16(sy, width);
+        __m128i hi = _mm_mulhi_epi16(sy, width);
+        __m128i i0 = _mm_add_epi32(_mm_unpacklo_epi16(lo, hi), _mm_unpacklo_epi16(sx, zero));
+        __m128i i1 = _mm_add_epi32(_mm_unpackhi_epi16(lo, hi), _mm_unpackhi_epi16(sx, zero));
+        _mm_store_si128(reinterpret_cast<__m128i *>(index), i0);
+        _mm_store_si128(reinterpret_cast<__m128i *>(index + 4), i1);
+
+        for (int k = 0; k < 8; k++)
+            dst[x + k] = src[index[k]];
+    }
+    return x;
+}
+
+#elif defined(__ARM_NEON)
+
+int propagateSimd(const int16_t *prev, int16_t *cur, int w, int x, int x1, int damp)
+{
+    const int16x4_t d = vdup_n_s16(static_cast<int16_t>(damp));
+    const int16x8_t lower = vdupq_n_s16(-HEIGHT_LIMIT);
+    const int16x8_t upper = vdupq_n_s16(HEIGHT_LIMIT);
+    for (; x + 8 <= x1; x += 8) {
+        int16x8_t sum = vaddq_s16(vaddq_s16(vld1q_s16(prev + x - 1), vld1q_s16(prev + x + 1)),
+                                  vaddq_s16(vld1q_s16(prev + x - w), vld1q_s16(prev + x + w)));
+        int16x8_t c = vld1q_s16(cur + x);
+        int16x8_t val = vsubq_s16(vsubq_s16(sum, c), c);
+        // Rounding shift: adds 0x8000 first like the scalar version
+        int32x4_t p0 = vrshrq_n_s32(vmull_s16(vget_low_s16(val), d), 16);
+        int32x4_t p1 = vrshrq_n_s32(vmull_s16(vget_high_s16(val), d), 16);
+        int16x8_t r = vcombine_s16(vqmovn_s32(p0), vqmovn_s32(p1));
+        vst1q_s16(cur + x, vminq_s16(vmaxq_s16(r, lower), upper));
+    }
+    return x;
+}
+
+inline int16x8_t toPixels8(int16x8_t g)
+{
+    int16x8_t bias = vandq_s16(vshrq_n_s16(g, 15), vdupq_n_s16((1 << HEIGHT_SHIFT) - 1));
+    return vshrq_n_s16(vaddq_s16(g, bias), HEIGHT_SHIFT);
+}
+
+int refractSimd(const uint32_t *src, uint32_t *dst, const int16_t *height,
+                int w, int h, int y, int x, int x1)
+{
+    static const int16_t laneOffsets[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+    const int16x8_t zero = vdupq_n_s16(0);
+    const int16x8_t maxX = vdupq_n_s16(static_cast<int16_t>(w - 1));
+    const int16x8_t maxY = vdupq_n_s16(static_cast<int16_t>(h - 1));
+    const int16x4_t width = vdup_n_s16(static_cast<int16_t>(w));
+    const int16x8_t lanes = vld1q_s16(laneOffsets);
+    const int16x8_t row = vdupq_n_s16(static_cast<int16_t>(y));
+    int32_t index[8];
+
+    for (; x + 8 <= x1; x += 8) {
+        int16x8_t ox = toPixels8(vsubq_s16(vld1q_s16(height + x + 1), vld1q_s16(height + x - 1)));
+        int16x8_t oy = toPixels8(vsubq_s16(vld1q_s16(height + x + w), vld1q_s16(height + x - w)));
+
+        // Calm water doesn't move anything; most of the frame takes this
+        uint64x2_t moved = vreinterpretq_u64_s16(vorrq_s16(ox, oy));
+        if ((vgetq_lane_u64(moved, 0) | vgetq_lane_u64(moved, 1)) == 0) {
+            vst1q_u32(dst + x, vld1q_u32(src + y * w + x));
+            vst1q_u32(dst + x + 4, vld1q_u32(src + y * w + x + 4));
+            continue;
+        }
+
+        int16x8_t xs = vaddq_s16(vdupq_n_s16(static_cast<int16_t>(x)), lanes);
+        int16x8_t sx = vminq_s16(vmaxq_s16(vaddq_s16(xs, ox), zero), maxX);
+        int16x8_t sy = vminq_s16(vmaxq_s16(vaddq_s16(row, oy), zero), maxY);
+
+        // sx + sy * w in 32 bits
+        vst1q_s32(index, vmlal_s16(vmovl_s16(vget_low_s16(sx)), vget_low_s16(sy), width));
+        vst1q_s32(index + 4, vmlal_s16(vmovl_s16(vget_high_s16(sx)), vget_high_s16(sy), width));
+
+        for (int k = 0; k < 8; k++)
+            dst[x + k] = src[index[k]];
+    }
+    return x;
+}
+
+#else
+
+int propagateSimd(const int16_t *, int16_t *, int, int x, int, int) { return x; }
+int refractSimd(const uint32_t *, uint32_t *, const int16_t *, int, int, int, int x, int) { return x; }
+
+#endif
+
+} // namespace
+
 AvsWater::AvsWater(float damping, float beatInjection)
-    : m_damping(damping), m_beatInjection(beatInjection),
-      m_backBuffer(AVS_FB_WIDTH, AVS_FB_HEIGHT)
+    : m_damping(damping), m_beatInjection(beatInjection)
+{
+}
+
+size_t AvsWater::memoryUsage() const
 {
+    return (m_heightCurrent.size() + m_heightPrevious.size()) * sizeof(float)
+         + (m_fixedCurrent.size() + m_fixedPrevious.size()) * sizeof(int16_t);
 }
 
 void AvsWater::ensureBuffers(int w, int h)
 {
-    if (m_width == w && m_height == h)
+    if (m_width == w && m_height == h && m_buffersFixed == fixedPoint)
         return;
     m_width = w;
     m_height = h;
+    m_buffersFixed = fixedPoint;
     int size = w * h;
-    m_heightCurrent.assign(size, 0.0f);
-    m_heightPrevious.assign(size, 0.0f);
+
+    // Only the active representation is kept; switching starts calm water
+    if (fixedPoint) {
+        m_fixedCurrent.assign(size, 0);
+        m_fixedPrevious.assign(size, 0);
+        std::vector<float>().swap(m_heightCurrent);
+        std::vector<float>().swap(m_heightPrevious);
+    } else {
+        m_heightCurrent.assign(size, 0.0f);
+        m_heightPrevious.assign(size, 0.0f);
+        std::vector<int16_t>().swap(m_fixedCurrent);
+        std::vector<int16_t>().swap(m_fixedPrevious);
+    }
+}
+
+uint32_t AvsWater::nextRandom()
+{
+    m_rng ^= m_rng << 13;
+    m_rng ^= m_rng >> 17;
+    m_rng ^= m_rng << 5;
+    return m_rng;
 }
 
 void AvsWater::render(AvsFramebuffer &fb, const AvsAudioData &audio)
+{
+    beginFrame(fb, audio);
+    AvsFramebuffer &out = pool->scratch();
+    renderTile(fb.pixels(), out.pixels(), fb.width(), fb.height(), 0, fb.height());
+    fb.swap(out);
+}
+
+void AvsWater::beginFrame(AvsFramebuffer &fb, const AvsAudioData &audio)
 {
     int w = fb.width();
     int h = fb.height();
@@ -29,24 +262,36 @@ void AvsWater::render(AvsFramebuffer &fb, const AvsAudioData &audio)
 
     // Inject energy on beat at random position
     if (audio.isBeat) {
-        m_rng ^= m_rng << 13;
-        m_rng ^= m_rng >> 17;
-        m_rng ^= m_rng << 5;
-        int rx = 2 + static_cast<int>(m_rng % (w - 4));
-        m_rng ^= m_rng << 13;
-        m_rng ^= m_rng >> 17;
-        m_rng ^= m_rng << 5;
-        int ry = 2 + static_cast<int>(m_rng % (h - 4));
+        int rx = 2 + static_cast<int>(nextRandom() % (w - 4));
+        int ry = 2 + static_cast<int>(nextRandom() % (h - 4));
+        int splash = std::min(static_cast<int>(m_beatInjection * (1 << HEIGHT_SHIFT)), HEIGHT_LIMIT);
 
         // Inject a small splash area
         for (int dy = -1; dy <= 1; dy++) {
             for (int dx = -1; dx <= 1; dx++) {
-                m_heightCurrent[(ry + dy) * w + (rx + dx)] = m_beatInjection;
+                int idx = (ry + dy) * w + (rx + dx);
+                if (fixedPoint)
+                    m_fixedCurrent[idx] = static_cast<int16_t>(splash);
+                else
+                    m_heightCurrent[idx] = m_beatInjection;
             }
         }
     }
 
-    // Wave propagation
+    // Wave propagation. The displacement reads neighbouring rows of the
+    // result, so this has to finish before any tile starts.
+    if (fixedPoint) {
+        std::swap(m_fixedCurrent, m_fixedPrevious);
+        int damp = std::clamp(static_cast<int>(lroundf(m_damping * 32768.0f)), 0, 32767);
+        for (int y = 1; y < h - 1; y++) {
+            const int16_t *prev = m_fixedPrevious.data() + y * w;
+            int16_t *cur = m_fixedCurrent.data() + y * w;
+            int x = propagateSimd(prev, cur, w, 1, w - 1, damp);
+            propagateScalar(prev, cur, w, x, w - 1, damp);
+        }
+        return;
+    }
+
     std::swap(m_heightCurrent, m_heightPrevious);
 
     for (int y = 1; y < h - 1; y++) {
@@ -61,13 +306,27 @@ void AvsWater::render(AvsFramebuffer &fb, const AvsAudioData &audio)
             m_heightCurrent[idx] = val;
         }
     }
+}
 
-    // Apply displacement to framebuffer
-    m_backBuffer.copyFrom(fb);
-    const uint32_t *src = m_backBuffer.pixels();
-    uint32_t *dst = fb.pixels();
+void AvsWater::renderTile(const uint32_t *src, uint32_t *dst, int w, int h, int y0, int y1)
+{
+    for (int y = y0; y < y1; y++) {
+        // The heightfield border never moves; carry those pixels over unchanged
+        if (y == 0 || y == h - 1) {
+            std::copy(src + y * w, src + (y + 1) * w, dst + y * w);
+            continue;
+        }
+
+        dst[y * w] = src[y * w];
+        dst[y * w + w - 1] = src[y * w + w - 1];
+
+        if (fixedPoint) {
+            const int16_t *height = m_fixedCurrent.data() + y * w;
+            int x = refractSimd(src, dst + y * w, height, w, h, y, 1, w - 1);
+            refractScalar(src, dst + y * w, height, w, h, y, x, w - 1);
+            continue;
+        }
 
-    for (int y = 1; y < h - 1; y++) {
         for (int x = 1; x < w - 1; x++) {
             int idx = y * w + x;
             int dx = static_cast<int>(m_heightCurrent[idx + 1] - m_heightCurrent[idx - 1]);
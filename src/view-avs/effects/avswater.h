@@ -2,7 +2,6 @@
 #define AVSWATER_H
 
 #include "avseffect.h"
-#include "avsframebuffer.h"
 #include <vector>
 #include <cstdint>
 
@@ -13,19 +12,32 @@ public:
 
     void render(AvsFramebuffer &fb, const AvsAudioData &audio) override;
     QString name() const override { return "Water"; }
+    size_t memoryUsage() const override;
+    bool tileSafe() const override { return true; }
+    void beginFrame(AvsFramebuffer &fb, const AvsAudioData &audio) override;
+    void renderTile(const uint32_t *src, uint32_t *dst, int width, int height,
+                    int y0, int y1) override;
 
     float m_damping;
     float m_beatInjection;
 
+    // The heightfield is int16 in 1/16 pixel steps, updated and refracted
+    // eight pixels at a time. false runs the original float version, kept as
+    // the reference.
+    bool fixedPoint = true;
+
 private:
     std::vector<float> m_heightCurrent;
     std::vector<float> m_heightPrevious;
-    AvsFramebuffer m_backBuffer;
+    std::vector<int16_t> m_fixedCurrent;
+    std::vector<int16_t> m_fixedPrevious;
     int m_width = 0;
     int m_height = 0;
+    bool m_buffersFixed = false;
     uint32_t m_rng = 0x1337BEEF;
 
     void ensureBuffers(int w, int h);
+    uint32_t nextRandom();
 };
 
 #endif // AVSWATER_H
@@ -9,6 +9,7 @@
 #include "ui_desktopplayerwindow.h"
 #include "scale.h"
 #include "util.h"
+#include "framescheduler.h"
 #include "screensaverview.h"
 
 #ifdef IS_EMBEDDED
@@ -31,12 +32,13 @@
 #include <QMessageBox>
 #include <QDebug>
 
+// At 1x; UI_SCALE is only known once the application is up
 #ifdef IS_EMBEDDED
-const unsigned int WINDOW_W = 320 * UI_SCALE;
-const unsigned int WINDOW_H = 100 * UI_SCALE;
+const unsigned int WINDOW_W = 320;
+const unsigned int WINDOW_H = 100;
 #else
-const unsigned int WINDOW_W = 277 * UI_SCALE;
-const unsigned int WINDOW_H = 117 * UI_SCALE;
+const unsigned int WINDOW_W = 277;
+const unsigned int WINDOW_H = 117;
 #endif
 
 #define PY_SSIZE_T_CLEAN
@@ -168,6 +170,15 @@ MainWindow::MainWindow(QWidget *parent)
     geissVisualizer->setAttribute(Qt::WidgetAttribute::WA_StyledBackground, true);
     connect(geissVisualizer, &GeissWidget::userActivityDetected, this, &MainWindow::deactivateScreenSaver);
 
+    // Slow the animated views down before the SoC gets hot enough to throttle
+    thermalMonitor = new ThermalMonitor(QString(), this);
+    connect(thermalMonitor, &ThermalMonitor::frameRateCapChanged, screenSaver, &ScreenSaverView::setFrameRateCap);
+    connect(thermalMonitor, &ThermalMonitor::frameRateCapChanged, avsView, &AvsView::setFrameRateCap);
+    connect(thermalMonitor, &ThermalMonitor::frameRateCapChanged, geissVisualizer, &GeissWidget::setFrameRateCap);
+    screenSaver->setFrameRateCap(thermalMonitor->frameRateCap());
+    avsView->setFrameRateCap(thermalMonitor->frameRateCap());
+    geissVisualizer->setFrameRateCap(thermalMonitor->frameRateCap());
+
     // Prepare navigation stack
     viewStack = new QStackedLayout;
     viewStack->addWidget(playerWindow);     // Index 0
@@ -187,14 +198,17 @@ MainWindow::MainWindow(QWidget *parent)
 
     setCentralWidget(centralWidget);
 
-    // Crossfade transition for visualizer views
+    // Crossfade transition for visualizer views; these hand over their
+    // frames rather than being grabbed
     viewTransition = new ViewTransition(centralWidget, viewStack, this);
+    viewTransition->setFrameSource(avsView, [this] { return avsView->lastFrame(); });
+    viewTransition->setFrameSource(geissVisualizer, [this] { return geissVisualizer->lastFrame(); });
 
-    resize(WINDOW_W, WINDOW_H);
-    this->setMaximumWidth(WINDOW_W);
-    this->setMaximumHeight(WINDOW_H);
-    this->setMinimumWidth(WINDOW_W);
-    this->setMinimumHeight(WINDOW_H);
+    resize(WINDOW_W * UI_SCALE, WINDOW_H * UI_SCALE);
+    this->setMaximumWidth(WINDOW_W * UI_SCALE);
+    this->setMaximumHeight(WINDOW_H * UI_SCALE);
+    this->setMinimumWidth(WINDOW_W * UI_SCALE);
+    this->setMinimumHeight(WINDOW_H * UI_SCALE);
 
     #ifndef IS_EMBEDDED
     setWindowFlags(Qt::CustomizeWindowHint);
@@ -643,3 +657,74 @@ bool MainWindow::apiVbanState() const
 {
     return vbanSender ? vbanSender->isEnabled() : false;
 }
+
+QJsonObject MainWindow::apiAvsStats() const
+{
+    const AvsRenderThread::Status r = avsView->renderStatus();
+    const AvsEngine::Stats &s = r.stats;
+    QJsonObject o;
+    o["ok"] = true;
+    o["preset"] = r.presetName;
+    o["buffers"] = s.buffers;
+    o["bufferBytes"] = static_cast<qint64>(s.bufferBytes);
+    o["effectBytes"] = static_cast<qint64>(s.effectBytes);
+    o["copiesPerFrame"] = s.copiesPerFrame;
+    o["fusedRuns"] = s.fusedRuns;
+    o["fusedEffects"] = s.fusedEffects;
+    o["threads"] = s.threads;
+    o["tiledEffects"] = s.tiledEffects;
+    o["frames"] = static_cast<qint64>(r.frames);
+    o["missedFrames"] = static_cast<qint64>(r.missed);
+    o["droppedFrames"] = static_cast<qint64>(r.dropped);
+    o["quality"] = QualityGovernor::levelName(r.quality);
+    o["qualityForced"] = r.qualityForced;
+    o["frameCostUs"] = r.frameCostUs;
+    return o;
+}
+
+QJsonObject MainWindow::apiGeissStats() const
+{
+    const QualityGovernor &q = geissVisualizer->quality();
+    QJsonObject o;
+    o["ok"] = true;
+    o["quality"] = QualityGovernor::levelName(q.level());
+    o["qualityForced"] = q.isForced();
+    o["frameCostUs"] = static_cast<qint64>(q.averageCostUs());
+    o["fps"] = 1000000 / q.frameIntervalUs();
+    return o;
+}
+
+QJsonObject MainWindow::apiScreensaverStats() const
+{
+    QJsonObject o;
+    o["ok"] = true;
+    o["active"] = screenSaverActive;
+    o["face"] = screenSaver->faceName();
+    o["paintCostUs"] = screenSaver->paintCostUs();
+    o["layerRenders"] = static_cast<qint64>(screenSaver->layerRenders());
+    o["idleTicks"] = static_cast<qint64>(screenSaver->idleTicks());
+    return o;
+}
+
+QJsonObject MainWindow::apiFrameStats() const
+{
+    QJsonArray subscribers;
+    for (const FrameScheduler::Stats &s : FrameScheduler::instance().stats()) {
+        QJsonObject sub;
+        sub["name"] = s.name;
+        sub["visible"] = s.visible;
+        sub["active"] = s.active;
+        sub["intervalUs"] = s.intervalUs;
+        sub["ticks"] = static_cast<qint64>(s.ticks);
+        sub["late"] = static_cast<qint64>(s.late);
+        sub["paints"] = static_cast<qint64>(s.paints);
+        sub["tickCostUs"] = static_cast<qint64>(s.tickCostUs);
+        sub["paintCostUs"] = static_cast<qint64>(s.paintCostUs);
+        subscribers.append(sub);
+    }
+    QJsonObject o;
+    o["ok"] = true;
+    o["clockHz"] = FrameScheduler::CLOCK_HZ;
+    o["subscribers"] = subscribers;
+    return o;
+}
@@ -25,6 +25,7 @@
 #include "viewtransition.h"
 #include "mediaplayer.h"
 #include "vbansender.h"
+#include "thermalmonitor.h"
 
 // Screensaver timeout in milliseconds (5 minutes default)
 #define SCREENSAVER_TIMEOUT_MS (5 * 60 * 1000)
@@ -61,6 +62,12 @@ public:
     void apiVban(bool on);
     bool apiVbanState() const;
 
+    // Web API: visualizer diagnostics
+    QJsonObject apiAvsStats() const;
+    QJsonObject apiGeissStats() const;
+    QJsonObject apiScreensaverStats() const;
+    QJsonObject apiFrameStats() const;
+
     QStackedLayout *viewStack;
 
     PlayerView *player;
@@ -106,6 +113,7 @@ private:
     ScreenSaverView *screenSaver = nullptr;
     GeissWidget *geissVisualizer = nullptr;
     ViewTransition *viewTransition = nullptr;
+    ThermalMonitor *thermalMonitor = nullptr;
     QTimer *screenSaverTimer = nullptr;
     bool screenSaverActive = false;
     bool geissActive = false;
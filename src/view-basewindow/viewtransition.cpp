@@ -1,5 +1,49 @@
 #include "viewtransition.h"
+#include "framescheduler.h"
+#include "pixelkernels.h"
+#include <QPainter>
 #include <QPixmap>
+#include <algorithm>
+#include <cstring>
+
+// Shows the blended frame over the whole container. It is opaque, so the
+// views it covers aren't painted, and lets clicks through to the new view.
+class TransitionOverlay : public QWidget
+{
+public:
+    explicit TransitionOverlay(QWidget *parent)
+        : QWidget(parent)
+    {
+        setAttribute(Qt::WA_OpaquePaintEvent);
+        setAttribute(Qt::WA_TransparentForMouseEvents);
+    }
+
+    // buffer = to * (256 - alpha) / 256 + from * alpha / 256, both the
+    // overlay's size in RGB32
+    void blend(const QImage &to, const QImage &from, int alpha)
+    {
+        if (m_buffer.size() != size())
+            m_buffer = QImage(size(), QImage::Format_RGB32);
+        const int w = m_buffer.width();
+        for (int y = 0; y < m_buffer.height(); y++) {
+            uint32_t *dst = reinterpret_cast<uint32_t *>(m_buffer.scanLine(y));
+            std::memcpy(dst, to.constScanLine(y), w * 4);
+            PixelKernels::alphaBlend(dst, reinterpret_cast<const uint32_t *>(from.constScanLine(y)), w, alpha);
+        }
+        update();
+    }
+
+protected:
+    void paintEvent(QPaintEvent *) override
+    {
+        FrameScheduler::PaintTimer timed(this);
+        QPainter painter(this);
+        painter.drawImage(QPoint(0, 0), m_buffer);
+    }
+
+private:
+    QImage m_buffer;
+};
 
 ViewTransition::ViewTransition(QWidget *container, QStackedLayout *stack, QObject *parent)
     : QObject(parent)
@@ -8,62 +52,84 @@ ViewTransition::ViewTransition(QWidget *container, QStackedLayout *stack, QObjec
 {
 }
 
+void ViewTransition::setFrameSource(QWidget *view, const FrameSource &source)
+{
+    m_sources.insert(view, source);
+}
+
+QImage ViewTransition::fit(QImage frame) const
+{
+    const QSize size = m_container->size();
+    if (frame.isNull()) {
+        frame = QImage(size, QImage::Format_RGB32);
+        frame.fill(Qt::black);
+        return frame;
+    }
+    // Visualizer frames come at the view's size; one from before a resize
+    // is stretched like the views themselves do
+    if (frame.size() != size)
+        frame = frame.scaled(size, Qt::IgnoreAspectRatio, Qt::FastTransformation);
+    return frame.convertToFormat(QImage::Format_RGB32);
+}
+
+QImage ViewTransition::capture(QWidget *view) const
+{
+    auto source = m_sources.constFind(view);
+    if (source != m_sources.constEnd())
+        return fit((*source)());
+    return fit(view ? view->grab().toImage() : QImage());
+}
+
 void ViewTransition::fadeTo(int targetIndex, int durationMs)
 {
-    if (m_transitioning) {
-        // Already animating — just snap to the new target
-        if (m_animation) m_animation->stop();
-        onFadeFinished();
+    if (m_overlay || durationMs <= 0) {
+        // Already animating, or no fade asked for — just snap to the target
+        finish();
         m_stack->setCurrentIndex(targetIndex);
         return;
     }
 
-    // Grab a screenshot of the current view
-    QPixmap snapshot = m_container->grab();
+    // The outgoing view as last shown; a visualizer isn't asked to render
+    // an extra frame for it
+    m_from = capture(m_stack->currentWidget());
 
     // Swap the stack instantly (hidden behind the overlay)
     m_stack->setCurrentIndex(targetIndex);
+    QWidget *to = m_stack->currentWidget();
+    m_toSource = m_sources.value(to);
+    m_to = m_toSource ? QImage() : capture(to);
 
-    // Create overlay label showing the snapshot
-    m_overlay = new QLabel(m_container);
-    m_overlay->setPixmap(snapshot);
+    m_overlay = new TransitionOverlay(m_container);
     m_overlay->setGeometry(m_container->rect());
-    m_overlay->setAttribute(Qt::WA_TransparentForMouseEvents);
+    m_durationMs = durationMs;
+    m_clock.start();
+    step(); // so the first paint already has a frame
     m_overlay->show();
     m_overlay->raise();
+    FrameScheduler::instance().subscribe(m_overlay, "transition", 33333, [this] { step(); });
+}
 
-    // Apply opacity effect
-    m_effect = new QGraphicsOpacityEffect(m_overlay);
-    m_effect->setOpacity(1.0);
-    m_overlay->setGraphicsEffect(m_effect);
-
-    // Animate opacity 1.0 → 0.0
-    m_animation = new QPropertyAnimation(m_effect, "opacity", this);
-    m_animation->setDuration(durationMs);
-    m_animation->setStartValue(1.0);
-    m_animation->setEndValue(0.0);
-    m_animation->setEasingCurve(QEasingCurve::InOutQuad);
-
-    connect(m_animation, &QPropertyAnimation::finished, this, &ViewTransition::onFadeFinished);
+void ViewTransition::step()
+{
+    const double t = static_cast<double>(m_clock.elapsed()) / m_durationMs;
+    if (t >= 1.0) {
+        finish();
+        return;
+    }
 
-    m_transitioning = true;
-    m_animation->start();
+    // Weight of the outgoing view, 256 down to 0
+    const int alpha = static_cast<int>((1.0 - m_curve.valueForProgress(t)) * 256.0 + 0.5);
+    m_overlay->blend(m_toSource ? fit(m_toSource()) : m_to, m_from, alpha);
 }
 
-void ViewTransition::onFadeFinished()
+void ViewTransition::finish()
 {
-    m_transitioning = false;
-
     if (m_overlay) {
         m_overlay->hide();
         m_overlay->deleteLater();
         m_overlay = nullptr;
     }
-
-    m_effect = nullptr; // Owned by m_overlay, deleted with it
-
-    if (m_animation) {
-        m_animation->deleteLater();
-        m_animation = nullptr;
-    }
+    m_from = QImage();
+    m_to = QImage();
+    m_toSource = nullptr;
 }
@@ -2,31 +2,57 @@
 #define VIEWTRANSITION_H
 
 #include <QWidget>
-#include <QLabel>
 #include <QStackedLayout>
-#include <QGraphicsOpacityEffect>
-#include <QPropertyAnimation>
+#include <QElapsedTimer>
+#include <QEasingCurve>
+#include <QHash>
+#include <QImage>
+#include <functional>
 
+class TransitionOverlay;
+
+// Crossfades between views of the stack. The outgoing view is captured
+// once: visualizers hand over the frame they last rendered, other views are
+// grabbed, which is cheap for plain widgets. An opaque overlay then blends
+// it with the incoming view into one buffer every frame
+// (PixelKernels::alphaBlend), with an incoming visualizer's frames kept
+// live. The views underneath are covered, so Qt doesn't paint them during
+// the fade.
 class ViewTransition : public QObject
 {
     Q_OBJECT
 public:
+    // Returns the view's current frame, ideally at its size; a null image
+    // means nothing to show yet
+    using FrameSource = std::function<QImage()>;
+
     explicit ViewTransition(QWidget *container, QStackedLayout *stack, QObject *parent = nullptr);
 
+    // Transitions take view's frames from source instead of grabbing it
+    void setFrameSource(QWidget *view, const FrameSource &source);
+
     // Crossfade to targetIndex over durationMs. Falls back to instant swap if
     // a transition is already in progress.
     void fadeTo(int targetIndex, int durationMs = 2000);
 
-private slots:
-    void onFadeFinished();
-
 private:
+    // The view's current frame as an RGB32 image the size of the container
+    QImage capture(QWidget *view) const;
+    QImage fit(QImage frame) const;
+    void step();
+    void finish();
+
     QWidget *m_container;
     QStackedLayout *m_stack;
-    QLabel *m_overlay = nullptr;
-    QGraphicsOpacityEffect *m_effect = nullptr;
-    QPropertyAnimation *m_animation = nullptr;
-    bool m_transitioning = false;
+    QHash<QWidget *, FrameSource> m_sources;
+
+    TransitionOverlay *m_overlay = nullptr;
+    QImage m_from;
+    QImage m_to;            // when the incoming view has no frame source
+    FrameSource m_toSource; // otherwise
+    QElapsedTimer m_clock;
+    int m_durationMs = 0;
+    QEasingCurve m_curve{QEasingCurve::InOutQuad};
 };
 
 #endif // VIEWTRANSITION_H
@@ -55,6 +55,16 @@ void EffectEngine::selectEffects(bool hasSoundData)
     m_waveformEffects[m_waveformMode]->activate();
 }
 
+void EffectEngine::setQualityLevel(int level)
+{
+    for (auto& slot : m_overlayEffects)
+        slot.effect->qualityLevel = level;
+    for (auto& effect : m_waveformEffects)
+        effect->qualityLevel = level;
+    if (m_nuclide)
+        m_nuclide->qualityLevel = level;
+}
+
 void EffectEngine::renderOverlays(uint32_t* fb, int width, int height,
                                   const AudioAnalyzer& audio, float frame)
 {
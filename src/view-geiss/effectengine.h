@@ -21,6 +21,8 @@ public:
                         const AudioAnalyzer& audio, float frame);
 
     int waveformMode() const { return m_waveformMode; }
+    // QualityGovernor::Level passed on to every effect
+    void setQualityLevel(int level);
 
 private:
     struct EffectSlot {
@@ -1,5 +1,6 @@
 #include "radialwaveeffect.h"
 #include "../audioanalyzer.h"
+#include "rasterizer.h"
 #include <cmath>
 #include <cstring>
 #include <algorithm>
@@ -33,15 +34,16 @@ void RadialWaveEffect::render(uint32_t* fb, int width, int height,
     int waveSize = audio.waveformSize();
     const float* wL = audio.smoothWaveL();
 
+    Rasterizer::Point pts[314];
     for (int i = 0; i < 314; i++) {
         float rad = baseRad + wL[i % waveSize] * height * 0.3f;
         rad = m_prevRad[i] * 0.5f + rad * 0.5f;
         m_prevRad[i] = rad;
 
         float angle = i * (2.0f * (float)M_PI / 314.0f);
-        int x = cx + (int)(rad * cosf(angle));
-        int y = cy + (int)(rad * sinf(angle));
-
-        GeissPixel::additiveSafe(fb, x, y, width, height, r, g, b);
+        pts[i] = {cx + (int)(rad * cosf(angle)), cy + (int)(rad * sinf(angle))};
     }
+
+    Rasterizer::points({fb, width, height}, pts, 314,
+                       Rasterizer::Max{GeissPixel::rgb(r, g, b)});
 }
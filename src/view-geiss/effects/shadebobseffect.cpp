@@ -1,6 +1,7 @@
 #include "shadebobseffect.h"
 #include "../audioanalyzer.h"
 #include "../warpparams.h"
+#include "qualitygovernor.h"
 #include <cmath>
 #include <cstdlib>
 #include <algorithm>
@@ -60,8 +61,9 @@ void ShadeBobsEffect::render(uint32_t* fb, int width, int height,
         uint8_t pg = cg ? 5 : 0;
         uint8_t pb = cb ? 5 : 0;
 
-        // Draw at 4 jittered positions
-        for (int j = 0; j < 4; j++) {
+        // Draw at 4 jittered positions, 2 when particles are cut
+        int jitters = qualityLevel >= QualityGovernor::FewerParticles ? 2 : 4;
+        for (int j = 0; j < jitters; j++) {
             int jx = (int)bx + (rand() % 5) - 2;
             int jy = (int)by + (rand() % 5) - 2;
             GeissPixel::accumulateSafe(fb, jx, jy, width, height, pr, pg, pb);
@@ -1,5 +1,6 @@
 #include "solarparticles.h"
 #include "../audioanalyzer.h"
+#include "qualitygovernor.h"
 #include <cmath>
 #include <cstdlib>
 #include <algorithm>
@@ -18,6 +19,8 @@ void SolarParticles::render(uint32_t* fb, int width, int height,
                             const AudioAnalyzer& audio, float frame)
 {
     int n = 15 + (int)(audio.currentVol() * 30.0f);
+    if (qualityLevel >= QualityGovernor::FewerParticles)
+        n /= 2;
     int cx = width / 2;
     int cy = height / 2;
     float maxRad = std::min(width, height) * 0.25f;
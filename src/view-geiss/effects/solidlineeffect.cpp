@@ -42,25 +42,10 @@ void SolidLineEffect::renderLine(uint32_t* fb, int w, int h, float t, Channel ch
         if (px < 0 || px >= w || py < 0 || py >= h)
             continue;
 
-        int offset = py * w + px;
-        uint8_t* p = reinterpret_cast<uint8_t*>(&fb[offset]);
-
-        // Qt Format_RGB32 little-endian: byte[0]=B, byte[1]=G, byte[2]=R
-        switch (channel) {
-        case RED:
-            p[GeissPixel::CH_R] = std::min(255, (int)p[GeissPixel::CH_R] + 16);
-            break;
-        case GREEN:
-            p[GeissPixel::CH_G] = std::min(255, (int)p[GeissPixel::CH_G] + 16);
-            break;
-        case BLUE:
-            p[GeissPixel::CH_B] = std::min(255, (int)p[GeissPixel::CH_B] + 16);
-            break;
-        case ALL:
-            p[GeissPixel::CH_R] = std::min(255, (int)p[GeissPixel::CH_R] + 16);
-            p[GeissPixel::CH_G] = std::min(255, (int)p[GeissPixel::CH_G] + 16);
-            p[GeissPixel::CH_B] = std::min(255, (int)p[GeissPixel::CH_B] + 16);
-            break;
-        }
+        uint8_t add = 16;
+        GeissPixel::accumulate(fb, py * w + px,
+                               (channel == RED || channel == ALL) ? add : 0,
+                               (channel == GREEN || channel == ALL) ? add : 0,
+                               (channel == BLUE || channel == ALL) ? add : 0);
     }
 }
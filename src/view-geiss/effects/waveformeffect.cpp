@@ -1,5 +1,6 @@
 #include "waveformeffect.h"
 #include "../audioanalyzer.h"
+#include "rasterizer.h"
 #include <cmath>
 #include <cstring>
 #include <algorithm>
@@ -23,43 +24,46 @@ void WaveformEffect::render(uint32_t* fb, int width, int height,
     uint8_t r, g, b;
     m_color.getColor(frame, base, r, g, b);
 
-    int n = audio.waveformSize();
+    int n = std::min(audio.waveformSize(), MAX_POINTS);
     const float* wL = audio.smoothWaveL();
     const float* wR = audio.smoothWaveR();
 
+    // Collect the dots and draw them in one batch
+    Rasterizer::Point* pts = m_points;
+    int count = 0;
+
     if (m_mode == 0) {
         // Horizontal oscilloscope
-        int count = std::min(n, width - 2);
-        for (int i = 1; i < count; i++) {
+        int last = std::min(n, width - 2);
+        for (int i = 1; i < last; i++) {
             float z = wL[i] * height * 0.4f + height / 2.0f;
             z = m_prevZ[i] * 0.9f + z * 0.1f;
             m_prevZ[i] = z;
-            int y = std::clamp((int)z, 1, height - 2);
-            GeissPixel::additiveSafe(fb, i, y, width, height, r, g, b);
+            pts[count++] = {i, std::clamp((int)z, 1, height - 2)};
         }
     } else if (m_mode == 1) {
         // Stereo mode
-        int count = std::min(n, width - 2);
+        int last = std::min(n, width - 2);
         int yOffL = (int)(height * 0.35f);
         int yOffR = (int)(height * 0.65f);
-        for (int i = 1; i < count; i++) {
+        for (int i = 1; i < last; i++) {
             float zL = wL[i] * height * 0.2f + yOffL;
             zL = m_prevZ[i] * 0.9f + zL * 0.1f;
             m_prevZ[i] = zL;
-            int yL = std::clamp((int)zL, 1, height - 2);
-            GeissPixel::additiveSafe(fb, i, yL, width, height, r, g, b);
+            pts[count++] = {i, std::clamp((int)zL, 1, height - 2)};
 
             float zR = wR[i] * height * 0.2f + yOffR;
-            int yR = std::clamp((int)zR, 1, height - 2);
-            GeissPixel::additiveSafe(fb, i, yR, width, height, r, g, b);
+            pts[count++] = {i, std::clamp((int)zR, 1, height - 2)};
         }
     } else if (m_mode == 2) {
         // Vertical mode
-        int count = std::min(n, height - 2);
-        for (int i = 1; i < count; i++) {
+        int last = std::min(n, height - 2);
+        for (int i = 1; i < last; i++) {
             float xf = wL[i] * width * 0.3f + width / 2.0f;
-            int x = std::clamp((int)xf, 1, width - 2);
-            GeissPixel::additiveSafe(fb, x, i, width, height, r, g, b);
+            pts[count++] = {std::clamp((int)xf, 1, width - 2), i};
         }
     }
+
+    Rasterizer::points({fb, width, height}, pts, count,
+                       Rasterizer::Max{GeissPixel::rgb(r, g, b)});
 }
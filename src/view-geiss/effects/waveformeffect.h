@@ -3,6 +3,7 @@
 
 #include "../geisseffect.h"
 #include "../colorstate.h"
+#include "rasterizer.h"
 
 class WaveformEffect : public GeissEffect {
 public:
@@ -14,8 +15,11 @@ public:
 
 private:
     ColorState m_color;
+    static constexpr int MAX_POINTS = 512;
+
     int m_mode; // 0=horizontal, 1=stereo, 2=vertical
-    float m_prevZ[512];
+    float m_prevZ[MAX_POINTS];
+    Rasterizer::Point m_points[2 * MAX_POINTS];
 };
 
 #endif // WAVEFORMEFFECT_H
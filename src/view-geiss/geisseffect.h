@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <algorithm>
 #include "warpparams.h"
+#include "pixelkernels.h"
 
 class AudioAnalyzer;
 
@@ -13,20 +14,19 @@ namespace GeissPixel {
     static constexpr int CH_G = 1;
     static constexpr int CH_R = 2;
 
+    // Alpha stays 0 so the kernels below leave the existing alpha alone
+    inline uint32_t rgb(uint8_t r, uint8_t g, uint8_t b) {
+        return (uint32_t(r) << 16) | (uint32_t(g) << 8) | b;
+    }
+
     // Additive write: max(existing, value) — never darkens
     inline void additive(uint32_t* fb, int offset, uint8_t r, uint8_t g, uint8_t b) {
-        uint8_t* p = reinterpret_cast<uint8_t*>(&fb[offset]);
-        if (r > p[CH_R]) p[CH_R] = r;
-        if (g > p[CH_G]) p[CH_G] = g;
-        if (b > p[CH_B]) p[CH_B] = b;
+        fb[offset] = PixelKernels::maxPixel(fb[offset], rgb(r, g, b));
     }
 
     // Accumulative write: saturating add
     inline void accumulate(uint32_t* fb, int offset, uint8_t r, uint8_t g, uint8_t b) {
-        uint8_t* p = reinterpret_cast<uint8_t*>(&fb[offset]);
-        p[CH_R] = std::min(255, (int)p[CH_R] + r);
-        p[CH_G] = std::min(255, (int)p[CH_G] + g);
-        p[CH_B] = std::min(255, (int)p[CH_B] + b);
+        fb[offset] = PixelKernels::addSaturate(fb[offset], rgb(r, g, b));
     }
 
     // Bounds-checked additive write
@@ -53,6 +53,8 @@ public:
 
     virtual void activate() {}
     virtual void deactivate() {}
+
+    int qualityLevel = 0; // QualityGovernor::Level, set by EffectEngine
 };
 
 #endif // GEISSEFFECT_H
@@ -1,8 +1,14 @@
 #include "geisswidget.h"
+#include "pixelkernels.h"
+#include "framescheduler.h"
 
 #include <QPainter>
 #include <QMouseEvent>
 #include <QKeyEvent>
+#include <QElapsedTimer>
+#include <QSettings>
+#include <QDebug>
+#include <algorithm>
 #include <cstring>
 
 GeissWidget::GeissWidget(QWidget *parent)
@@ -10,6 +16,7 @@ GeissWidget::GeissWidget(QWidget *parent)
 {
     qRegisterMetaType<std::vector<WarpEntry>>("std::vector<WarpEntry>");
     setFocusPolicy(Qt::StrongFocus);
+    setAttribute(Qt::WA_OpaquePaintEvent);
 
     // Initialize framebuffers
     m_fb[0] = QImage(FB_W, FB_H, QImage::Format_RGB32);
@@ -31,11 +38,19 @@ GeissWidget::GeissWidget(QWidget *parent)
     connect(m_mapGen, &WarpMapGenerator::mapReady, this, &GeissWidget::onMapReady);
     startGeneratingNextMap();
 
-    // Frame timer at ~30 FPS
-    m_frameTimer = new QTimer(this);
-    m_frameTimer->setInterval(33);
-    connect(m_frameTimer, &QTimer::timeout, this, &GeissWidget::onFrameTick);
-    m_frameTimer->start();
+    // Quality is governed by frame time unless pinned ("full", "particles",
+    // "fps25", "fps20" or "auto")
+    QString quality = QSettings().value("geiss/quality", "auto").toString().toLower();
+    int forced = QualityGovernor::parseLevel(quality.toUtf8().constData());
+    if (forced == QualityGovernor::INVALID)
+        qWarning() << "[geiss] unknown quality" << quality;
+    else
+        m_governor.setForcedLevel(forced);
+    m_effects.setQualityLevel(m_governor.level());
+
+    // Frames at ~30 FPS, slowed by the governor at its last levels, and
+    // only while the view is on screen
+    FrameScheduler::instance().subscribe(this, "geiss", frameIntervalUs(), [this] { onFrameTick(); });
 }
 
 GeissWidget::~GeissWidget()
@@ -51,6 +66,21 @@ void GeissWidget::feedAudio(const QByteArray& data, QAudioFormat format)
     m_audio.process(data, format);
 }
 
+void GeissWidget::setFrameRateCap(int fps)
+{
+    m_frameRateCap = fps;
+    FrameScheduler::instance().setInterval(this, frameIntervalUs());
+}
+
+// The governor's interval, stretched to the thermal cap
+int GeissWidget::frameIntervalUs() const
+{
+    int interval = m_governor.frameIntervalUs();
+    if (m_frameRateCap > 0)
+        interval = std::max(interval, 1000000 / m_frameRateCap);
+    return interval;
+}
+
 void GeissWidget::initWarpMap()
 {
     // Generate default inward-zoom + rotation map on the main thread
@@ -122,7 +152,11 @@ void GeissWidget::onMapReady(std::vector<WarpEntry> newMap)
 
 void GeissWidget::onFrameTick()
 {
-    m_frame += 1.0f;
+    QElapsedTimer cost;
+    cost.start();
+
+    // Effects animate on m_frame, so keep their speed when the rate drops
+    m_frame += static_cast<float>(frameIntervalUs()) / FRAME_INTERVAL_US;
     m_framesSinceSwap++;
 
     // --- Warp map swap logic ---
@@ -171,18 +205,40 @@ void GeissWidget::onFrameTick()
 
     // --- Swap framebuffers ---
     m_activeFB = dstIdx;
+    m_scaledStale = true;
+
+    // --- Adjust quality to the measured frame cost ---
+    if (m_governor.addFrame(cost.nsecsElapsed() / 1000)) {
+        m_effects.setQualityLevel(m_governor.level());
+        FrameScheduler::instance().setInterval(this, frameIntervalUs());
+    }
 
     // --- Trigger repaint ---
     update();
 }
 
+const QImage &GeissWidget::lastFrame()
+{
+    // Scale the small framebuffer up to the widget once per frame, so
+    // repaints in between and the blit itself are plain copies
+    if (m_scaledStale || m_scaled.size() != size()) {
+        if (m_scaled.size() != size())
+            m_scaled = QImage(size(), QImage::Format_RGB32);
+        const QImage &fb = m_fb[m_activeFB];
+        PixelKernels::scaleNearest(reinterpret_cast<const uint32_t *>(fb.constBits()),
+                                   fb.width(), fb.height(), fb.bytesPerLine() / 4,
+                                   reinterpret_cast<uint32_t *>(m_scaled.bits()),
+                                   m_scaled.width(), m_scaled.height(), m_scaled.bytesPerLine() / 4);
+        m_scaledStale = false;
+    }
+    return m_scaled;
+}
+
 void GeissWidget::paintEvent(QPaintEvent *)
 {
+    FrameScheduler::PaintTimer timed(this);
     QPainter painter(this);
-    painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
-
-    // Scale the small framebuffer to fill the widget
-    painter.drawImage(rect(), m_fb[m_activeFB]);
+    painter.drawImage(QPoint(0, 0), lastFrame());
 }
 
 void GeissWidget::mousePressEvent(QMouseEvent *event)
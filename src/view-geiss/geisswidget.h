@@ -3,7 +3,6 @@
 
 #include <QWidget>
 #include <QImage>
-#include <QTimer>
 #include <QByteArray>
 #include <QAudioFormat>
 #include <vector>
@@ -14,6 +13,7 @@
 #include "warpengine.h"
 #include "effectengine.h"
 #include "warpmapgenerator.h"
+#include "qualitygovernor.h"
 
 class GeissWidget : public QWidget
 {
@@ -22,8 +22,14 @@ public:
     explicit GeissWidget(QWidget *parent = nullptr);
     ~GeissWidget() override;
 
+    // Frame-time governor state, for the API
+    const QualityGovernor &quality() const { return m_governor; }
+    // The current frame at widget size, as painted
+    const QImage &lastFrame();
+
 public slots:
     void feedAudio(const QByteArray& data, QAudioFormat format);
+    void setFrameRateCap(int fps); // thermal limit, 0 = none
 
 signals:
     void userActivityDetected();
@@ -41,10 +47,14 @@ private:
     void initWarpMap();
     void startGeneratingNextMap();
     void selectNewEffects();
+    int frameIntervalUs() const;
 
     // Framebuffers (ping-pong)
     QImage m_fb[2];
     int m_activeFB = 0;
+    // The active framebuffer at widget size, redone after each frame
+    QImage m_scaled;
+    bool m_scaledStale = true;
 
     // Components
     AudioAnalyzer m_audio;
@@ -61,7 +71,10 @@ private:
     WarpParams m_currentParams;
 
     // Frame state
-    QTimer *m_frameTimer = nullptr;
+    static constexpr int FRAME_INTERVAL_US = 33333; // 30 FPS at full quality
+    // Geiss has no multi-pass effects, so the governor skips that level
+    QualityGovernor m_governor{FRAME_INTERVAL_US, QualityGovernor::ALL_LEVELS & ~(1u << QualityGovernor::FewerPasses)};
+    int m_frameRateCap = 0;
     float m_frame = 0.0f;
     int m_framesSinceSwap = 0;
     static constexpr int FRAMES_TIL_AUTO_SWITCH = 300; // ~10 seconds at 30fps
@@ -2,6 +2,7 @@
 #include "ui_playerview.h"
 
 #include "scale.h"
+#include "skinatlas.h"
 #include "util.h"
 
 #include <QApplication>
@@ -204,25 +205,24 @@ void PlayerView::scale()
 
 void PlayerView::setPlaybackState(MediaPlayer::PlaybackState state)
 {
-    QString imageSrc;
+    QString sprite;
     switch(state) {
     case MediaPlayer::StoppedState:
         if(spectrum) spectrum->stop();
-        imageSrc = ":/assets/status_stopped.png";
+        sprite = "status_stopped";
         break;
     case MediaPlayer::PlayingState:
         if(spectrum) spectrum->play();
-        imageSrc = ":/assets/status_playing.png";
+        sprite = "status_playing";
         break;
     case MediaPlayer::PausedState:
         if(spectrum) spectrum->pause();
-        imageSrc = ":/assets/status_paused.png";
+        sprite = "status_paused";
         break;
     }
 
-    // Set play status icon
-    QPixmap image;
-    image.load(imageSrc);
+    // Set play status icon, already at UI_SCALE
+    QPixmap image = SkinAtlas::instance().sprite(sprite);
     QGraphicsScene *scene = new QGraphicsScene(this);
     scene->addPixmap(image);
     scene->setSceneRect(image.rect());
@@ -1,5 +1,9 @@
 #include "scrolltext.h"
+#include "framescheduler.h"
+#include <QEvent>
 #include <QPainter>
+#include <algorithm>
+#include <cmath>
 
 
 ScrollText::ScrollText(QWidget *parent) :
@@ -9,10 +13,11 @@ ScrollText::ScrollText(QWidget *parent) :
 
     leftMargin = height() / 3;
 
-    setSeparator(" --- ");
+    // Scrolls at 20 Hz, started by updateText() when the text is too long
+    FrameScheduler::instance().subscribe(this, "scrolltext", 50000, [this] { timer_timeout(); });
+    FrameScheduler::instance().setActive(this, false);
 
-    connect(&timer, SIGNAL(timeout()), this, SLOT(timer_timeout()));
-    timer.setInterval(50);
+    setSeparator(" --- ");
 }
 
 QString ScrollText::text() const
@@ -41,7 +46,7 @@ void ScrollText::setSeparator(QString separator)
 
 void ScrollText::updateText()
 {
-    timer.stop();
+    FrameScheduler::instance().setActive(this, false);
 
     singleTextWidth = fontMetrics().horizontalAdvance(_text);
     scrollEnabled = (singleTextWidth > width() - leftMargin);
@@ -49,46 +54,47 @@ void ScrollText::updateText()
     if(scrollEnabled)
     {
         scrollPos = -64;
+        scrollClock.start();
         staticText.setText(_text + _separator);
-        timer.start();
+        FrameScheduler::instance().setActive(this, true);
     }
     else
         staticText.setText(_text);
 
     staticText.prepare(QTransform(), font());
     wholeTextSize = QSize(fontMetrics().horizontalAdvance(staticText.text()), fontMetrics().height());
+    stripValid = false;
+}
+
+void ScrollText::renderStrip()
+{
+    strip = QPixmap(qMax(1, wholeTextSize.width()), qMax(1, height()));
+    strip.fill(Qt::transparent);
+    QPainter pb(&strip);
+    pb.setPen(palette().color(foregroundRole()));
+    pb.setFont(font());
+    pb.drawStaticText(QPointF(0, (height() - wholeTextSize.height()) / 2 + 2), staticText);
+    stripValid = true;
 }
 
 void ScrollText::paintEvent(QPaintEvent*)
 {
+    FrameScheduler::PaintTimer timed(this);
     QPainter p(this);
 
     if(scrollEnabled)
     {
-        buffer.fill(qRgba(0, 0, 0, 0));
-        QPainter pb(&buffer);
-        pb.setPen(p.pen());
-        pb.setFont(p.font());
+        if(!stripValid)
+            renderStrip();
 
-        int x = qMin(-scrollPos, 0) + leftMargin;
+        // Copies of the strip side by side from the scroll position: one
+        // blit, or two where the end of the title wraps to its start
+        int x = qMin(-static_cast<int>(std::floor(scrollPos)), 0) + leftMargin + 2;
         while(x < width())
         {
-            pb.drawStaticText(QPointF(x, (height() - wholeTextSize.height()) / 2) + QPoint(2, 2), staticText);
+            p.drawPixmap(x, 0, strip);
             x += wholeTextSize.width();
         }
-
-        //Apply Alpha Channel
-        /*pb.setCompositionMode(QPainter::CompositionMode_DestinationIn);
-        pb.setClipRect(width() - 15, 0, 15, height());
-        pb.drawImage(0, 0, alphaChannel);
-        pb.setClipRect(0, 0, 15, height());
-        //initial situation: don't apply alpha channel in the left half of the image at all; apply it more and more until scrollPos gets positive
-        if(scrollPos < 0)
-            pb.setOpacity((qreal)(qMax(-8, scrollPos) + 8) / 8.0);
-        pb.drawImage(0, 0, alphaChannel);*/
-
-        //pb.end();
-        p.drawImage(0, 0, buffer);
     }
     else
     {
@@ -101,7 +107,7 @@ void ScrollText::resizeEvent(QResizeEvent*)
     //When the widget is resized, we need to update the alpha channel.
 
     alphaChannel = QImage(size(), QImage::Format_ARGB32_Premultiplied);
-    buffer = QImage(size(), QImage::Format_ARGB32_Premultiplied);
+    stripValid = false;
 
     //Create Alpha Channel:
     if(width() > 64)
@@ -126,9 +132,24 @@ void ScrollText::resizeEvent(QResizeEvent*)
         updateText();
 }
 
+void ScrollText::changeEvent(QEvent *event)
+{
+    QWidget::changeEvent(event);
+    if(event->type() == QEvent::FontChange || event->type() == QEvent::PaletteChange)
+        stripValid = false;
+}
+
 void ScrollText::timer_timeout()
 {
-    scrollPos = (scrollPos + 2)
-                % wholeTextSize.width();
-    update();
+    // Speed follows the clock rather than the tick rate; a long gap, e.g.
+    // while the player was hidden, counts as one step
+    const float elapsed = std::min<qint64>(scrollClock.restart(), 100) / 1000.0f;
+    const int before = static_cast<int>(std::floor(scrollPos));
+    scrollPos += elapsed * SCROLL_PX_PER_SEC;
+    if(scrollPos >= wholeTextSize.width())
+        scrollPos = std::fmod(scrollPos, static_cast<float>(wholeTextSize.width()));
+
+    // Only whole pixels show, so sub-pixel steps need no repaint
+    if(static_cast<int>(std::floor(scrollPos)) != before)
+        update();
 }
@@ -3,7 +3,8 @@
 
 #include <QWidget>
 #include <QStaticText>
-#include <QTimer>
+#include <QPixmap>
+#include <QElapsedTimer>
 
 
 class ScrollText : public QWidget
@@ -25,9 +26,11 @@ public slots:
 protected:
     virtual void paintEvent(QPaintEvent *);
     virtual void resizeEvent(QResizeEvent *);
+    virtual void changeEvent(QEvent *);
 
 private:
     void updateText();
+    void renderStrip();
     QString _text;
     QString _separator;
     QStaticText staticText;
@@ -35,10 +38,15 @@ private:
     QSize wholeTextSize;
     int leftMargin;
     bool scrollEnabled;
-    int scrollPos;
+    float scrollPos;            // pixels, negative while holding before scrolling starts
+    QElapsedTimer scrollClock;  // since the last scroll step
     QImage alphaChannel;
-    QImage buffer;
-    QTimer timer;
+    // One copy of text and separator, rendered when either changes; each
+    // frame blits it once, or twice where it wraps around
+    QPixmap strip;
+    bool stripValid = false;
+
+    static constexpr float SCROLL_PX_PER_SEC = 40.0f;
 
 private slots:
     virtual void timer_timeout();
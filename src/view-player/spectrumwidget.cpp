@@ -3,6 +3,7 @@
 #include <QPainter>
 #include <QColor>
 #include "scale.h"
+#include "framescheduler.h"
 
 #define VIS_DELAY 1 /* delay before falloff in frames */
 #define VIS_FALLOFF 4 /* falloff in pixels per frame */
@@ -99,36 +100,36 @@ SpectrumWidget::SpectrumWidget(QWidget *parent)
 {
     clear();
     computeLogXscale(m_xscale, N_BANDS);
-    m_renderTimer = new QTimer(this);
-    m_renderTimer->setInterval(33); // around 30 fps
-    connect(m_renderTimer, &QTimer::timeout, this, QOverload<>::of(&SpectrumWidget::update));
+    // Repaint at around 30 fps while playing
+    FrameScheduler::instance().subscribe(this, "spectrum", 33333, [this] { update(); });
+    FrameScheduler::instance().setActive(this, false);
 }
 
 void SpectrumWidget::play()
 {
     m_playing = true;
-    if(m_renderTimer) m_renderTimer->start();
+    FrameScheduler::instance().setActive(this, true);
 }
 
 void SpectrumWidget::pause()
 {
     m_playing = false;
-    if(m_renderTimer) m_renderTimer->stop();
+    FrameScheduler::instance().setActive(this, false);
 }
 
 void SpectrumWidget::stop()
 {
     m_playing = false;
-    if(m_renderTimer) m_renderTimer->stop();
+    FrameScheduler::instance().setActive(this, false);
     clear();
     this->update();
 }
 
-const unsigned int BG_DOT_SIZE = 1 * UI_SCALE;
-const unsigned int BG_DOT_SPACING = 1 * UI_SCALE;
-
 void SpectrumWidget::paintBackground(QPainter & p)
 {
+    const unsigned int BG_DOT_SIZE = 1 * UI_SCALE;
+    const unsigned int BG_DOT_SPACING = 1 * UI_SCALE;
+
     // Paint the gray pixels behind the spectrum
     // Pixels: 1px*3 x 1px*3
     // Spacing: 1px*3 for both x and y
@@ -151,11 +152,11 @@ void SpectrumWidget::paintBackground(QPainter & p)
     }
 }
 
-const unsigned int BAR_W = 3 * UI_SCALE;
-const unsigned int BAR_SPACING = 1 * UI_SCALE;
-
 void SpectrumWidget::paintSpectrum (QPainter & p)
 {
+    const unsigned int BAR_W = 3 * UI_SCALE;
+    const unsigned int BAR_SPACING = 1 * UI_SCALE;
+
     for (int i = 0; i < N_BANDS; i++) {
         // Bar measures 3px*3 wide, 1px*3 spacing
         int x = (BAR_W * i) + BAR_SPACING*i;
@@ -166,6 +167,8 @@ void SpectrumWidget::paintSpectrum (QPainter & p)
 
 void SpectrumWidget::paintPeaks (QPainter & p)
 {
+    const unsigned int BAR_W = 3 * UI_SCALE;
+    const unsigned int BAR_SPACING = 1 * UI_SCALE;
     const QColor color = QColor::fromRgb(191, 191, 191);
     for (int i = 0; i < N_BANDS; i++) {
         // Peak rectangle measures 3px*3 wide, 1px*3 high, 1px*3 spacing
@@ -178,6 +181,7 @@ void SpectrumWidget::paintPeaks (QPainter & p)
 
 void SpectrumWidget::paintEvent (QPaintEvent *)
 {
+    FrameScheduler::PaintTimer timed(this);
     QPainter p(this);
 
     paintBackground(p);
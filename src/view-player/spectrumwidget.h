@@ -6,7 +6,6 @@
 #define N_BANDS 19
 
 #include <QWidget>
-#include <QTimer>
 
 class SpectrumWidget : public QWidget
 {
@@ -28,7 +27,6 @@ private:
     int m_peakValues[N_BANDS + 1];
     int m_peakDelays[N_BANDS + 1];
     bool m_playing = false;
-    QTimer *m_renderTimer = nullptr;
     QAudioFormat m_format;
 
     void paintBackground(QPainter &);
@@ -121,6 +121,11 @@ struct ClockTheme {
     bool hueCycling             = false;
     float glowIntensity         = 1.0f;
     float breatheAmount         = 0.25f;  // 0 = no breathing, 0.25 = default
+
+    // How often the face's content changes, in ms of wall-clock time aligned
+    // to the epoch. 0 = animated: sweeping hands, colour cycling, moving
+    // sprites; those get every frame. The screensaver sleeps between changes.
+    int updateMs                = 0;
 };
 
 // --- Hand Polygon Generators ---
@@ -722,6 +727,7 @@ inline ClockTheme makeSevenSegTheme()
     t.isDigital = true;
     t.digitalStyle = DigitalStyle::SevenSegment;
     t.colors.secondHand = QColor(31, 227, 255);   // cyan segment color
+    t.updateMs = 1000;
     return t;
 }
 
@@ -731,6 +737,7 @@ inline ClockTheme makeSplitFlapTheme()
     t.name = "Split Flap";
     t.isDigital = true;
     t.digitalStyle = DigitalStyle::SplitFlap;
+    t.updateMs = 1000;
     return t;
 }
 
@@ -741,6 +748,7 @@ inline ClockTheme makeNixieTheme()
     t.isDigital = true;
     t.digitalStyle = DigitalStyle::Nixie;
     t.colors.secondHand = QColor(255, 138, 50);   // nixie orange
+    t.updateMs = 60000;
     return t;
 }
 
@@ -751,6 +759,7 @@ inline ClockTheme makeTerminalTheme()
     t.isDigital = true;
     t.digitalStyle = DigitalStyle::Terminal;
     t.colors.secondHand = QColor(54, 255, 116);   // phosphor green
+    t.updateMs = 500;
     return t;
 }
 
@@ -761,6 +770,7 @@ inline ClockTheme makeVFDTheme()
     t.isDigital = true;
     t.digitalStyle = DigitalStyle::VFD;
     t.colors.secondHand = QColor(52, 231, 200);   // vacuum-fluorescent teal
+    t.updateMs = 500;
     return t;
 }
 
@@ -776,6 +786,7 @@ inline ClockTheme makeWanderingTheme()
     t.colors.secondHand    = QColor(127, 212, 255);
     t.colors.numerals     = QColor(234, 246, 255);
     t.breatheAmount       = 0.0f;
+    t.updateMs            = 1000;
     return t;
 }
 
@@ -807,6 +818,7 @@ inline ClockTheme makeWordClockTheme()
     t.colors.ticks        = QColor(150, 162, 182);   // dim letters
     t.colors.secondHand    = QColor(120, 200, 255);  // glow tint
     t.breatheAmount       = 0.0f;
+    t.updateMs            = 60000;
     return t;
 }
 
@@ -819,6 +831,7 @@ inline ClockTheme makeBerlinUhrTheme()
     t.colors.hourHand     = QColor(255, 59, 48);     // red lamps
     t.colors.minuteHand   = QColor(255, 214, 10);    // yellow lamps
     t.breatheAmount       = 0.0f;
+    t.updateMs            = 1000;
     return t;
 }
 
@@ -843,6 +856,7 @@ inline ClockTheme makeBinaryTheme()
     t.colors.secondHand = QColor(51, 224, 255);      // lit-dot cyan
     t.colors.numerals   = QColor(150, 170, 190);
     t.breatheAmount     = 0.0f;
+    t.updateMs          = 1000;
     return t;
 }
 
@@ -857,6 +871,7 @@ inline ClockTheme makeFibonacciTheme()
     t.colors.secondHand = QColor(74, 163, 255);      // blue = both
     t.colors.ticks      = QColor(23, 25, 32);        // off square
     t.breatheAmount     = 0.0f;
+    t.updateMs          = 60000;
     return t;
 }
 
@@ -867,6 +882,7 @@ inline ClockTheme makeSundialTheme()
     t.sundial = true;
     t.colors.numerals   = QColor(255, 255, 255);
     t.breatheAmount     = 0.0f;
+    t.updateMs          = 60000;
     return t;
 }
 
@@ -878,6 +894,7 @@ inline ClockTheme makeFlipDotTheme()
     t.colors.dial       = QColor(7, 7, 7);
     t.colors.secondHand = QColor(255, 210, 58);      // lit dot amber
     t.breatheAmount     = 0.0f;
+    t.updateMs          = 60000;
     return t;
 }
 
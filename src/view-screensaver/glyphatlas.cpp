@@ -0,0 +1,127 @@
+#include "glyphatlas.h"
+#include "pixelkernels.h"
+#include <QPainter>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    constexpr int ATLAS_WIDTH = 1024;
+    // Room around each cell for antialiasing
+    constexpr int CELL_PADDING = 1;
+}
+
+GlyphAtlas::GlyphAtlas(const QFont &font)
+    : m_font(font)
+    , m_metrics(font)
+{
+}
+
+void GlyphAtlas::setFont(const QFont &font)
+{
+    if (font == m_font)
+        return;
+    m_font = font;
+    m_metrics = QFontMetricsF(font);
+    m_glyphs.clear();
+    m_atlas = QImage();
+    m_shelfX = 0;
+    m_shelfY = 0;
+    m_shelfHeight = 0;
+}
+
+QPoint GlyphAtlas::allocate(const QSize &size)
+{
+    if (m_shelfX + size.width() > ATLAS_WIDTH) {
+        m_shelfX = 0;
+        m_shelfY += m_shelfHeight;
+        m_shelfHeight = 0;
+    }
+    const int needed = m_shelfY + size.height();
+    if (m_atlas.isNull()) {
+        m_atlas = QImage(ATLAS_WIDTH, needed, QImage::Format_ARGB32_Premultiplied);
+        m_atlas.fill(Qt::transparent);
+    } else if (needed > m_atlas.height()) {
+        // copy() fills the part past the old image with zeroes, i.e. transparent
+        m_atlas = m_atlas.copy(0, 0, ATLAS_WIDTH, std::max(m_atlas.height() * 2, needed));
+    }
+    QPoint at(m_shelfX, m_shelfY);
+    m_shelfX += size.width();
+    m_shelfHeight = std::max(m_shelfHeight, size.height());
+    return at;
+}
+
+const GlyphAtlas::Glyph &GlyphAtlas::glyph(QChar c)
+{
+    auto it = m_glyphs.constFind(c);
+    if (it != m_glyphs.constEnd())
+        return *it;
+
+    Glyph g;
+    g.advance = static_cast<int>(std::lround(m_metrics.horizontalAdvance(c)));
+    g.path.addText(0, 0, m_font, QString(c));
+
+    const QRect bounds = g.path.boundingRect().toAlignedRect()
+                             .adjusted(-CELL_PADDING, -CELL_PADDING, CELL_PADDING, CELL_PADDING);
+    if (!g.path.isEmpty() && bounds.width() <= ATLAS_WIDTH) {
+        const QPoint at = allocate(bounds.size());
+        g.cell = QRect(at, bounds.size());
+        g.offset = bounds.topLeft();
+
+        QPainter p(&m_atlas);
+        p.setRenderHint(QPainter::Antialiasing);
+        p.setPen(Qt::NoPen);
+        p.setBrush(Qt::white);
+        p.translate(at - bounds.topLeft());
+        p.drawPath(g.path);
+    }
+    return *m_glyphs.insert(c, g);
+}
+
+int GlyphAtlas::advance(const QString &text)
+{
+    int width = 0;
+    for (QChar c : text)
+        width += glyph(c).advance;
+    return width;
+}
+
+QPainterPath GlyphAtlas::path(const QString &text, const QPointF &origin)
+{
+    QPainterPath out;
+    qreal x = origin.x();
+    for (QChar c : text) {
+        const Glyph &g = glyph(c);
+        if (!g.path.isEmpty())
+            out.addPath(g.path.translated(x, origin.y()));
+        x += g.advance;
+    }
+    return out;
+}
+
+void GlyphAtlas::render(QImage &target, const QString &text, const QPoint &origin)
+{
+    const QRect clip = target.rect();
+    const int targetStride = target.bytesPerLine() / 4;
+    uint32_t *dst = reinterpret_cast<uint32_t *>(target.bits());
+
+    QPoint pen = origin;
+    for (QChar c : text) {
+        const Glyph &g = glyph(c);
+        const QRect full(pen + g.offset, g.cell.size());
+        const QRect placed = full & clip;
+        pen.rx() += g.advance;
+        if (g.cell.isEmpty() || placed.isEmpty())
+            continue;
+
+        // glyph() may have grown the atlas, so take its pixels only now.
+        // Neighbouring glyphs can overlap by their antialiased edges, so add.
+        const uint32_t *src = reinterpret_cast<const uint32_t *>(m_atlas.constBits());
+        const int atlasStride = m_atlas.bytesPerLine() / 4;
+        const QPoint from = g.cell.topLeft() + (placed.topLeft() - full.topLeft());
+        for (int row = 0; row < placed.height(); row++) {
+            PixelKernels::addSaturate(dst + (placed.top() + row) * targetStride + placed.left(),
+                                      src + (from.y() + row) * atlasStride + from.x(),
+                                      placed.width());
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <QFont>
+#include <QFontMetricsF>
+#include <QHash>
+#include <QImage>
+#include <QPainterPath>
+#include <QPoint>
+#include <QRect>
+#include <QString>
+
+// Glyphs of one font, each shaped and rasterized once: the outline for path
+// fills and glows, and an antialiased white coverage bitmap packed into a
+// shared atlas image. Clock faces draw at display-filling sizes where Qt
+// gives up on its own glyph cache and rasterizes outlines every time;
+// building a time string from the atlas is a few row blits instead.
+//
+// Glyphs are placed by their advances on whole pixels, with no kerning.
+// That is exact for the monospaced clock fonts and close enough for short
+// labels such as AM/PM.
+class GlyphAtlas
+{
+public:
+    explicit GlyphAtlas(const QFont &font = QFont());
+
+    // Drops every cached glyph when font differs from the current one
+    void setFont(const QFont &font);
+    const QFont &font() const { return m_font; }
+    const QFontMetricsF &metrics() const { return m_metrics; }
+
+    // Width of text as laid out by path() and render()
+    int advance(const QString &text);
+    // Outline of text with its baseline starting at origin
+    QPainterPath path(const QString &text, const QPointF &origin);
+    // Adds text in white to target (ARGB32_Premultiplied) with its baseline
+    // starting at origin, clipped to the image
+    void render(QImage &target, const QString &text, const QPoint &origin);
+
+private:
+    struct Glyph {
+        QRect cell;         // in m_atlas, empty for blank glyphs
+        QPoint offset;      // of the cell's top-left from the pen position
+        int advance = 0;
+        QPainterPath path;  // at a pen position of (0, 0)
+    };
+
+    const Glyph &glyph(QChar c);
+    QPoint allocate(const QSize &size);
+
+    QFont m_font;
+    QFontMetricsF m_metrics;
+    QHash<QChar, Glyph> m_glyphs;
+
+    // Shelf packing: cells fill a row left to right, then a new row starts
+    // below the tallest cell; the image grows downward when it runs out
+    QImage m_atlas;
+    int m_shelfX = 0;
+    int m_shelfY = 0;
+    int m_shelfHeight = 0;
+};
+
+#endif // GLYPHATLAS_H
@@ -1,6 +1,8 @@
 #include "screensaverview.h"
 #include "ui_screensaverview.h"
 #include "scale.h"
+#include "pixelkernels.h"
+#include "framescheduler.h"
 #include <QPainter>
 #include <QPainterPath>
 #include <QFont>
@@ -12,71 +14,27 @@
 #include <QRadialGradient>
 #include <QLinearGradient>
 #include <QSet>
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <limits>
 
-// --- Optimized box blur: raw pointer access, integer division ---
+// --- Box blur: separable passes from the shared pixel kernels ---
 
-static void boxBlurH(QImage &src, QImage &dst, int radius)
+static void boxBlurH(const QImage &src, QImage &dst, int radius)
 {
-    const int w = src.width();
-    const int h = src.height();
-    const int divisor = 2 * radius + 1;
-    const int srcStride = src.bytesPerLine() / 4;
-    const int dstStride = dst.bytesPerLine() / 4;
-    const QRgb *srcBits = reinterpret_cast<const QRgb *>(src.constBits());
-    QRgb *dstBits = reinterpret_cast<QRgb *>(dst.bits());
-    const int wMax = w - 1;
-
-    for (int y = 0; y < h; y++) {
-        const QRgb *sl = srcBits + y * srcStride;
-        QRgb *dl = dstBits + y * dstStride;
-        int ra = 0, ga = 0, ba = 0, aa = 0;
-
-        for (int x = -radius; x <= radius; x++) {
-            QRgb p = sl[qBound(0, x, wMax)];
-            ra += qRed(p); ga += qGreen(p); ba += qBlue(p); aa += qAlpha(p);
-        }
-        for (int x = 0; x < w; x++) {
-            dl[x] = qRgba(ra / divisor, ga / divisor, ba / divisor, aa / divisor);
-            QRgb add = sl[qMin(x + radius + 1, wMax)];
-            QRgb sub = sl[qMax(x - radius, 0)];
-            ra += qRed(add) - qRed(sub);
-            ga += qGreen(add) - qGreen(sub);
-            ba += qBlue(add) - qBlue(sub);
-            aa += qAlpha(add) - qAlpha(sub);
-        }
-    }
+    PixelKernels::boxBlurH(reinterpret_cast<const uint32_t *>(src.constBits()),
+                           reinterpret_cast<uint32_t *>(dst.bits()),
+                           src.width(), src.height(),
+                           src.bytesPerLine() / 4, dst.bytesPerLine() / 4, radius);
 }
 
-static void boxBlurV(QImage &src, QImage &dst, int radius)
+static void boxBlurV(const QImage &src, QImage &dst, int radius)
 {
-    const int w = src.width();
-    const int h = src.height();
-    const int divisor = 2 * radius + 1;
-    const int srcStride = src.bytesPerLine() / 4;
-    const int dstStride = dst.bytesPerLine() / 4;
-    const QRgb *srcBits = reinterpret_cast<const QRgb *>(src.constBits());
-    QRgb *dstBits = reinterpret_cast<QRgb *>(dst.bits());
-    const int hMax = h - 1;
-
-    for (int x = 0; x < w; x++) {
-        int ra = 0, ga = 0, ba = 0, aa = 0;
-
-        for (int y = -radius; y <= radius; y++) {
-            QRgb p = srcBits[qBound(0, y, hMax) * srcStride + x];
-            ra += qRed(p); ga += qGreen(p); ba += qBlue(p); aa += qAlpha(p);
-        }
-        for (int y = 0; y < h; y++) {
-            dstBits[y * dstStride + x] =
-                qRgba(ra / divisor, ga / divisor, ba / divisor, aa / divisor);
-            QRgb add = srcBits[qMin(y + radius + 1, hMax) * srcStride + x];
-            QRgb sub = srcBits[qMax(y - radius, 0) * srcStride + x];
-            ra += qRed(add) - qRed(sub);
-            ga += qGreen(add) - qGreen(sub);
-            ba += qBlue(add) - qBlue(sub);
-            aa += qAlpha(add) - qAlpha(sub);
-        }
-    }
+    PixelKernels::boxBlurV(reinterpret_cast<const uint32_t *>(src.constBits()),
+                           reinterpret_cast<uint32_t *>(dst.bits()),
+                           src.width(), src.height(),
+                           src.bytesPerLine() / 4, dst.bytesPerLine() / 4, radius);
 }
 
 static void blurImage(QImage &img, QImage &tmp, int radius, int passes)
@@ -88,6 +46,29 @@ static void blurImage(QImage &img, QImage &tmp, int radius, int passes)
     }
 }
 
+// Glow buffers work at 1/GLOW_SCALE of the screen resolution; three box
+// passes of GLOW_BLUR_RADIUS there come close to a Gaussian
+static constexpr float GLOW_SCALE = 4.0f;
+static constexpr int GLOW_BLUR_RADIUS = 2;
+static constexpr int GLOW_BLUR_PASSES = 3;
+
+// Static layer bounds for a floating block: the block grown by room for the
+// glow and trim that spill past it
+static QRectF layerBounds(const QPointF &topLeft, float w, float h)
+{
+    const float margin = 8.0f * UI_SCALE;
+    return QRectF(topLeft.x() - margin, topLeft.y() - margin, w + margin * 2, h + margin * 2);
+}
+
+// Time until a coordinate moving vel per frameMs floors to another pixel
+static float pixelCrossingMs(float pos, float vel, int frameMs)
+{
+    if (vel == 0.0f)
+        return std::numeric_limits<float>::max();
+    const float frac = pos - std::floor(pos);
+    return (vel > 0.0f ? 1.0f - frac : frac) / std::fabs(vel) * frameMs;
+}
+
 // --- ScreenSaverView ---
 
 ScreenSaverView::ScreenSaverView(QWidget *parent) :
@@ -104,10 +85,23 @@ ScreenSaverView::ScreenSaverView(QWidget *parent) :
     formatTime();
     m_currentTheme = makeLuxuryTheme();
 
-    m_animTimer = new QTimer(this);
-    m_animTimer->setInterval(33); // ~30 FPS
-    connect(m_animTimer, &QTimer::timeout, this, &ScreenSaverView::animate);
-    m_animTimer->start();
+    QFont timeFont("DejaVu Sans Mono");
+    timeFont.setPixelSize(44 * UI_SCALE);
+    timeFont.setBold(true);
+    m_neonTimeGlyphs.setFont(timeFont);
+
+    QFont ampmFont("DejaVu Sans");
+    ampmFont.setPixelSize(18 * UI_SCALE);
+    ampmFont.setBold(true);
+    m_neonAmpmGlyphs.setFont(ampmFont);
+
+    QFont dateFont("DejaVu Sans");
+    dateFont.setPixelSize(13 * UI_SCALE);
+    m_neonDateGlyphs.setFont(dateFont);
+
+    // Every frame while on screen; animate() moves the next tick out for
+    // faces that change less often
+    FrameScheduler::instance().subscribe(this, "screensaver", ANIM_INTERVAL_MS * 1000, [this] { animate(); });
 }
 
 ScreenSaverView::~ScreenSaverView()
@@ -135,6 +129,19 @@ void ScreenSaverView::start(int themeIndex)
     m_currentTheme = themes[m_themeIndex];
     m_clockMode = m_currentTheme.isDigital ? Digital : Analog;
     m_pongInit = false;
+    m_faceRect = QRect();
+    m_faceDamage = rect();
+    invalidateLayers();
+
+    // The previous face may have been sleeping for most of a minute
+    m_frameClock.invalidate();
+    FrameScheduler::instance().scheduleTick(this, 0);
+}
+
+void ScreenSaverView::setFrameRateCap(int fps)
+{
+    m_frameIntervalMs = fps > 0 ? std::max(ANIM_INTERVAL_MS, 1000 / fps) : ANIM_INTERVAL_MS;
+    FrameScheduler::instance().setInterval(this, m_frameIntervalMs * 1000);
 }
 
 QStringList ScreenSaverView::faceNames()
@@ -175,26 +182,208 @@ void ScreenSaverView::animate()
 {
     formatTime();
 
-    m_posX += m_velX;
-    m_posY += m_velY;
+    // Drift and colour advance with elapsed time, counted in base frames,
+    // since the timer only fires when something is due. A stall longer than
+    // a second (suspend, a slow resume) is not caught up.
+    float frames = 1.0f;
+    if (m_frameClock.isValid())
+        frames = std::min<qint64>(m_frameClock.restart(), 1000) / float(ANIM_INTERVAL_MS);
+    else
+        m_frameClock.start();
+
+    m_posX += m_velX * frames;
+    m_posY += m_velY * frames;
+
+    m_hue = fmodf(m_hue + 0.2f * frames, 360.0f);
+    m_breathePhase = fmodf(m_breathePhase + 0.06f * frames, 6.2831853f);
+
+    if (m_faceRect.isEmpty()) {
+        // Nothing painted yet, or a face that doesn't report its bounds
+        m_faceDamage = rect();
+        update();
+    } else {
+        // Drift can only move the face a whole pixel at a time, and bouncing
+        // only pulls it back between the old and the new spot
+        const QPoint pos(static_cast<int>(std::floor(m_posX)), static_cast<int>(std::floor(m_posY)));
+        const bool moved = pos != m_facePos;
+        const bool animated = m_facePeriodMs == 0;
+        const bool rolledOver = !animated
+            && QDateTime::currentMSecsSinceEpoch() / m_facePeriodMs != m_faceTick;
+        if (!moved && !animated && !rolledOver) {
+            m_idleTicks++;
+        } else {
+            // New content after a rollover can still lay out past this;
+            // markFace() catches that once it knows the new bounds
+            m_faceDamage = m_faceRect;
+            if (moved)
+                m_faceDamage = m_faceDamage.united(m_faceRect.translated(pos - m_facePos));
+            update(m_faceDamage);
+        }
+    }
 
-    m_hue = fmodf(m_hue + 0.2f, 360.0f);
-    m_breathePhase = fmodf(m_breathePhase + 0.06f, 6.2831853f);
+    // Animated faces keep the scheduler's cadence
+    if (!m_faceRect.isEmpty() && m_facePeriodMs > 0)
+        FrameScheduler::instance().scheduleTick(this, nextFrameMs() * 1000);
+}
 
-    update();
+int ScreenSaverView::nextFrameMs() const
+{
+    // The face's next period boundary, or drift reaching the next whole
+    // pixel on either axis, whichever comes first
+    float waitMs = m_facePeriodMs - QDateTime::currentMSecsSinceEpoch() % m_facePeriodMs;
+    waitMs = std::min({waitMs, pixelCrossingMs(m_posX, m_velX, ANIM_INTERVAL_MS),
+                       pixelCrossingMs(m_posY, m_velY, ANIM_INTERVAL_MS)});
+    return std::max(m_frameIntervalMs, static_cast<int>(std::ceil(waitMs)));
 }
 
 void ScreenSaverView::paintEvent(QPaintEvent *)
 {
-    QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
-    painter.fillRect(rect(), Qt::black);
+    FrameScheduler::PaintTimer timed(this);
+    m_paintTimer.start();
+    {
+        QPainter painter(this);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.fillRect(rect(), Qt::black);
 
-    if (m_clockMode == Digital) {
-        paintDigitalClock(painter);
-    } else {
-        paintAnalogClock(painter);
+        if (m_clockMode == Digital) {
+            paintDigitalClock(painter);
+        } else {
+            paintAnalogClock(painter);
+        }
+    }
+    m_paintCostUs += (m_paintTimer.nsecsElapsed() / 1000.0 - m_paintCostUs) / 16.0;
+}
+
+void ScreenSaverView::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    m_faceRect = QRect();
+    m_faceDamage = rect();
+    invalidateLayers();
+}
+
+void ScreenSaverView::markFace(const QRectF &bounds)
+{
+    m_faceRect = bounds.toAlignedRect();
+    // Content that laid out bigger than the area being repainted ("9:59" to
+    // "10:00", pushed back from the edge) was clipped; paint the rest next
+    if (!m_faceDamage.contains(m_faceRect)) {
+        m_faceDamage = m_faceRect;
+        update(m_faceRect);
+    }
+    m_facePos = QPoint(static_cast<int>(std::floor(m_posX)), static_cast<int>(std::floor(m_posY)));
+    m_facePeriodMs = m_currentTheme.updateMs;
+    m_faceTick = m_facePeriodMs > 0 ? QDateTime::currentMSecsSinceEpoch() / m_facePeriodMs : 0;
+}
+
+void ScreenSaverView::invalidateLayers()
+{
+    m_layerValid = false;
+    m_glowStaticValid = false;
+    m_neonTimeGlow.valid = false;
+    m_neonDateGlow.valid = false;
+    m_nixieGlow.valid = false;
+    m_neonTimeText.valid = false;
+    m_neonDateText.valid = false;
+}
+
+void ScreenSaverView::drawStaticLayer(QPainter &painter, const QRectF &bounds, quint64 key,
+                                      const std::function<void(QPainter &)> &draw)
+{
+    const QPoint origin(static_cast<int>(std::floor(bounds.left())),
+                        static_cast<int>(std::floor(bounds.top())));
+    const QSize size(static_cast<int>(std::ceil(bounds.right())) - origin.x(),
+                     static_cast<int>(std::ceil(bounds.bottom())) - origin.y());
+
+    if (!m_layerValid || m_layerKey != key || m_layerSize != size) {
+        const qreal dpr = devicePixelRatioF();
+        if (m_layerSize != size || m_layer.devicePixelRatio() != dpr) {
+            m_layer = QPixmap(size * dpr);
+            m_layer.setDevicePixelRatio(dpr);
+        }
+        m_layer.fill(Qt::transparent);
+        QPainter lp(&m_layer);
+        lp.setRenderHint(QPainter::Antialiasing);
+        lp.translate(-origin);
+        draw(lp);
+
+        m_layerSize = size;
+        m_layerKey = key;
+        m_layerValid = true;
+        m_layerRenders++;
+    }
+    painter.drawPixmap(origin, m_layer);
+}
+
+void ScreenSaverView::drawGlyphGlow(QPainter &painter, GlyphGlow &glyphGlow, const QRect &bounds,
+                                   quint64 key, const QColor &tint,
+                                   const std::function<void(QPainter &)> &draw)
+{
+    const QSize size(static_cast<int>(std::ceil(bounds.width() / GLOW_SCALE)),
+                     static_cast<int>(std::ceil(bounds.height() / GLOW_SCALE)));
+    if (size.isEmpty())
+        return;
+
+    if (!glyphGlow.valid || glyphGlow.key != key || glyphGlow.glow.size() != size) {
+        if (glyphGlow.glow.size() != size) {
+            glyphGlow.glow = QImage(size, QImage::Format_ARGB32_Premultiplied);
+            glyphGlow.tmp = QImage(size, QImage::Format_ARGB32_Premultiplied);
+            glyphGlow.tinted = QImage(size, QImage::Format_ARGB32_Premultiplied);
+        }
+        glyphGlow.glow.fill(Qt::transparent);
+        {
+            QPainter gp(&glyphGlow.glow);
+            gp.setRenderHint(QPainter::Antialiasing);
+            gp.scale(1.0f / GLOW_SCALE, 1.0f / GLOW_SCALE);
+            gp.translate(-bounds.topLeft());
+            draw(gp);
+        }
+        blurImage(glyphGlow.glow, glyphGlow.tmp, GLOW_BLUR_RADIUS, GLOW_BLUR_PASSES);
+        glyphGlow.key = key;
+        glyphGlow.valid = true;
     }
+
+    // The glow is white, so tinting is a per-channel scale by the colour
+    PixelKernels::modulate(reinterpret_cast<const uint32_t *>(glyphGlow.glow.constBits()),
+                           reinterpret_cast<uint32_t *>(glyphGlow.tinted.bits()),
+                           static_cast<int>(glyphGlow.glow.sizeInBytes() / 4),
+                           qPremultiply(tint.rgba()));
+
+    painter.save();
+    painter.setCompositionMode(QPainter::CompositionMode_Plus);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    painter.drawImage(QRectF(bounds.topLeft(), QSizeF(size) * GLOW_SCALE), glyphGlow.tinted);
+    painter.restore();
+}
+
+void ScreenSaverView::drawTextSprite(QPainter &painter, TextSprite &sprite, const QRect &bounds,
+                                     quint64 key, const QColor &color,
+                                     const std::function<void(QImage &)> &render)
+{
+    if (bounds.isEmpty())
+        return;
+
+    if (!sprite.valid || sprite.key != key || sprite.text.size() != bounds.size()) {
+        if (sprite.text.size() != bounds.size()) {
+            sprite.text = QImage(bounds.size(), QImage::Format_ARGB32_Premultiplied);
+            sprite.tinted = QImage(bounds.size(), QImage::Format_ARGB32_Premultiplied);
+        }
+        sprite.text.fill(Qt::transparent);
+        render(sprite.text);
+        sprite.key = key;
+        sprite.valid = true;
+        sprite.tintValid = false;
+    }
+
+    const QRgb tint = qPremultiply(color.rgba());
+    if (!sprite.tintValid || tint != sprite.tintedColor) {
+        PixelKernels::modulate(reinterpret_cast<const uint32_t *>(sprite.text.constBits()),
+                               reinterpret_cast<uint32_t *>(sprite.tinted.bits()),
+                               static_cast<int>(sprite.text.sizeInBytes() / 4), tint);
+        sprite.tintedColor = tint;
+        sprite.tintValid = true;
+    }
+    painter.drawImage(bounds.topLeft(), sprite.tinted);
 }
 
 QPointF ScreenSaverView::placeFloatingBlock(float totalW, float totalH)
@@ -212,7 +401,7 @@ QPointF ScreenSaverView::placeFloatingBlock(float totalW, float totalH)
     if (m_posY <= 0)                      { m_posY = 0;                m_velY = fabsf(m_velY);  }
     if (m_posX + totalW >= width())       { m_posX = width()  - totalW; m_velX = -fabsf(m_velX); }
     if (m_posY + totalH >= height())      { m_posY = height() - totalH; m_velY = -fabsf(m_velY); }
-    return QPointF(m_posX, m_posY);
+    return QPointF(std::floor(m_posX), std::floor(m_posY));
 }
 
 void ScreenSaverView::paintDigitalClock(QPainter &painter)
@@ -230,28 +419,17 @@ void ScreenSaverView::paintDigitalClock(QPainter &painter)
 
 void ScreenSaverView::paintDigitalNeon(QPainter &painter)
 {
-    // Fonts
-    QFont timeFont("DejaVu Sans Mono");
-    timeFont.setPixelSize(44 * UI_SCALE);
-    timeFont.setBold(true);
-
-    QFont ampmFont("DejaVu Sans");
-    ampmFont.setPixelSize(18 * UI_SCALE);
-    ampmFont.setBold(true);
-
-    QFont dateFont("DejaVu Sans");
-    dateFont.setPixelSize(13 * UI_SCALE);
-
-    // Measure text block
-    QFontMetrics timeFm(timeFont);
-    QFontMetrics ampmFm(ampmFont);
-    QFontMetrics dateFm(dateFont);
+    // Measure text block; advances come from the atlases so the layout
+    // matches what they render
+    QFontMetrics timeFm(m_neonTimeGlyphs.font());
+    QFontMetrics ampmFm(m_neonAmpmGlyphs.font());
+    QFontMetrics dateFm(m_neonDateGlyphs.font());
 
-    int timeW = timeFm.horizontalAdvance(m_timeStr);
+    int timeW = m_neonTimeGlyphs.advance(m_timeStr);
     int ampmGap = 4 * UI_SCALE;
-    int ampmW = ampmFm.horizontalAdvance(m_ampm);
+    int ampmW = m_neonAmpmGlyphs.advance(m_ampm);
     int topLineW = timeW + ampmGap + ampmW;
-    int dateW = dateFm.horizontalAdvance(m_dateStr);
+    int dateW = m_neonDateGlyphs.advance(m_dateStr);
 
     int blockW = qMax(topLineW, dateW);
     int lineSpacing = 6 * UI_SCALE;
@@ -279,54 +457,63 @@ void ScreenSaverView::paintDigitalNeon(QPainter &painter)
 
     int bx = static_cast<int>(m_posX) + pad;
     int by = static_cast<int>(m_posY) + pad;
+    // The glow buffers round their size up to a multiple of GLOW_SCALE
+    markFace(QRectF(bx - pad, by - pad, totalW + GLOW_SCALE, totalH + GLOW_SCALE));
 
     // Colors from cycling hue + breathing intensity
     float breathe = 0.75f + 0.25f * sinf(m_breathePhase);
     QColor baseColor = QColor::fromHsvF(m_hue / 360.0f, 0.7f, breathe);
     QColor dateColor = QColor::fromHsvF(fmodf(m_hue + 30.0f, 360.0f) / 360.0f, 0.5f, breathe * 0.6f);
 
-    // Helper: draw text with neon glow via QPainterPath strokes
-    auto drawNeonText = [&](const QString &text, const QFont &font, int x, int y, QColor color) {
-        QPainterPath path;
-        path.addText(x, y, font, text);
-
-        // Outer glow
-        QColor outer = color;
-        outer.setAlphaF(0.12f * breathe);
-        painter.setPen(QPen(outer, 6.0f * UI_SCALE, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
-        painter.setBrush(Qt::NoBrush);
-        painter.drawPath(path);
-
-        // Mid glow
-        QColor mid = color;
-        mid.setAlphaF(0.25f * breathe);
-        painter.setPen(QPen(mid, 2.5f * UI_SCALE, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
-        painter.drawPath(path);
-
-        // Core fill
-        int r = color.red()   + (255 - color.red())   * 0.45f;
-        int g = color.green() + (255 - color.green()) * 0.45f;
-        int b = color.blue()  + (255 - color.blue())  * 0.45f;
-        QColor core(qMin(r, 255), qMin(g, 255), qMin(b, 255));
-        painter.setPen(Qt::NoPen);
-        painter.setBrush(core);
-        painter.drawPath(path);
-    };
-
-    // Time
+    // Time and AM/PM on one line, date below
     int topLineX = bx + (blockW - topLineW) / 2;
     int timeBaseY = by + timeFm.ascent();
-    drawNeonText(m_timeStr, timeFont, topLineX, timeBaseY, baseColor);
-
-    // AM/PM
     int ampmX = topLineX + timeW + ampmGap;
     int ampmBaseY = timeBaseY - timeFm.descent() + ampmFm.descent();
-    drawNeonText(m_ampm, ampmFont, ampmX, ampmBaseY, baseColor);
-
-    // Date
     int dateX = bx + (blockW - dateW) / 2;
     int dateBaseY = by + timeH + lineSpacing + dateFm.ascent();
-    drawNeonText(m_dateStr, dateFont, dateX, dateBaseY, dateColor);
+
+    const QRect timeRect(topLineX - pad, by - pad, topLineW + pad * 2, timeH + pad * 2);
+    const QRect dateRect(dateX - pad, dateBaseY - dateFm.ascent() - pad, dateW + pad * 2, dateH + pad * 2);
+    const quint64 timeKey = qHash(m_timeStr + QLatin1Char('\n') + m_ampm);
+    const quint64 dateKey = qHash(m_dateStr);
+
+    // Glow: the glyph outlines with a stroke around them, blurred at
+    // quarter resolution. Each line is cached until its text changes,
+    // relative to the line, so drift and the breathing colour don't redraw it.
+    auto glowTint = [&](QColor color) {
+        color.setAlphaF(0.5f * breathe);
+        return color;
+    };
+    auto glowShape = [](QPainter &p, const QPainterPath &path) {
+        p.setPen(QPen(Qt::white, 2.5f * UI_SCALE, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+        p.setBrush(Qt::white);
+        p.drawPath(path);
+    };
+    drawGlyphGlow(painter, m_neonTimeGlow, timeRect, timeKey, glowTint(baseColor), [&](QPainter &p) {
+        QPainterPath path = m_neonTimeGlyphs.path(m_timeStr, QPointF(topLineX, timeBaseY));
+        path.addPath(m_neonAmpmGlyphs.path(m_ampm, QPointF(ampmX, ampmBaseY)));
+        glowShape(p, path);
+    });
+    drawGlyphGlow(painter, m_neonDateGlow, dateRect, dateKey, glowTint(dateColor), [&](QPainter &p) {
+        glowShape(p, m_neonDateGlyphs.path(m_dateStr, QPointF(dateX, dateBaseY)));
+    });
+
+    // Core, lifted toward white: the lines are put together from the glyph
+    // atlases when the text changes and only tinted per frame
+    auto core = [](const QColor &color) {
+        int r = color.red()   + (255 - color.red())   * 0.45f;
+        int g = color.green() + (255 - color.green()) * 0.45f;
+        int b = color.blue()  + (255 - color.blue())  * 0.45f;
+        return QColor(qMin(r, 255), qMin(g, 255), qMin(b, 255));
+    };
+    drawTextSprite(painter, m_neonTimeText, timeRect, timeKey, core(baseColor), [&](QImage &img) {
+        m_neonTimeGlyphs.render(img, m_timeStr, QPoint(topLineX, timeBaseY) - timeRect.topLeft());
+        m_neonAmpmGlyphs.render(img, m_ampm, QPoint(ampmX, ampmBaseY) - timeRect.topLeft());
+    });
+    drawTextSprite(painter, m_neonDateText, dateRect, dateKey, core(dateColor), [&](QImage &img) {
+        m_neonDateGlyphs.render(img, m_dateStr, QPoint(dateX, dateBaseY) - dateRect.topLeft());
+    });
 }
 
 // --- Analog Clock: Themed Rendering ---
@@ -759,8 +946,12 @@ void ScreenSaverView::paintAnalogClock(QPainter &painter)
     if (m_posX + dialSize >= W)      { m_posX = W - dialSize;    m_velX = -fabsf(m_velX); }
     if (m_posY + dialSize >= H)      { m_posY = H - dialSize;    m_velY = -fabsf(m_velY); }
 
-    float cx = m_posX + dialSize * 0.5f;
-    float cy = m_posY + dialSize * 0.5f;
+    // Whole pixels, so the cached dial lines up with the hands drawn over it
+    const float ox = std::floor(m_posX);
+    const float oy = std::floor(m_posY);
+    float cx = ox + dialSize * 0.5f;
+    float cy = oy + dialSize * 0.5f;
+    markFace(layerBounds(QPointF(ox, oy), dialSize, dialSize));
 
     // Breathing
     float breathe = 1.0f - theme.breatheAmount + theme.breatheAmount * sinf(m_breathePhase);
@@ -785,13 +976,17 @@ void ScreenSaverView::paintAnalogClock(QPainter &painter)
         secondColor = applyHueCycle(secondColor, m_hue + 120.0f);
     }
 
-    // Lambda to draw all clock elements (used for both glow and sharp pass)
-    auto drawElements = [&](QPainter &p) {
+    // Dial, rings, ticks and numerals only change with the theme, or every
+    // degree of hue on hue-cycling themes
+    const quint64 dialKey = theme.hueCycling ? static_cast<quint64>(m_hue) + 1 : 0;
+    auto drawDial = [&](QPainter &p) {
         drawDialBackground(p, cx, cy, radius, theme);
         drawDecorativeRings(p, cx, cy, radius, theme);
         drawTicks(p, cx, cy, radius, theme);
         drawNumerals(p, cx, cy, radius, theme);
+    };
 
+    auto drawHands = [&](QPainter &p) {
         // Hour hand
         drawHand(p, cx, cy, radius, hourAngle,
                  theme.hands.hourShape, theme.hands.hourLength, theme.hands.hourWidth,
@@ -823,23 +1018,35 @@ void ScreenSaverView::paintAnalogClock(QPainter &painter)
     };
 
     // --- Glow pass: paint to buffer sized to dial bounding box ---
-    constexpr float GLOW_SCALE = 4.0f;
     int glowDim = static_cast<int>(ceilf(dialSize / GLOW_SCALE)) + 2;
 
     if (glowDim != m_cachedGlowSize) {
         m_cachedGlowSize = glowDim;
         m_glowBuffer = QImage(glowDim, glowDim, QImage::Format_ARGB32_Premultiplied);
-        m_glowTmp   = QImage(glowDim, glowDim, QImage::Format_ARGB32_Premultiplied);
+        m_glowTmp    = QImage(glowDim, glowDim, QImage::Format_ARGB32_Premultiplied);
+        m_glowStatic = QImage(glowDim, glowDim, QImage::Format_ARGB32_Premultiplied);
+        m_glowStaticValid = false;
     }
 
-    m_glowBuffer.fill(Qt::transparent);
+    // Translate so the dial's top-left maps to the glow buffer's origin
+    auto toGlow = [&](QPainter &gp) {
+        gp.scale(1.0f / GLOW_SCALE, 1.0f / GLOW_SCALE);
+        gp.translate(-ox, -oy);
+    };
+
+    if (!m_glowStaticValid || m_glowStaticKey != dialKey) {
+        m_glowStatic.fill(Qt::transparent);
+        QPainter gp(&m_glowStatic);
+        toGlow(gp);
+        drawDial(gp);
+        m_glowStaticKey = dialKey;
+        m_glowStaticValid = true;
+    }
+    std::memcpy(m_glowBuffer.bits(), m_glowStatic.constBits(), m_glowStatic.sizeInBytes());
     {
         QPainter gp(&m_glowBuffer);
-        // Translate so the dial center maps correctly into the glow buffer
-        float glowOffset = dialSize * 0.5f / GLOW_SCALE;
-        gp.scale(1.0f / GLOW_SCALE, 1.0f / GLOW_SCALE);
-        gp.translate(-m_posX, -m_posY);
-        drawElements(gp);
+        toGlow(gp);
+        drawHands(gp);
     }
 
     int blurRadius = 3;
@@ -848,13 +1055,14 @@ void ScreenSaverView::paintAnalogClock(QPainter &painter)
     // Composite glow
     painter.setRenderHint(QPainter::SmoothPixmapTransform);
     painter.setOpacity(0.7f * breathe * theme.glowIntensity);
-    QRectF glowRect(m_posX, m_posY, dialSize, dialSize);
+    QRectF glowRect(ox, oy, dialSize, dialSize);
     painter.drawImage(glowRect, m_glowBuffer);
 
-    // --- Sharp pass: draw directly to screen ---
+    // --- Sharp pass: cached dial, hands drawn directly to screen ---
     painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
     painter.setOpacity(breathe);
-    drawElements(painter);
+    drawStaticLayer(painter, glowRect, dialKey, drawDial);
+    drawHands(painter);
 
     painter.setOpacity(1.0f);
 }
@@ -870,9 +1078,9 @@ void ScreenSaverView::paintOrbitalClock(QPainter &painter)
     float radius   = qMin(W, H) * theme.dialRadiusFraction;
     float dialSize = radius * 2.0f + 8.0f * UI_SCALE;
 
-    placeFloatingBlock(dialSize, dialSize);
-    float cx = m_posX + dialSize * 0.5f;
-    float cy = m_posY + dialSize * 0.5f;
+    QPointF tl = placeFloatingBlock(dialSize, dialSize);
+    float cx = tl.x() + dialSize * 0.5f;
+    float cy = tl.y() + dialSize * 0.5f;
 
     float breathe = 1.0f - theme.breatheAmount + theme.breatheAmount * sinf(m_breathePhase);
 
@@ -886,19 +1094,23 @@ void ScreenSaverView::paintOrbitalClock(QPainter &painter)
 
     painter.setRenderHint(QPainter::Antialiasing, true);
 
-    // Dial + rim
-    painter.setPen(Qt::NoPen);
-    painter.setBrush(theme.colors.dial);
-    painter.drawEllipse(QPointF(cx, cy), radius, radius);
-    painter.setPen(QPen(theme.colors.rim, 1.5f * UI_SCALE));
-    painter.setBrush(Qt::NoBrush);
-    painter.drawEllipse(QPointF(cx, cy), radius, radius);
+    markFace(layerBounds(tl, dialSize, dialSize));
 
-    // Faint guide rings
     const float ringR[3] = { radius * 0.82f, radius * 0.60f, radius * 0.38f };
-    painter.setPen(QPen(theme.colors.decorativeRing, 0.6f * UI_SCALE));
-    for (float r : ringR)
-        painter.drawEllipse(QPointF(cx, cy), r, r);
+    drawStaticLayer(painter, QRectF(tl, QSizeF(dialSize, dialSize)), 0, [&](QPainter &p) {
+        // Dial + rim
+        p.setPen(Qt::NoPen);
+        p.setBrush(theme.colors.dial);
+        p.drawEllipse(QPointF(cx, cy), radius, radius);
+        p.setPen(QPen(theme.colors.rim, 1.5f * UI_SCALE));
+        p.setBrush(Qt::NoBrush);
+        p.drawEllipse(QPointF(cx, cy), radius, radius);
+
+        // Faint guide rings
+        p.setPen(QPen(theme.colors.decorativeRing, 0.6f * UI_SCALE));
+        for (float r : ringR)
+            p.drawEllipse(QPointF(cx, cy), r, r);
+    });
 
     // Arc: from 12 o'clock clockwise to deg, with glow + end dot
     auto drawArc = [&](float r, float deg, const QColor &col, float widthPx) {
@@ -1004,49 +1216,53 @@ void ScreenSaverView::paintDigitalSevenSeg(QPainter &painter)
     float totalH = dh;
     float pad = 15.0f * UI_SCALE;       // room for glow + label
 
-    placeFloatingBlock(totalW + pad * 2, totalH + pad * 2);
-    float x = m_posX + pad;
-    float y = m_posY + pad;
+    QPointF tl = placeFloatingBlock(totalW + pad * 2, totalH + pad * 2);
+    float x = tl.x() + pad;
+    float y = tl.y() + pad;
 
     QColor on = m_currentTheme.colors.secondHand.isValid()
               ? m_currentTheme.colors.secondHand : QColor(31, 227, 255);
 
-    painter.setRenderHint(QPainter::Antialiasing, true);
-
-    // hour digits, colon, minute digits
-    float cursor = x;
-    for (int i = 0; i < hh.size(); i++) {
-        drawSevenSegDigit(painter, cursor, y, dw, dh, th, hh.at(i).digitValue(), on);
-        cursor += dw + dgap;
-    }
-    // colon (centered in the colon gap)
-    float colonCenterX = cursor - dgap * 0.5f + colonW * 0.5f;
-    QColor cglow = on; cglow.setAlphaF(0.3f);
-    float cy1 = y + dh * 0.34f, cy2 = y + dh * 0.66f;
-    painter.setPen(Qt::NoPen);
-    painter.setBrush(cglow);
-    painter.drawEllipse(QPointF(colonCenterX, cy1), th, th);
-    painter.drawEllipse(QPointF(colonCenterX, cy2), th, th);
-    painter.setBrush(on);
-    painter.drawEllipse(QPointF(colonCenterX, cy1), th * 0.6f, th * 0.6f);
-    painter.drawEllipse(QPointF(colonCenterX, cy2), th * 0.6f, th * 0.6f);
-    cursor += colonW;
-    for (int i = 0; i < mm.size(); i++) {
-        drawSevenSegDigit(painter, cursor, y, dw, dh, th, mm.at(i).digitValue(), on);
-        cursor += dw + dgap;
-    }
+    // Nothing moves between seconds, so the whole face is one cached layer
+    const quint64 key = tm.hour() * 3600 + tm.minute() * 60 + tm.second();
+    const QRectF bounds = layerBounds(tl, totalW + pad * 2, totalH + pad * 2);
+    markFace(bounds);
+    drawStaticLayer(painter, bounds, key, [&](QPainter &p) {
+        // hour digits, colon, minute digits
+        float cursor = x;
+        for (int i = 0; i < hh.size(); i++) {
+            drawSevenSegDigit(p, cursor, y, dw, dh, th, hh.at(i).digitValue(), on);
+            cursor += dw + dgap;
+        }
+        // colon (centered in the colon gap)
+        float colonCenterX = cursor - dgap * 0.5f + colonW * 0.5f;
+        QColor cglow = on; cglow.setAlphaF(0.3f);
+        float cy1 = y + dh * 0.34f, cy2 = y + dh * 0.66f;
+        p.setPen(Qt::NoPen);
+        p.setBrush(cglow);
+        p.drawEllipse(QPointF(colonCenterX, cy1), th, th);
+        p.drawEllipse(QPointF(colonCenterX, cy2), th, th);
+        p.setBrush(on);
+        p.drawEllipse(QPointF(colonCenterX, cy1), th * 0.6f, th * 0.6f);
+        p.drawEllipse(QPointF(colonCenterX, cy2), th * 0.6f, th * 0.6f);
+        cursor += colonW;
+        for (int i = 0; i < mm.size(); i++) {
+            drawSevenSegDigit(p, cursor, y, dw, dh, th, mm.at(i).digitValue(), on);
+            cursor += dw + dgap;
+        }
 
-    // AM/PM + seconds label
-    QFont lf("DejaVu Sans Mono");
-    lf.setPixelSize(static_cast<int>(8 * UI_SCALE));
-    lf.setBold(true);
-    painter.setFont(lf);
-    QColor lcol = on; lcol.setAlphaF(0.6f);
-    painter.setPen(lcol);
-    QString label = QString(tm.hour() >= 12 ? "PM" : "AM") +
-                    QString("   %1s").arg(tm.second(), 2, 10, QChar('0'));
-    painter.drawText(QRectF(x, y + dh + 4 * UI_SCALE, totalW, 12 * UI_SCALE),
-                     Qt::AlignCenter, label);
+        // AM/PM + seconds label
+        QFont lf("DejaVu Sans Mono");
+        lf.setPixelSize(static_cast<int>(8 * UI_SCALE));
+        lf.setBold(true);
+        p.setFont(lf);
+        QColor lcol = on; lcol.setAlphaF(0.6f);
+        p.setPen(lcol);
+        QString label = QString(tm.hour() >= 12 ? "PM" : "AM") +
+                        QString("   %1s").arg(tm.second(), 2, 10, QChar('0'));
+        p.drawText(QRectF(x, y + dh + 4 * UI_SCALE, totalW, 12 * UI_SCALE),
+                   Qt::AlignCenter, label);
+    });
 }
 
 // --- Split-flap / Solari ---
@@ -1069,52 +1285,56 @@ void ScreenSaverView::paintDigitalSplitFlap(QPainter &painter)
     float totalW = tileW * 3 + gap * 2;
     float totalH = tileH + labelH;
 
-    placeFloatingBlock(totalW, totalH);
-    float x0 = m_posX;
-    float y0 = m_posY;
-
-    painter.setRenderHint(QPainter::Antialiasing, true);
-
-    auto drawTile = [&](float x, const QString &txt, const QString &lbl) {
-        QRectF tile(x, y0, tileW, tileH);
-        QLinearGradient g(x, y0, x, y0 + tileH);
-        g.setColorAt(0.0,  QColor(52, 52, 60));
-        g.setColorAt(0.49, QColor(38, 38, 44));
-        g.setColorAt(0.51, QColor(25, 25, 32));
-        g.setColorAt(1.0,  QColor(32, 32, 40));
-        painter.setPen(QPen(QColor(0, 0, 0), 1.0f * s));
-        painter.setBrush(g);
-        painter.drawRoundedRect(tile, 10 * s, 10 * s);
-
-        // center seam
-        painter.setPen(QPen(QColor(5, 5, 7), 3.0f * s));
-        painter.drawLine(QPointF(x, y0 + tileH * 0.5f),
-                         QPointF(x + tileW, y0 + tileH * 0.5f));
-        // side axles
-        painter.setPen(Qt::NoPen);
-        painter.setBrush(QColor(10, 10, 12));
-        painter.drawRect(QRectF(x - 4 * s, y0 + tileH * 0.5f - 6 * s, 4 * s, 12 * s));
-        painter.drawRect(QRectF(x + tileW, y0 + tileH * 0.5f - 6 * s, 4 * s, 12 * s));
-        // numerals
-        QFont f("DejaVu Sans");
-        f.setBold(true);
-        f.setStretch(QFont::Condensed);
-        f.setPixelSize(static_cast<int>(tileH * 0.62f));
-        painter.setFont(f);
-        painter.setPen(QColor(244, 244, 242));
-        painter.drawText(tile, Qt::AlignCenter, txt);
-        // label
-        QFont lf("DejaVu Sans"); lf.setBold(true);
-        lf.setPixelSize(static_cast<int>(13 * s));
-        painter.setFont(lf);
-        painter.setPen(QColor(154, 154, 160));
-        painter.drawText(QRectF(x, y0 + tileH + 4 * s, tileW, labelH),
-                         Qt::AlignCenter, lbl);
-    };
+    QPointF tl = placeFloatingBlock(totalW, totalH);
+    float x0 = tl.x();
+    float y0 = tl.y();
+
+    // Tiles only change with the seconds, so the whole face is one cached layer
+    const quint64 key = tm.hour() * 3600 + tm.minute() * 60 + tm.second();
+    const QRectF bounds = layerBounds(tl, totalW, totalH);
+    markFace(bounds);
+    drawStaticLayer(painter, bounds, key, [&](QPainter &p) {
+        auto drawTile = [&](float x, const QString &txt, const QString &lbl) {
+            QRectF tile(x, y0, tileW, tileH);
+            QLinearGradient g(x, y0, x, y0 + tileH);
+            g.setColorAt(0.0,  QColor(52, 52, 60));
+            g.setColorAt(0.49, QColor(38, 38, 44));
+            g.setColorAt(0.51, QColor(25, 25, 32));
+            g.setColorAt(1.0,  QColor(32, 32, 40));
+            p.setPen(QPen(QColor(0, 0, 0), 1.0f * s));
+            p.setBrush(g);
+            p.drawRoundedRect(tile, 10 * s, 10 * s);
+
+            // center seam
+            p.setPen(QPen(QColor(5, 5, 7), 3.0f * s));
+            p.drawLine(QPointF(x, y0 + tileH * 0.5f),
+                       QPointF(x + tileW, y0 + tileH * 0.5f));
+            // side axles
+            p.setPen(Qt::NoPen);
+            p.setBrush(QColor(10, 10, 12));
+            p.drawRect(QRectF(x - 4 * s, y0 + tileH * 0.5f - 6 * s, 4 * s, 12 * s));
+            p.drawRect(QRectF(x + tileW, y0 + tileH * 0.5f - 6 * s, 4 * s, 12 * s));
+            // numerals
+            QFont f("DejaVu Sans");
+            f.setBold(true);
+            f.setStretch(QFont::Condensed);
+            f.setPixelSize(static_cast<int>(tileH * 0.62f));
+            p.setFont(f);
+            p.setPen(QColor(244, 244, 242));
+            p.drawText(tile, Qt::AlignCenter, txt);
+            // label
+            QFont lf("DejaVu Sans"); lf.setBold(true);
+            lf.setPixelSize(static_cast<int>(13 * s));
+            p.setFont(lf);
+            p.setPen(QColor(154, 154, 160));
+            p.drawText(QRectF(x, y0 + tileH + 4 * s, tileW, labelH),
+                       Qt::AlignCenter, lbl);
+        };
 
-    drawTile(x0, hh, "HOURS");
-    drawTile(x0 + tileW + gap, mm, "MINUTES");
-    drawTile(x0 + (tileW + gap) * 2, ss, "SECONDS");
+        drawTile(x0, hh, "HOURS");
+        drawTile(x0 + tileW + gap, mm, "MINUTES");
+        drawTile(x0 + (tileW + gap) * 2, ss, "SECONDS");
+    });
 }
 
 // --- Nixie tubes ---
@@ -1136,71 +1356,75 @@ void ScreenSaverView::paintDigitalNixie(QPainter &painter)
     float totalH = tubeH;
     float pad = 22.0f * s;
 
-    placeFloatingBlock(totalW + pad * 2, totalH + pad * 2);
-    float x = m_posX + pad;
-    float y = m_posY + pad;
+    QPointF tl = placeFloatingBlock(totalW + pad * 2, totalH + pad * 2);
+    float x = tl.x() + pad;
+    float y = tl.y() + pad;
 
     QColor orange = m_currentTheme.colors.secondHand.isValid()
                   ? m_currentTheme.colors.secondHand : QColor(255, 138, 50);
 
-    painter.setRenderHint(QPainter::Antialiasing, true);
-
-    auto glowText = [&](const QString &s, const QFont &f, const QRectF &box,
-                        const QColor &col, float glowW) {
-        QFontMetrics fm(f);
-        QRectF tb = fm.boundingRect(box.toRect(), Qt::AlignCenter, s);
-        QPainterPath path;
-        path.addText(tb.left(), box.center().y() + fm.height() * 0.32f, f, s);
-        QColor outer = col; outer.setAlphaF(0.18f);
-        painter.setPen(QPen(outer, glowW, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
-        painter.setBrush(Qt::NoBrush);
-        painter.drawPath(path);
-        QColor mid = col; mid.setAlphaF(0.4f);
-        painter.setPen(QPen(mid, glowW * 0.4f, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
-        painter.drawPath(path);
-        painter.setPen(Qt::NoPen);
-        painter.setBrush(col.lighter(120));
-        painter.drawPath(path);
-    };
-
-    QFont df("DejaVu Sans Mono");
-    df.setBold(true);
-    df.setPixelSize(static_cast<int>(tubeH * 0.58f));
+    // Digits only change with the minute, so the whole face is one cached layer
+    const quint64 key = tm.hour() * 60 + tm.minute();
+    const QRectF bounds = layerBounds(tl, totalW + pad * 2, totalH + pad * 2);
+    markFace(bounds);
+    drawStaticLayer(painter, bounds, key, [&](QPainter &p) {
+        QFont df("DejaVu Sans Mono");
+        df.setBold(true);
+        df.setPixelSize(static_cast<int>(tubeH * 0.58f));
+        QFontMetrics fm(df);
+        m_nixieGlyphs.setFont(df);
+        QPainterPath lit;
+
+        for (int i = 0; i < 4; i++) {
+            QRectF tube(x, y, tubeW, tubeH);
+            // glass envelope
+            QLinearGradient gg(x, y, x, y + tubeH);
+            gg.setColorAt(0.0, QColor(60, 55, 48, 140));
+            gg.setColorAt(0.5, QColor(30, 28, 26, 90));
+            gg.setColorAt(1.0, QColor(50, 46, 40, 140));
+            p.setPen(QPen(QColor(120, 110, 95, 130), 1.0f * s));
+            p.setBrush(gg);
+            p.drawRoundedRect(tube, tubeW * 0.45f, tubeW * 0.45f);
+            // caps
+            p.setPen(Qt::NoPen);
+            p.setBrush(QColor(34, 29, 24));
+            p.drawRoundedRect(QRectF(x + tubeW * 0.18f, y - 6 * s,
+                                     tubeW * 0.64f, 8 * s), 3, 3);
+            p.drawRoundedRect(QRectF(x + tubeW * 0.18f, y + tubeH - 2 * s,
+                                     tubeW * 0.64f, 8 * s), 3, 3);
+            // ghost cathode
+            p.setFont(df);
+            QColor ghost = orange; ghost.setAlphaF(0.08f);
+            p.setPen(ghost);
+            p.drawText(tube, Qt::AlignCenter, "8");
+            // lit digit
+            QString digit(digits.at(i));
+            QRectF tb = fm.boundingRect(tube.toRect(), Qt::AlignCenter, digit);
+            lit.addPath(m_nixieGlyphs.path(digit, QPointF(tb.left(), tube.center().y() + fm.height() * 0.32f)));
+            x += tubeW + gap;
+        }
 
-    for (int i = 0; i < 4; i++) {
-        QRectF tube(x, y, tubeW, tubeH);
-        // glass envelope
-        QLinearGradient gg(x, y, x, y + tubeH);
-        gg.setColorAt(0.0, QColor(60, 55, 48, 140));
-        gg.setColorAt(0.5, QColor(30, 28, 26, 90));
-        gg.setColorAt(1.0, QColor(50, 46, 40, 140));
-        painter.setPen(QPen(QColor(120, 110, 95, 130), 1.0f * s));
-        painter.setBrush(gg);
-        painter.drawRoundedRect(tube, tubeW * 0.45f, tubeW * 0.45f);
-        // caps
-        painter.setPen(Qt::NoPen);
-        painter.setBrush(QColor(34, 29, 24));
-        painter.drawRoundedRect(QRectF(x + tubeW * 0.18f, y - 6 * s,
-                                       tubeW * 0.64f, 8 * s), 3, 3);
-        painter.drawRoundedRect(QRectF(x + tubeW * 0.18f, y + tubeH - 2 * s,
-                                       tubeW * 0.64f, 8 * s), 3, 3);
-        // ghost cathode
-        painter.setFont(df);
-        QColor ghost = orange; ghost.setAlphaF(0.08f);
-        painter.setPen(ghost);
-        painter.drawText(tube, Qt::AlignCenter, "8");
-        // lit digit
-        glowText(QString(digits.at(i)), df, tube, orange, 7.0f * s);
-        x += tubeW + gap;
-    }
+        // Glow of all four digits at once, blurred at quarter resolution,
+        // then the cathodes themselves
+        QColor glow = orange; glow.setAlphaF(0.6f);
+        drawGlyphGlow(p, m_nixieGlow, QRectF(tl, QSizeF(totalW + pad * 2, totalH + pad * 2)).toAlignedRect(),
+                      key, glow, [&](QPainter &gp) {
+            gp.setPen(QPen(Qt::white, 2.8f * s, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+            gp.setBrush(Qt::white);
+            gp.drawPath(lit);
+        });
+        p.setPen(Qt::NoPen);
+        p.setBrush(orange.lighter(120));
+        p.drawPath(lit);
 
-    // neon colon
-    float midX = m_posX + pad + totalW * 0.5f;
-    QColor cglow = orange; cglow.setAlphaF(0.5f);
-    painter.setPen(Qt::NoPen);
-    painter.setBrush(cglow);
-    painter.drawEllipse(QPointF(midX, y + tubeH * 0.38f), 4 * s, 4 * s);
-    painter.drawEllipse(QPointF(midX, y + tubeH * 0.62f), 4 * s, 4 * s);
+        // neon colon
+        float midX = tl.x() + pad + totalW * 0.5f;
+        QColor cglow = orange; cglow.setAlphaF(0.5f);
+        p.setPen(Qt::NoPen);
+        p.setBrush(cglow);
+        p.drawEllipse(QPointF(midX, y + tubeH * 0.38f), 4 * s, 4 * s);
+        p.drawEllipse(QPointF(midX, y + tubeH * 0.62f), 4 * s, 4 * s);
+    });
 }
 
 // --- Terminal / CRT ---
@@ -1240,55 +1464,60 @@ void ScreenSaverView::paintDigitalTerminal(QPainter &painter)
     float panelW = contentW + pad * 2;
     float panelH = pad * 2 + lh + bigH + lh * 2.2f;
 
-    placeFloatingBlock(panelW, panelH);
-    QRectF panel(m_posX, m_posY, panelW, panelH);
-
-    painter.setRenderHint(QPainter::Antialiasing, true);
+    QPointF tl = placeFloatingBlock(panelW, panelH);
+    QRectF panel(tl.x(), tl.y(), panelW, panelH);
+    bool cursorOn = (now.toMSecsSinceEpoch() / 500) % 2 == 0;
 
-    // CRT screen panel
-    painter.setPen(QPen(green.darker(220), 1.0f * s));
-    painter.setBrush(QColor(2, 6, 4));
-    painter.drawRoundedRect(panel, 10 * s, 10 * s);
+    // Text changes with the seconds and the cursor blink, both on half-second
+    // boundaries, so the whole panel is one cached layer
+    const quint64 key = now.toMSecsSinceEpoch() / 500;
+    const QRectF bounds = layerBounds(tl, panelW, panelH);
+    markFace(bounds);
+    drawStaticLayer(painter, bounds, key, [&](QPainter &p) {
+        // CRT screen panel
+        p.setPen(QPen(green.darker(220), 1.0f * s));
+        p.setBrush(QColor(2, 6, 4));
+        p.drawRoundedRect(panel, 10 * s, 10 * s);
 
-    painter.save();
-    QPainterPath clip;
-    clip.addRoundedRect(panel, 10 * s, 10 * s);
-    painter.setClipPath(clip);
+        p.save();
+        QPainterPath clip;
+        clip.addRoundedRect(panel, 10 * s, 10 * s);
+        p.setClipPath(clip);
 
-    float tx = m_posX + pad;
-    float ty = m_posY + pad + fmM.ascent();
+        float tx = tl.x() + pad;
+        float ty = tl.y() + pad + fmM.ascent();
 
-    painter.setFont(mono);
-    painter.setPen(green);
-    painter.drawText(QPointF(tx, ty), prompt + " date");
-    ty += lh + bigH * 0.2f;
+        p.setFont(mono);
+        p.setPen(green);
+        p.drawText(QPointF(tx, ty), prompt + " date");
+        ty += lh + bigH * 0.2f;
 
-    painter.setFont(big);
-    painter.drawText(QPointF(tx, ty), timeLine);
-    ty += bigH * 0.55f + lh;
+        p.setFont(big);
+        p.drawText(QPointF(tx, ty), timeLine);
+        ty += bigH * 0.55f + lh;
 
-    painter.setFont(mono);
-    painter.setPen(dim);
-    painter.drawText(QPointF(tx, ty), dateLine);
-    ty += lh * 1.2f;
+        p.setFont(mono);
+        p.setPen(dim);
+        p.drawText(QPointF(tx, ty), dateLine);
+        ty += lh * 1.2f;
 
-    painter.setPen(green);
-    painter.drawText(QPointF(tx, ty), prompt);
+        p.setPen(green);
+        p.drawText(QPointF(tx, ty), prompt);
 
-    // Blinking cursor block
-    bool cursorOn = (now.toMSecsSinceEpoch() / 500) % 2 == 0;
-    if (cursorOn) {
-        float cxp = tx + fmM.horizontalAdvance(prompt + " ");
-        painter.fillRect(QRectF(cxp, ty - fmM.ascent() * 0.85f,
-                                fmM.averageCharWidth(), fmM.ascent()), green);
-    }
+        // Blinking cursor block
+        if (cursorOn) {
+            float cxp = tx + fmM.horizontalAdvance(prompt + " ");
+            p.fillRect(QRectF(cxp, ty - fmM.ascent() * 0.85f,
+                              fmM.averageCharWidth(), fmM.ascent()), green);
+        }
 
-    // Scanlines
-    painter.setPen(QPen(QColor(0, 0, 0, 46), 1.0f));
-    for (float yy = panel.top(); yy < panel.bottom(); yy += 3.0f * s)
-        painter.drawLine(QPointF(panel.left(), yy), QPointF(panel.right(), yy));
+        // Scanlines
+        p.setPen(QPen(QColor(0, 0, 0, 46), 1.0f));
+        for (float yy = panel.top(); yy < panel.bottom(); yy += 3.0f * s)
+            p.drawLine(QPointF(panel.left(), yy), QPointF(panel.right(), yy));
 
-    painter.restore();
+        p.restore();
+    });
 }
 
 // --- VFD: vacuum-fluorescent display (reuses the seven-segment digit) ---
@@ -1311,61 +1540,66 @@ void ScreenSaverView::paintDigitalVFD(QPainter &painter)
     QPointF tl = placeFloatingBlock(panelW, panelH);
     QRectF panel(tl.x(), tl.y(), panelW, panelH);
 
-    painter.setRenderHint(QPainter::Antialiasing, true);
-
-    // Smoky glass panel
-    QLinearGradient pg(panel.topLeft(), panel.bottomLeft());
-    pg.setColorAt(0.0, QColor(12, 20, 22));
-    pg.setColorAt(0.5, QColor(10, 16, 18));
-    pg.setColorAt(1.0, QColor(7, 12, 13));
-    painter.setPen(QPen(QColor(80, 120, 120, 70), 2.0f * u));
-    painter.setBrush(pg);
-    painter.drawRoundedRect(panel, 14.0f * u, 14.0f * u);
-
-    QColor teal = m_currentTheme.colors.secondHand.isValid()
-                ? m_currentTheme.colors.secondHand : QColor(52, 231, 200);
-
-    float x = panel.left() + (panelW - digitsW) * 0.5f;
-    float y = panel.center().y() - dh * 0.5f;
-
-    drawSevenSegDigit(painter, x, y, dw, dh, th, hh.at(0).digitValue(), teal); x += dw + gap;
-    drawSevenSegDigit(painter, x, y, dw, dh, th, hh.at(1).digitValue(), teal); x += dw;
-
-    // Colon (blinks)
-    float colonX = x + colonW * 0.5f;
-    x += colonW;
-    if (tm.msec() < 500) {
-        QColor cg = teal; cg.setAlphaF(0.30f);
-        painter.setPen(Qt::NoPen); painter.setBrush(cg);
-        painter.drawEllipse(QPointF(colonX, y + dh * 0.34f), th, th);
-        painter.drawEllipse(QPointF(colonX, y + dh * 0.66f), th, th);
-        painter.setBrush(teal);
-        painter.drawEllipse(QPointF(colonX, y + dh * 0.34f), th * 0.6f, th * 0.6f);
-        painter.drawEllipse(QPointF(colonX, y + dh * 0.66f), th * 0.6f, th * 0.6f);
-    }
+    // Digits only change with the minute and the colon blink, so the whole
+    // face is one cached layer
+    const quint64 key = (tm.hour() * 60 + tm.minute()) * 2 + (tm.msec() < 500 ? 1 : 0);
+    const QRectF bounds = layerBounds(tl, panelW, panelH);
+    markFace(bounds);
+    drawStaticLayer(painter, bounds, key, [&](QPainter &p) {
+        // Smoky glass panel
+        QLinearGradient pg(panel.topLeft(), panel.bottomLeft());
+        pg.setColorAt(0.0, QColor(12, 20, 22));
+        pg.setColorAt(0.5, QColor(10, 16, 18));
+        pg.setColorAt(1.0, QColor(7, 12, 13));
+        p.setPen(QPen(QColor(80, 120, 120, 70), 2.0f * u));
+        p.setBrush(pg);
+        p.drawRoundedRect(panel, 14.0f * u, 14.0f * u);
+
+        QColor teal = m_currentTheme.colors.secondHand.isValid()
+                    ? m_currentTheme.colors.secondHand : QColor(52, 231, 200);
+
+        float x = panel.left() + (panelW - digitsW) * 0.5f;
+        float y = panel.center().y() - dh * 0.5f;
+
+        drawSevenSegDigit(p, x, y, dw, dh, th, hh.at(0).digitValue(), teal); x += dw + gap;
+        drawSevenSegDigit(p, x, y, dw, dh, th, hh.at(1).digitValue(), teal); x += dw;
+
+        // Colon (blinks)
+        float colonX = x + colonW * 0.5f;
+        x += colonW;
+        if (tm.msec() < 500) {
+            QColor cg = teal; cg.setAlphaF(0.30f);
+            p.setPen(Qt::NoPen); p.setBrush(cg);
+            p.drawEllipse(QPointF(colonX, y + dh * 0.34f), th, th);
+            p.drawEllipse(QPointF(colonX, y + dh * 0.66f), th, th);
+            p.setBrush(teal);
+            p.drawEllipse(QPointF(colonX, y + dh * 0.34f), th * 0.6f, th * 0.6f);
+            p.drawEllipse(QPointF(colonX, y + dh * 0.66f), th * 0.6f, th * 0.6f);
+        }
 
-    drawSevenSegDigit(painter, x, y, dw, dh, th, mm.at(0).digitValue(), teal); x += dw + gap;
-    drawSevenSegDigit(painter, x, y, dw, dh, th, mm.at(1).digitValue(), teal);
+        drawSevenSegDigit(p, x, y, dw, dh, th, mm.at(0).digitValue(), teal); x += dw + gap;
+        drawSevenSegDigit(p, x, y, dw, dh, th, mm.at(1).digitValue(), teal);
 
-    // AM/PM, upper-right inside the glass
-    QFont lf("DejaVu Sans Mono"); lf.setBold(true);
-    lf.setPixelSize(static_cast<int>(26.0f * u));
-    painter.setFont(lf);
-    painter.setPen(teal);
-    painter.drawText(QRectF(panel.right() - 90.0f * u, panel.top() + 14.0f * u,
-                            76.0f * u, 30.0f * u),
-                     Qt::AlignRight | Qt::AlignVCenter, tm.hour() >= 12 ? "PM" : "AM");
+        // AM/PM, upper-right inside the glass
+        QFont lf("DejaVu Sans Mono"); lf.setBold(true);
+        lf.setPixelSize(static_cast<int>(26.0f * u));
+        p.setFont(lf);
+        p.setPen(teal);
+        p.drawText(QRectF(panel.right() - 90.0f * u, panel.top() + 14.0f * u,
+                          76.0f * u, 30.0f * u),
+                   Qt::AlignRight | Qt::AlignVCenter, tm.hour() >= 12 ? "PM" : "AM");
 
-    // Fine wire mesh overlay, clipped to the glass
-    painter.save();
-    QPainterPath clip; clip.addRoundedRect(panel, 14.0f * u, 14.0f * u);
-    painter.setClipPath(clip);
-    painter.setPen(QPen(QColor(120, 180, 170, 13), 1.0f));
-    for (float gx = panel.left(); gx < panel.right(); gx += 7.0f * u)
-        painter.drawLine(QPointF(gx, panel.top()), QPointF(gx, panel.bottom()));
-    for (float gy = panel.top(); gy < panel.bottom(); gy += 7.0f * u)
-        painter.drawLine(QPointF(panel.left(), gy), QPointF(panel.right(), gy));
-    painter.restore();
+        // Fine wire mesh overlay, clipped to the glass
+        p.save();
+        QPainterPath clip; clip.addRoundedRect(panel, 14.0f * u, 14.0f * u);
+        p.setClipPath(clip);
+        p.setPen(QPen(QColor(120, 180, 170, 13), 1.0f));
+        for (float gx = panel.left(); gx < panel.right(); gx += 7.0f * u)
+            p.drawLine(QPointF(gx, panel.top()), QPointF(gx, panel.bottom()));
+        for (float gy = panel.top(); gy < panel.bottom(); gy += 7.0f * u)
+            p.drawLine(QPointF(panel.left(), gy), QPointF(panel.right(), gy));
+        p.restore();
+    });
 }
 
 // --- Wandering Hours: satellite complication ---
@@ -1394,30 +1628,42 @@ void ScreenSaverView::paintWanderingClock(QPainter &painter)
     QColor arcCol = theme.colors.minuteHand;
     QColor accent = theme.colors.hourHand;
 
-    // Arc baseline (minute scale, overhead)
-    QPainterPath arcPath; arcPath.moveTo(onArc(a0));
-    for (int i = 1; i <= 90; i++) arcPath.lineTo(onArc(a0 + (a1 - a0) * i / 90.0f));
-    QColor faint = arcCol; faint.setAlphaF(0.16f);
-    painter.setPen(QPen(faint, 2.0f * u, Qt::SolidLine, Qt::RoundCap));
-    painter.setBrush(Qt::NoBrush);
-    painter.drawPath(arcPath);
-
-    // Minute ticks + labels
-    QFont nf("DejaVu Sans"); nf.setPixelSize(static_cast<int>(14.0f * u));
-    painter.setFont(nf);
-    for (int m = 0; m <= 60; m += 5) {
-        float ang = a0 + (a1 - a0) * (m / 60.0f);
-        float dx = cosf(ang), dy = sinf(ang);
-        QColor tc = arcCol; tc.setAlphaF(0.4f);
-        painter.setPen(QPen(tc, 2.0f * u));
-        painter.drawLine(QPointF(cx + dx * aR, cy + dy * aR),
-                         QPointF(cx + dx * (aR + 11.0f * u), cy + dy * (aR + 11.0f * u)));
-        QColor lc = arcCol; lc.setAlphaF(0.55f);
-        painter.setPen(lc);
-        painter.drawText(QRectF(cx + dx * (aR + 24.0f * u) - 17.0f * u,
-                                cy + dy * (aR + 24.0f * u) - 11.0f * u, 34.0f * u, 22.0f * u),
-                         Qt::AlignCenter, QString::number(m));
-    }
+    // Scale, labels and hub never move relative to the block, so they are
+    // one cached layer under the marker and the carousel. The top labels
+    // stand a little above the block.
+    QRectF bounds = layerBounds(tl, blockW, blockH).adjusted(0, -24.0f * u, 0, 0);
+    markFace(bounds);
+    drawStaticLayer(painter, bounds, 0, [&](QPainter &p) {
+        // Arc baseline (minute scale, overhead)
+        QPainterPath arcPath; arcPath.moveTo(onArc(a0));
+        for (int i = 1; i <= 90; i++) arcPath.lineTo(onArc(a0 + (a1 - a0) * i / 90.0f));
+        QColor faint = arcCol; faint.setAlphaF(0.16f);
+        p.setPen(QPen(faint, 2.0f * u, Qt::SolidLine, Qt::RoundCap));
+        p.setBrush(Qt::NoBrush);
+        p.drawPath(arcPath);
+
+        // Minute ticks + labels
+        QFont nf("DejaVu Sans"); nf.setPixelSize(static_cast<int>(14.0f * u));
+        p.setFont(nf);
+        for (int m = 0; m <= 60; m += 5) {
+            float ang = a0 + (a1 - a0) * (m / 60.0f);
+            float dx = cosf(ang), dy = sinf(ang);
+            QColor tc = arcCol; tc.setAlphaF(0.4f);
+            p.setPen(QPen(tc, 2.0f * u));
+            p.drawLine(QPointF(cx + dx * aR, cy + dy * aR),
+                       QPointF(cx + dx * (aR + 11.0f * u), cy + dy * (aR + 11.0f * u)));
+            QColor lc = arcCol; lc.setAlphaF(0.55f);
+            p.setPen(lc);
+            p.drawText(QRectF(cx + dx * (aR + 24.0f * u) - 17.0f * u,
+                              cy + dy * (aR + 24.0f * u) - 11.0f * u, 34.0f * u, 22.0f * u),
+                       Qt::AlignCenter, QString::number(m));
+        }
+
+        // Carousel hub
+        p.setBrush(QColor(28, 31, 39));
+        p.setPen(QPen(QColor(160, 170, 190, 64), 2.0f * u));
+        p.drawEllipse(QPointF(cx, cy), 34.0f * u, 34.0f * u);
+    });
 
     // Active-minute marker (just outside the disc, on the scale)
     float aAct = a0 + (a1 - a0) * (mF / 60.0f);
@@ -1440,11 +1686,6 @@ void ScreenSaverView::paintWanderingClock(QPainter &painter)
     };
     const float dr = 116.0f * u, discR = 38.0f * u;
 
-    // Carousel hub
-    painter.setBrush(QColor(28, 31, 39));
-    painter.setPen(QPen(QColor(160, 170, 190, 64), 2.0f * u));
-    painter.drawEllipse(QPointF(cx, cy), 34.0f * u, 34.0f * u);
-
     QFont df("DejaVu Sans"); df.setBold(true); df.setPixelSize(static_cast<int>(31.0f * u));
     painter.setFont(df);
     for (const Disc &d : discs) {
@@ -1490,14 +1731,15 @@ void ScreenSaverView::paintRegulatorClock(QPainter &painter)
 
     painter.setRenderHint(QPainter::Antialiasing, true);
 
-    auto dial = [&](float cx, float cy, float R, float val, float maxVal,
-                    float handLen, const QString &label, bool big) {
+    // Faces, ticks, numerals and labels sit in one cached layer; only the
+    // hands are drawn per frame
+    auto face = [&](QPainter &p, float cx, float cy, float R, float maxVal, const QString &label) {
         QRadialGradient fg(cx, cy - R * 0.3f, R);
         fg.setColorAt(0.0, QColor(27, 32, 41));
         fg.setColorAt(1.0, QColor(14, 17, 22));
-        painter.setBrush(fg);
-        painter.setPen(QPen(QColor(190, 200, 220, 46), 2.0f * u));
-        painter.drawEllipse(QPointF(cx, cy), R, R);
+        p.setBrush(fg);
+        p.setPen(QPen(QColor(190, 200, 220, 46), 2.0f * u));
+        p.drawEllipse(QPointF(cx, cy), R, R);
 
         int ticks = (maxVal == 12.0f) ? 12 : 60;
         for (int i = 0; i < ticks; i++) {
@@ -1505,23 +1747,30 @@ void ScreenSaverView::paintRegulatorClock(QPainter &painter)
             bool maj = (ticks == 12) ? true : (i % 5 == 0);
             float r1 = maj ? R - 14.0f * u : R - 8.0f * u, r2 = R - 3.0f * u;
             QColor tc = maj ? QColor(220, 228, 240, 178) : QColor(180, 190, 205, 76);
-            painter.setPen(QPen(tc, maj ? 2.5f * u : 1.2f * u));
-            painter.drawLine(QPointF(cx + cosf(a) * r1, cy + sinf(a) * r1),
-                             QPointF(cx + cosf(a) * r2, cy + sinf(a) * r2));
+            p.setPen(QPen(tc, maj ? 2.5f * u : 1.2f * u));
+            p.drawLine(QPointF(cx + cosf(a) * r1, cy + sinf(a) * r1),
+                       QPointF(cx + cosf(a) * r2, cy + sinf(a) * r2));
         }
 
         if (maxVal == 12.0f) {
             QFont nf("Georgia"); nf.setBold(true); nf.setPixelSize(static_cast<int>(18.0f * u));
-            painter.setFont(nf); painter.setPen(QColor(225, 232, 245, 217));
+            p.setFont(nf); p.setPen(QColor(225, 232, 245, 217));
             for (int n = 1; n <= 12; n++) {
                 float a = -static_cast<float>(M_PI) / 2 + 2.0f * static_cast<float>(M_PI) * n / 12.0f;
-                painter.drawText(QRectF(cx + cosf(a) * (R - 30.0f * u) - 14.0f * u,
-                                        cy + sinf(a) * (R - 30.0f * u) - 12.0f * u,
-                                        28.0f * u, 24.0f * u),
-                                 Qt::AlignCenter, QString::number(n));
+                p.drawText(QRectF(cx + cosf(a) * (R - 30.0f * u) - 14.0f * u,
+                                  cy + sinf(a) * (R - 30.0f * u) - 12.0f * u,
+                                  28.0f * u, 24.0f * u),
+                           Qt::AlignCenter, QString::number(n));
             }
         }
 
+        QFont lf("DejaVu Sans"); lf.setPixelSize(static_cast<int>(13.0f * u));
+        p.setFont(lf); p.setPen(QColor(150, 160, 178, 204));
+        p.drawText(QRectF(cx - R, cy + R + 8.0f * u, R * 2, 20.0f * u),
+                   Qt::AlignHCenter | Qt::AlignTop, label);
+    };
+
+    auto hand = [&](float cx, float cy, float R, float val, float maxVal, float handLen, bool big) {
         float a = -static_cast<float>(M_PI) / 2 + 2.0f * static_cast<float>(M_PI) * (val / maxVal);
         QColor hc = big ? theme.colors.minuteHand : theme.colors.hourHand;
         painter.setPen(QPen(hc, big ? 5.0f * u : 3.0f * u, Qt::SolidLine, Qt::RoundCap));
@@ -1529,16 +1778,19 @@ void ScreenSaverView::paintRegulatorClock(QPainter &painter)
                          QPointF(cx + cosf(a) * handLen, cy + sinf(a) * handLen));
         painter.setPen(Qt::NoPen); painter.setBrush(theme.colors.centerPin);
         painter.drawEllipse(QPointF(cx, cy), big ? 7.0f * u : 5.0f * u, big ? 7.0f * u : 5.0f * u);
-
-        QFont lf("DejaVu Sans"); lf.setPixelSize(static_cast<int>(13.0f * u));
-        painter.setFont(lf); painter.setPen(QColor(150, 160, 178, 204));
-        painter.drawText(QRectF(cx - R, cy + R + 8.0f * u, R * 2, 20.0f * u),
-                         Qt::AlignHCenter | Qt::AlignTop, label);
     };
 
-    dial(cxc - 330.0f * u, baseY, 110.0f * u, hours,   12.0f, 86.0f * u,  "HOURS",   false);
-    dial(cxc,              baseY, 145.0f * u, minutes, 60.0f, 115.0f * u, "MINUTES", true);
-    dial(cxc + 330.0f * u, baseY, 110.0f * u, seconds, 60.0f, 86.0f * u,  "SECONDS", false);
+    const QRectF bounds = layerBounds(tl, blockW, blockH);
+    markFace(bounds);
+    drawStaticLayer(painter, bounds, 0, [&](QPainter &p) {
+        face(p, cxc - 330.0f * u, baseY, 110.0f * u, 12.0f, "HOURS");
+        face(p, cxc,              baseY, 145.0f * u, 60.0f, "MINUTES");
+        face(p, cxc + 330.0f * u, baseY, 110.0f * u, 60.0f, "SECONDS");
+    });
+
+    hand(cxc - 330.0f * u, baseY, 110.0f * u, hours,   12.0f, 86.0f * u,  false);
+    hand(cxc,              baseY, 145.0f * u, minutes, 60.0f, 115.0f * u, true);
+    hand(cxc + 330.0f * u, baseY, 110.0f * u, seconds, 60.0f, 86.0f * u,  false);
 }
 
 // --- Word Clock: QLOCKTWO-style letter matrix ---
@@ -1601,38 +1853,44 @@ void ScreenSaverView::paintWordClock(QPainter &painter)
     float gx = tl.x() + pad, gy = tl.y() + pad;
 
     QTime t = QTime::currentTime();
-    QSet<int> lit = wordClockLitCells(t.hour(), t.minute());
 
-    QFont f("DejaVu Sans Mono"); f.setBold(true); f.setPixelSize(static_cast<int>(29.0f * u));
-    painter.setFont(f);
-    painter.setRenderHint(QPainter::Antialiasing, true);
-
-    QColor litCol  = theme.colors.numerals;
-    QColor dimCol  = theme.colors.ticks;  dimCol.setAlphaF(0.30f);
-    QColor glowCol = theme.colors.secondHand.isValid() ? theme.colors.secondHand : QColor(120, 200, 255);
-    QFontMetricsF fm(f);
-
-    for (int r = 0; r < rows; r++) {
-        for (int c = 0; c < cols; c++) {
-            QString ch1(QChar(WORD_GRID[r][c]));
-            QRectF cell(gx + c * cw, gy + r * ch, cw, ch);
-            if (lit.contains(r * cols + c)) {
-                float bx = cell.center().x() - fm.horizontalAdvance(ch1) * 0.5f;
-                float by = cell.center().y() + (fm.ascent() - fm.descent()) * 0.5f;
-                QPainterPath path; path.addText(bx, by, f, ch1);
-                QColor g1 = glowCol; g1.setAlphaF(0.35f);
-                painter.setPen(QPen(g1, 5.0f * u, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
-                painter.setBrush(Qt::NoBrush); painter.drawPath(path);
-                QColor g2 = glowCol; g2.setAlphaF(0.5f);
-                painter.setPen(QPen(g2, 2.0f * u, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
-                painter.drawPath(path);
-                painter.setPen(Qt::NoPen); painter.setBrush(litCol); painter.drawPath(path);
-            } else {
-                painter.setPen(dimCol);
-                painter.drawText(cell, Qt::AlignCenter, ch1);
+    // Lit words only change with the minute, so the whole grid is one cached layer
+    const quint64 key = t.hour() * 60 + t.minute();
+    const QRectF bounds = layerBounds(tl, gridW + pad * 2, gridH + pad * 2);
+    markFace(bounds);
+    drawStaticLayer(painter, bounds, key, [&](QPainter &p) {
+        QSet<int> lit = wordClockLitCells(t.hour(), t.minute());
+
+        QFont f("DejaVu Sans Mono"); f.setBold(true); f.setPixelSize(static_cast<int>(29.0f * u));
+        p.setFont(f);
+
+        QColor litCol  = theme.colors.numerals;
+        QColor dimCol  = theme.colors.ticks;  dimCol.setAlphaF(0.30f);
+        QColor glowCol = theme.colors.secondHand.isValid() ? theme.colors.secondHand : QColor(120, 200, 255);
+        QFontMetricsF fm(f);
+
+        for (int r = 0; r < rows; r++) {
+            for (int c = 0; c < cols; c++) {
+                QString ch1(QChar(WORD_GRID[r][c]));
+                QRectF cell(gx + c * cw, gy + r * ch, cw, ch);
+                if (lit.contains(r * cols + c)) {
+                    float bx = cell.center().x() - fm.horizontalAdvance(ch1) * 0.5f;
+                    float by = cell.center().y() + (fm.ascent() - fm.descent()) * 0.5f;
+                    QPainterPath path; path.addText(bx, by, f, ch1);
+                    QColor g1 = glowCol; g1.setAlphaF(0.35f);
+                    p.setPen(QPen(g1, 5.0f * u, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+                    p.setBrush(Qt::NoBrush); p.drawPath(path);
+                    QColor g2 = glowCol; g2.setAlphaF(0.5f);
+                    p.setPen(QPen(g2, 2.0f * u, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin));
+                    p.drawPath(path);
+                    p.setPen(Qt::NoPen); p.setBrush(litCol); p.drawPath(path);
+                } else {
+                    p.setPen(dimCol);
+                    p.drawText(cell, Qt::AlignCenter, ch1);
+                }
             }
         }
-    }
+    });
 }
 
 // --- Berlin Uhr: Mengenlehreuhr set-theory lamp clock ---
@@ -1648,61 +1906,66 @@ void ScreenSaverView::paintBerlinUhr(QPainter &painter)
     QTime tm = QTime::currentTime();
     int H = tm.hour(), M = tm.minute(), S = tm.second();
 
-    painter.setRenderHint(QPainter::Antialiasing, true);
-
-    const QColor red(255, 59, 48),  redOff(58, 20, 18);
-    const QColor yel(255, 214, 10), yelOff(58, 52, 16);
-    const float lampH = 56.0f * u;
-
-    auto lamp = [&](float x, float y, float w, bool on, const QColor &col, const QColor &off) {
-        QRectF rc(x, y, w, lampH);
-        if (on) {  // soft glow halo behind the lit lamp
-            QColor g = col; g.setAlphaF(0.30f);
-            painter.setPen(Qt::NoPen); painter.setBrush(g);
-            painter.drawRoundedRect(rc.adjusted(-5.0f * u, -5.0f * u, 5.0f * u, 5.0f * u),
-                                    8.0f * u, 8.0f * u);
-        }
-        painter.setBrush(on ? col : off);
-        painter.setPen(QPen(QColor(0, 0, 0, 128), 1.5f * u));
-        painter.drawRoundedRect(rc, 5.0f * u, 5.0f * u);
-    };
+    // Lamps change with the minute and the seconds blink; the whole face is
+    // one cached layer
+    const quint64 key = (H * 60 + M) * 2 + S % 2;
+    const QRectF bounds = layerBounds(tl, blockW, blockH);
+    markFace(bounds);
+    drawStaticLayer(painter, bounds, key, [&](QPainter &p) {
+        const QColor red(255, 59, 48),  redOff(58, 20, 18);
+        const QColor yel(255, 214, 10), yelOff(58, 52, 16);
+        const float lampH = 56.0f * u;
+
+        auto lamp = [&](float x, float y, float w, bool on, const QColor &col, const QColor &off) {
+            QRectF rc(x, y, w, lampH);
+            if (on) {  // soft glow halo behind the lit lamp
+                QColor g = col; g.setAlphaF(0.30f);
+                p.setPen(Qt::NoPen); p.setBrush(g);
+                p.drawRoundedRect(rc.adjusted(-5.0f * u, -5.0f * u, 5.0f * u, 5.0f * u),
+                                  8.0f * u, 8.0f * u);
+            }
+            p.setBrush(on ? col : off);
+            p.setPen(QPen(QColor(0, 0, 0, 128), 1.5f * u));
+            p.drawRoundedRect(rc, 5.0f * u, 5.0f * u);
+        };
 
-    // Seconds lamp (round, blinks each second)
-    {
-        float r = 22.0f * u, y = top + 40.0f * u;
-        bool on = (S % 2 == 0);
-        if (on) {
-            QColor g = yel; g.setAlphaF(0.30f);
-            painter.setPen(Qt::NoPen); painter.setBrush(g);
-            painter.drawEllipse(QPointF(cx, y), r + 5.0f * u, r + 5.0f * u);
+        // Seconds lamp (round, blinks each second)
+        {
+            float r = 22.0f * u, y = top + 40.0f * u;
+            bool on = (S % 2 == 0);
+            if (on) {
+                QColor g = yel; g.setAlphaF(0.30f);
+                p.setPen(Qt::NoPen); p.setBrush(g);
+                p.drawEllipse(QPointF(cx, y), r + 5.0f * u, r + 5.0f * u);
+            }
+            p.setBrush(on ? yel : yelOff);
+            p.setPen(QPen(QColor(0, 0, 0, 128), 1.5f * u));
+            p.drawEllipse(QPointF(cx, y), r, r);
         }
-        painter.setBrush(on ? yel : yelOff);
-        painter.setPen(QPen(QColor(0, 0, 0, 128), 1.5f * u));
-        painter.drawEllipse(QPointF(cx, y), r, r);
-    }
 
-    float innerW = 1060.0f * u, x0 = cx - innerW * 0.5f;
-    int h5 = H / 5, h1 = H % 5, m5 = M / 5, m1 = M % 5;
+        float innerW = 1060.0f * u, x0 = cx - innerW * 0.5f;
+        int h5 = H / 5, h1 = H % 5, m5 = M / 5, m1 = M % 5;
 
-    auto row4 = [&](int litN, float y, const QColor &col, const QColor &off) {
-        float gap = 10.0f * u, w = (innerW - gap * 3) / 4;
-        for (int i = 0; i < 4; i++)
-            lamp(x0 + i * (w + gap), y, w, i < litN, col, off);
-    };
+        auto row4 = [&](int litN, float y, const QColor &col, const QColor &off) {
+            float gap = 10.0f * u, w = (innerW - gap * 3) / 4;
+            for (int i = 0; i < 4; i++)
+                lamp(x0 + i * (w + gap), y, w, i < litN, col, off);
+        };
 
-    row4(h5, top + 80.0f * u,  red, redOff);    // 5-hour lamps
-    row4(h1, top + 146.0f * u, red, redOff);    // 1-hour lamps
+        row4(h5, top + 80.0f * u,  red, redOff);    // 5-hour lamps
+        row4(h1, top + 146.0f * u, red, redOff);    // 1-hour lamps
 
-    // 5-minute row: 11 lamps, quarters (3rd, 6th, 9th) are red
-    {
-        float gap = 8.0f * u, w = (innerW - gap * 10) / 11, y = top + 212.0f * u;
-        for (int i = 0; i < 11; i++) {
-            bool q = ((i + 1) % 3 == 0);
-            lamp(x0 + i * (w + gap), y, w, i < m5, q ? red : yel, q ? redOff : yelOff);
+        // 5-minute row: 11 lamps, quarters (3rd, 6th, 9th) are red
+        {
+            float gap = 8.0f * u, w = (innerW - gap * 10) / 11, y = top + 212.0f * u;
+            for (int i = 0; i < 11; i++) {
+                bool q = ((i + 1) % 3 == 0);
+                lamp(x0 + i * (w + gap), y, w, i < m5, q ? red : yel, q ? redOff : yelOff);
+            }
         }
-    }
 
-    row4(m1, top + 278.0f * u, yel, yelOff);    // 1-minute lamps
+        row4(m1, top + 278.0f * u, yel, yelOff);    // 1-minute lamps
+    });
 }
 
 // --- 5x7 dot font (shared by Pong score + Flip-Dot) ---
@@ -1776,21 +2039,31 @@ void ScreenSaverView::paintPongClock(QPainter &p)
     }
 
     QColor white = m_currentTheme.colors.numerals;
-    p.setRenderHint(QPainter::Antialiasing, false);
-    p.setPen(Qt::NoPen); p.setBrush(white);
-    p.drawRect(QRectF(ox, oy, bw, 6.0f * u));
-    p.drawRect(QRectF(ox, oy + bh - 6.0f * u, bw, 6.0f * u));
-    for (float y = oy + 12.0f * u; y < oy + bh - 12.0f * u; y += 30.0f * u)
-        p.drawRect(QRectF(ox + bw * 0.5f - 4.0f * u, y, 8.0f * u, 16.0f * u));
-
     QTime tm = QTime::currentTime();
-    int H = tm.hour() % 12; if (H == 0) H = 12;
-    QString hh = QString("%1").arg(H, 2, 10, QChar('0'));
-    QString mm = QString("%1").arg(tm.minute(), 2, 10, QChar('0'));
-    float dot = 9.0f * u, scoreW = 11.0f * dot;
-    drawDot57(p, hh, ox + bw * 0.5f - 40.0f * u - scoreW, oy + 34.0f * u, dot, white);
-    drawDot57(p, mm, ox + bw * 0.5f + 40.0f * u,          oy + 34.0f * u, dot, white);
 
+    // Walls, net and score only change with the minute; the paddles and the
+    // ball go over the cached court
+    const quint64 key = tm.hour() * 60 + tm.minute();
+    const QRectF bounds = layerBounds(tl, bw, bh);
+    markFace(bounds);
+    drawStaticLayer(p, bounds, key, [&](QPainter &lp) {
+        lp.setRenderHint(QPainter::Antialiasing, false);
+        lp.setPen(Qt::NoPen); lp.setBrush(white);
+        lp.drawRect(QRectF(ox, oy, bw, 6.0f * u));
+        lp.drawRect(QRectF(ox, oy + bh - 6.0f * u, bw, 6.0f * u));
+        for (float y = oy + 12.0f * u; y < oy + bh - 12.0f * u; y += 30.0f * u)
+            lp.drawRect(QRectF(ox + bw * 0.5f - 4.0f * u, y, 8.0f * u, 16.0f * u));
+
+        int H = tm.hour() % 12; if (H == 0) H = 12;
+        QString hh = QString("%1").arg(H, 2, 10, QChar('0'));
+        QString mm = QString("%1").arg(tm.minute(), 2, 10, QChar('0'));
+        float dot = 9.0f * u, scoreW = 11.0f * dot;
+        drawDot57(lp, hh, ox + bw * 0.5f - 40.0f * u - scoreW, oy + 34.0f * u, dot, white);
+        drawDot57(lp, mm, ox + bw * 0.5f + 40.0f * u,          oy + 34.0f * u, dot, white);
+    });
+
+    p.setRenderHint(QPainter::Antialiasing, false);
+    p.setPen(Qt::NoPen); p.setBrush(white);
     p.drawRect(QRectF(ox + lx, oy + m_pongPL, pw, ph));
     p.drawRect(QRectF(ox + rx, oy + m_pongPR, pw, ph));
     p.drawRect(QRectF(ox + m_pongBallX - br, oy + m_pongBallY - br, 2 * br, 2 * br));
@@ -1799,7 +2072,7 @@ void ScreenSaverView::paintPongClock(QPainter &p)
 
 // --- Binary: BCD dot columns (H H : M M : S S) ---
 
-void ScreenSaverView::paintBinaryClock(QPainter &p)
+void ScreenSaverView::paintBinaryClock(QPainter &painter)
 {
     float u = qMin(height() / 400.0f, width() / 1280.0f);
     float bw = 900.0f * u, bh = 300.0f * u;
@@ -1817,34 +2090,39 @@ void ScreenSaverView::paintBinaryClock(QPainter &p)
     float colW = bw / 6.0f, x0 = tl.x() + colW * 0.5f;
     float baseY = tl.y() + bh * 0.62f, pitch = 56.0f * u, dotR = 18.0f * u;
 
-    p.setRenderHint(QPainter::Antialiasing, true);
-    for (int i = 0; i < 6; i++) {
-        float cx = x0 + i * colW;
-        for (int e = 0; e < 4; e++) {
-            int bv = 1 << e; if (bv > maxV[i]) break;
-            bool on = (cols[i] >> e) & 1;
-            float y = baseY - e * pitch;
-            if (on) {
-                QColor g = accent; g.setAlphaF(0.30f);
-                p.setPen(Qt::NoPen); p.setBrush(g);
-                p.drawEllipse(QPointF(cx, y), dotR + 6.0f * u, dotR + 6.0f * u);
-                p.setBrush(accent);
-                p.drawEllipse(QPointF(cx, y), dotR, dotR);
-            } else {
-                p.setPen(QPen(QColor(120, 160, 180, 70), 1.5f * u));
-                p.setBrush(QColor(70, 110, 130, 40));
-                p.drawEllipse(QPointF(cx, y), dotR, dotR);
+    // Dots change once a second; the whole face is one cached layer
+    const quint64 key = H * 3600 + M * 60 + S;
+    const QRectF bounds = layerBounds(tl, bw, bh);
+    markFace(bounds);
+    drawStaticLayer(painter, bounds, key, [&](QPainter &p) {
+        for (int i = 0; i < 6; i++) {
+            float cx = x0 + i * colW;
+            for (int e = 0; e < 4; e++) {
+                int bv = 1 << e; if (bv > maxV[i]) break;
+                bool on = (cols[i] >> e) & 1;
+                float y = baseY - e * pitch;
+                if (on) {
+                    QColor g = accent; g.setAlphaF(0.30f);
+                    p.setPen(Qt::NoPen); p.setBrush(g);
+                    p.drawEllipse(QPointF(cx, y), dotR + 6.0f * u, dotR + 6.0f * u);
+                    p.setBrush(accent);
+                    p.drawEllipse(QPointF(cx, y), dotR, dotR);
+                } else {
+                    p.setPen(QPen(QColor(120, 160, 180, 70), 1.5f * u));
+                    p.setBrush(QColor(70, 110, 130, 40));
+                    p.drawEllipse(QPointF(cx, y), dotR, dotR);
+                }
             }
+            QFont lf("DejaVu Sans"); lf.setBold(true); lf.setPixelSize(static_cast<int>(19.0f * u));
+            p.setFont(lf); p.setPen(QColor(150, 170, 190, 153));
+            p.drawText(QRectF(cx - colW * 0.5f, baseY + 28.0f * u, colW, 26.0f * u),
+                       Qt::AlignCenter, QString::fromLatin1(labels[i]));
+            QFont vf("DejaVu Sans Mono"); vf.setPixelSize(static_cast<int>(14.0f * u));
+            p.setFont(vf); p.setPen(QColor(110, 200, 230, 115));
+            p.drawText(QRectF(cx - colW * 0.5f, baseY + 52.0f * u, colW, 20.0f * u),
+                       Qt::AlignCenter, QString::number(cols[i]));
         }
-        QFont lf("DejaVu Sans"); lf.setBold(true); lf.setPixelSize(static_cast<int>(19.0f * u));
-        p.setFont(lf); p.setPen(QColor(150, 170, 190, 153));
-        p.drawText(QRectF(cx - colW * 0.5f, baseY + 28.0f * u, colW, 26.0f * u),
-                   Qt::AlignCenter, QString::fromLatin1(labels[i]));
-        QFont vf("DejaVu Sans Mono"); vf.setPixelSize(static_cast<int>(14.0f * u));
-        p.setFont(vf); p.setPen(QColor(110, 200, 230, 115));
-        p.drawText(QRectF(cx - colW * 0.5f, baseY + 52.0f * u, colW, 20.0f * u),
-                   Qt::AlignCenter, QString::number(cols[i]));
-    }
+    });
 }
 
 // --- Fibonacci: colour-square clock ---
@@ -1864,7 +2142,7 @@ static void fibDecode(int h, int mm, int *a)   // values [5,3,2,1,1]; a[i] in {0
     for (int i = 0; i < 5; i++) a[i] = 0;
 }
 
-void ScreenSaverView::paintFibonacciClock(QPainter &p)
+void ScreenSaverView::paintFibonacciClock(QPainter &painter)
 {
     float u = qMin(height() / 400.0f, width() / 1280.0f);
 
@@ -1885,33 +2163,39 @@ void ScreenSaverView::paintFibonacciClock(QPainter &p)
 
     struct Sq { int s, c, r; };
     static const Sq sq[5] = { {5,0,0}, {3,5,0}, {2,5,3}, {1,7,3}, {1,7,4} };
-    p.setRenderHint(QPainter::Antialiasing, true);
-    p.setPen(Qt::NoPen);
-    for (int i = 0; i < 5; i++) {
-        p.setBrush(COL[a[i]]);
-        p.drawRoundedRect(QRectF(ox + sq[i].c * unit + 3.0f * u, oy + sq[i].r * unit + 3.0f * u,
-                                 sq[i].s * unit - 6.0f * u, sq[i].s * unit - 6.0f * u),
-                          6.0f * u, 6.0f * u);
-    }
 
-    QFont lf("DejaVu Sans"); lf.setPixelSize(static_cast<int>(13.0f * u));
-    p.setFont(lf);
-    struct Leg { QColor c; const char *t; };
-    Leg leg[3] = { { COL[1], "hours" }, { COL[2], "minutes" }, { COL[3], "both" } };
-    float legX = ox, legY = oy + 5.0f * unit + 10.0f * u;
-    QFontMetricsF fm(lf);
-    for (const Leg &L : leg) {
-        p.setPen(Qt::NoPen); p.setBrush(L.c);
-        p.drawRoundedRect(QRectF(legX, legY, 14.0f * u, 14.0f * u), 3, 3);
-        p.setPen(QColor(170, 178, 190, 204));
-        p.drawText(QPointF(legX + 20.0f * u, legY + 12.0f * u), QString::fromLatin1(L.t));
-        legX += 20.0f * u + fm.horizontalAdvance(QString::fromLatin1(L.t)) + 22.0f * u;
-    }
+    // Squares change every five minutes; the whole face is one cached layer
+    const quint64 key = H * 12 + mm;
+    const QRectF bounds = layerBounds(tl, bw, bh);
+    markFace(bounds);
+    drawStaticLayer(painter, bounds, key, [&](QPainter &p) {
+        p.setPen(Qt::NoPen);
+        for (int i = 0; i < 5; i++) {
+            p.setBrush(COL[a[i]]);
+            p.drawRoundedRect(QRectF(ox + sq[i].c * unit + 3.0f * u, oy + sq[i].r * unit + 3.0f * u,
+                                     sq[i].s * unit - 6.0f * u, sq[i].s * unit - 6.0f * u),
+                              6.0f * u, 6.0f * u);
+        }
+
+        QFont lf("DejaVu Sans"); lf.setPixelSize(static_cast<int>(13.0f * u));
+        p.setFont(lf);
+        struct Leg { QColor c; const char *t; };
+        Leg leg[3] = { { COL[1], "hours" }, { COL[2], "minutes" }, { COL[3], "both" } };
+        float legX = ox, legY = oy + 5.0f * unit + 10.0f * u;
+        QFontMetricsF fm(lf);
+        for (const Leg &L : leg) {
+            p.setPen(Qt::NoPen); p.setBrush(L.c);
+            p.drawRoundedRect(QRectF(legX, legY, 14.0f * u, 14.0f * u), 3, 3);
+            p.setPen(QColor(170, 178, 190, 204));
+            p.drawText(QPointF(legX + 20.0f * u, legY + 12.0f * u), QString::fromLatin1(L.t));
+            legX += 20.0f * u + fm.horizontalAdvance(QString::fromLatin1(L.t)) + 22.0f * u;
+        }
+    });
 }
 
 // --- Sundial: virtual sun/moon + gnomon shadow over a time-of-day sky ---
 
-void ScreenSaverView::paintSundialClock(QPainter &p)
+void ScreenSaverView::paintSundialClock(QPainter &painter)
 {
     float u = qMin(height() / 400.0f, width() / 1280.0f);
     float bw = width() * 0.96f, bh = height() * 0.94f;
@@ -1931,75 +2215,80 @@ void ScreenSaverView::paintSundialClock(QPainter &p)
                       static_cast<int>(a[i][2] + (a[i+1][2]-a[i][2]) * t));
     };
     QColor topC = mix(KFtop, si, ft), botC = mix(KFbot, si, ft);
-
     float horizon = oy + bh * 0.74f;
-    p.setRenderHint(QPainter::Antialiasing, true);
-    QLinearGradient sky(0, oy, 0, horizon);
-    sky.setColorAt(0.0, topC); sky.setColorAt(1.0, botC);
-    p.setPen(Qt::NoPen); p.setBrush(sky);
-    p.drawRect(QRectF(ox, oy, bw, horizon - oy));
-    p.setBrush(QColor(21, 17, 13));
-    p.drawRect(QRectF(ox, horizon, bw, oy + bh - horizon));
-
-    bool isDay = (hf >= 6.0f && hf < 18.0f);
-    if (!isDay) {
-        p.setBrush(QColor(255, 255, 255, 180));
-        static const float sxf[10] = {0.10f,0.24f,0.40f,0.60f,0.76f,0.89f,0.16f,0.50f,0.69f,0.82f};
-        static const float syf[10] = {0.15f,0.30f,0.10f,0.22f,0.18f,0.33f,0.40f,0.13f,0.38f,0.28f};
-        for (int k = 0; k < 10; k++)
-            p.drawRect(QRectF(ox + sxf[k]*bw, oy + syf[k]*bh*0.6f, 2.0f*u, 2.0f*u));
-    }
 
-    float cx = ox + bw * 0.5f;
-    float pp = isDay ? (hf - 6.0f) / 12.0f : fmodf(hf + 6.0f, 24.0f) / 12.0f;
-    float bx = ox + 0.10f*bw + pp * 0.80f*bw;
-    float by = horizon - sinf(pp * static_cast<float>(M_PI)) * (bh * 0.55f);
-
-    float elev = qMax(0.08f, sinf(pp * static_cast<float>(M_PI)));
-    float dir = (bx < cx) ? 1.0f : -1.0f;
-    float shLen = qMin(70.0f * u / elev * (fabsf(cx - bx) / (bw*0.5f) + 0.25f), bw * 0.42f);
-    p.setPen(QPen(QColor(0, 0, 0, 128), 10.0f * u, Qt::SolidLine, Qt::RoundCap));
-    p.drawLine(QPointF(cx, horizon), QPointF(cx + dir * shLen, horizon - 4.0f * u));
-
-    QFont tf("DejaVu Sans"); tf.setPixelSize(static_cast<int>(12.0f * u));
-    p.setFont(tf);
-    for (int hh = 6; hh <= 18; hh += 2) {
-        float ppx = (hh - 6) / 12.0f, txx = ox + 0.10f*bw + ppx * 0.80f*bw;
-        p.setPen(QPen(QColor(255, 255, 255, 46), 2.0f * u));
-        p.drawLine(QPointF(txx, horizon), QPointF(txx, horizon + 14.0f * u));
-        p.setPen(QColor(255, 255, 255, 100));
-        int lbl = hh > 12 ? hh - 12 : hh;
-        p.drawText(QRectF(txx - 14.0f*u, horizon + 16.0f*u, 28.0f*u, 18.0f*u),
-                   Qt::AlignCenter, QString::number(lbl));
-    }
+    // Sky, sun and shadow move with the minute; the whole face is one cached layer
+    const quint64 key = H * 60 + M;
+    const QRectF bounds = layerBounds(tl, bw, bh);
+    markFace(bounds);
+    drawStaticLayer(painter, bounds, key, [&](QPainter &p) {
+        QLinearGradient sky(0, oy, 0, horizon);
+        sky.setColorAt(0.0, topC); sky.setColorAt(1.0, botC);
+        p.setPen(Qt::NoPen); p.setBrush(sky);
+        p.drawRect(QRectF(ox, oy, bw, horizon - oy));
+        p.setBrush(QColor(21, 17, 13));
+        p.drawRect(QRectF(ox, horizon, bw, oy + bh - horizon));
+
+        bool isDay = (hf >= 6.0f && hf < 18.0f);
+        if (!isDay) {
+            p.setBrush(QColor(255, 255, 255, 180));
+            static const float sxf[10] = {0.10f,0.24f,0.40f,0.60f,0.76f,0.89f,0.16f,0.50f,0.69f,0.82f};
+            static const float syf[10] = {0.15f,0.30f,0.10f,0.22f,0.18f,0.33f,0.40f,0.13f,0.38f,0.28f};
+            for (int k = 0; k < 10; k++)
+                p.drawRect(QRectF(ox + sxf[k]*bw, oy + syf[k]*bh*0.6f, 2.0f*u, 2.0f*u));
+        }
 
-    if (isDay) {
-        QColor g = QColor(255, 210, 127); g.setAlphaF(0.5f);
-        p.setPen(Qt::NoPen); p.setBrush(g);
-        p.drawEllipse(QPointF(bx, by), 44.0f*u, 44.0f*u);
-        p.setBrush(QColor(255, 227, 154));
-        p.drawEllipse(QPointF(bx, by), 30.0f*u, 30.0f*u);
-    } else {
-        p.setPen(Qt::NoPen); p.setBrush(QColor(231, 236, 255));
-        p.drawEllipse(QPointF(bx, by), 24.0f*u, 24.0f*u);
-        p.setBrush(botC);
-        p.drawEllipse(QPointF(bx - 9.0f*u, by - 5.0f*u), 22.0f*u, 22.0f*u);
-    }
+        float cx = ox + bw * 0.5f;
+        float pp = isDay ? (hf - 6.0f) / 12.0f : fmodf(hf + 6.0f, 24.0f) / 12.0f;
+        float bx = ox + 0.10f*bw + pp * 0.80f*bw;
+        float by = horizon - sinf(pp * static_cast<float>(M_PI)) * (bh * 0.55f);
+
+        float elev = qMax(0.08f, sinf(pp * static_cast<float>(M_PI)));
+        float dir = (bx < cx) ? 1.0f : -1.0f;
+        float shLen = qMin(70.0f * u / elev * (fabsf(cx - bx) / (bw*0.5f) + 0.25f), bw * 0.42f);
+        p.setPen(QPen(QColor(0, 0, 0, 128), 10.0f * u, Qt::SolidLine, Qt::RoundCap));
+        p.drawLine(QPointF(cx, horizon), QPointF(cx + dir * shLen, horizon - 4.0f * u));
+
+        QFont tf("DejaVu Sans"); tf.setPixelSize(static_cast<int>(12.0f * u));
+        p.setFont(tf);
+        for (int hh = 6; hh <= 18; hh += 2) {
+            float ppx = (hh - 6) / 12.0f, txx = ox + 0.10f*bw + ppx * 0.80f*bw;
+            p.setPen(QPen(QColor(255, 255, 255, 46), 2.0f * u));
+            p.drawLine(QPointF(txx, horizon), QPointF(txx, horizon + 14.0f * u));
+            p.setPen(QColor(255, 255, 255, 100));
+            int lbl = hh > 12 ? hh - 12 : hh;
+            p.drawText(QRectF(txx - 14.0f*u, horizon + 16.0f*u, 28.0f*u, 18.0f*u),
+                       Qt::AlignCenter, QString::number(lbl));
+        }
+
+        if (isDay) {
+            QColor g = QColor(255, 210, 127); g.setAlphaF(0.5f);
+            p.setPen(Qt::NoPen); p.setBrush(g);
+            p.drawEllipse(QPointF(bx, by), 44.0f*u, 44.0f*u);
+            p.setBrush(QColor(255, 227, 154));
+            p.drawEllipse(QPointF(bx, by), 30.0f*u, 30.0f*u);
+        } else {
+            p.setPen(Qt::NoPen); p.setBrush(QColor(231, 236, 255));
+            p.drawEllipse(QPointF(bx, by), 24.0f*u, 24.0f*u);
+            p.setBrush(botC);
+            p.drawEllipse(QPointF(bx - 9.0f*u, by - 5.0f*u), 22.0f*u, 22.0f*u);
+        }
 
-    p.setBrush(QColor(12, 10, 8)); p.setPen(Qt::NoPen);
-    QPointF gp[4] = { {cx - 9.0f*u, horizon}, {cx - 3.0f*u, horizon - 78.0f*u},
-                      {cx + 3.0f*u, horizon - 78.0f*u}, {cx + 9.0f*u, horizon} };
-    p.drawConvexPolygon(gp, 4);
+        p.setBrush(QColor(12, 10, 8)); p.setPen(Qt::NoPen);
+        QPointF gp[4] = { {cx - 9.0f*u, horizon}, {cx - 3.0f*u, horizon - 78.0f*u},
+                          {cx + 3.0f*u, horizon - 78.0f*u}, {cx + 9.0f*u, horizon} };
+        p.drawConvexPolygon(gp, 4);
 
-    QFont df("DejaVu Sans Mono"); df.setBold(true); df.setPixelSize(static_cast<int>(22.0f*u));
-    p.setFont(df); p.setPen(QColor(255, 255, 255, 217));
-    p.drawText(QPointF(ox + 24.0f*u, oy + 36.0f*u),
-               QString("%1:%2").arg(H,2,10,QChar('0')).arg(M,2,10,QChar('0')));
+        QFont df("DejaVu Sans Mono"); df.setBold(true); df.setPixelSize(static_cast<int>(22.0f*u));
+        p.setFont(df); p.setPen(QColor(255, 255, 255, 217));
+        p.drawText(QPointF(ox + 24.0f*u, oy + 36.0f*u),
+                   QString("%1:%2").arg(H,2,10,QChar('0')).arg(M,2,10,QChar('0')));
+    });
 }
 
 // --- Flip-Dot: electromechanical dot-matrix board ---
 
-void ScreenSaverView::paintFlipDotClock(QPainter &p)
+void ScreenSaverView::paintFlipDotClock(QPainter &painter)
 {
     float u = qMin(height() / 400.0f, width() / 1280.0f);
     QTime tm = QTime::currentTime();
@@ -2036,30 +2325,35 @@ void ScreenSaverView::paintFlipDotClock(QPainter &p)
     QColor lit = m_currentTheme.colors.secondHand.isValid()
                ? m_currentTheme.colors.secondHand : QColor(255, 210, 58);
 
-    p.setRenderHint(QPainter::Antialiasing, true);
-    p.setBrush(QColor(13, 13, 12));
-    p.setPen(QPen(QColor(120, 110, 60, 64), 2.0f * u));
-    p.drawRoundedRect(QRectF(tl.x() + frame * 0.4f, tl.y() + frame * 0.4f,
-                             gridW + frame * 1.2f, gridH + frame * 1.2f), 14.0f * u, 14.0f * u);
-
-    for (int r = 0; r < nRows; r++) {
-        for (int c = 0; c < nCols; c++) {
-            float x = ox + c * pitch, y = oy + r * pitch;
-            if (grid[r][c]) {
-                QColor g = lit; g.setAlphaF(0.35f);
-                p.setPen(Qt::NoPen); p.setBrush(g);
-                p.drawEllipse(QPointF(x, y), dotR + 3.0f * u, dotR + 3.0f * u);
-                p.setBrush(lit);
-                p.drawEllipse(QPointF(x, y), dotR, dotR);
-                p.setBrush(QColor(255, 255, 255, 90));
-                p.drawEllipse(QPointF(x - dotR*0.3f, y - dotR*0.3f), dotR*0.32f, dotR*0.32f);
-            } else {
-                p.setPen(QPen(QColor(0, 0, 0, 150), 1.0f));
-                p.setBrush(QColor(26, 26, 24));
-                p.drawEllipse(QPointF(x, y), dotR, dotR);
+    // The board changes with the minute; the whole face is one cached layer
+    const quint64 key = tm.hour() * 60 + tm.minute();
+    const QRectF bounds = layerBounds(tl, gridW + frame * 2, gridH + frame * 2);
+    markFace(bounds);
+    drawStaticLayer(painter, bounds, key, [&](QPainter &p) {
+        p.setBrush(QColor(13, 13, 12));
+        p.setPen(QPen(QColor(120, 110, 60, 64), 2.0f * u));
+        p.drawRoundedRect(QRectF(tl.x() + frame * 0.4f, tl.y() + frame * 0.4f,
+                                 gridW + frame * 1.2f, gridH + frame * 1.2f), 14.0f * u, 14.0f * u);
+
+        for (int r = 0; r < nRows; r++) {
+            for (int c = 0; c < nCols; c++) {
+                float x = ox + c * pitch, y = oy + r * pitch;
+                if (grid[r][c]) {
+                    QColor g = lit; g.setAlphaF(0.35f);
+                    p.setPen(Qt::NoPen); p.setBrush(g);
+                    p.drawEllipse(QPointF(x, y), dotR + 3.0f * u, dotR + 3.0f * u);
+                    p.setBrush(lit);
+                    p.drawEllipse(QPointF(x, y), dotR, dotR);
+                    p.setBrush(QColor(255, 255, 255, 90));
+                    p.drawEllipse(QPointF(x - dotR*0.3f, y - dotR*0.3f), dotR*0.32f, dotR*0.32f);
+                } else {
+                    p.setPen(QPen(QColor(0, 0, 0, 150), 1.0f));
+                    p.setBrush(QColor(26, 26, 24));
+                    p.drawEllipse(QPointF(x, y), dotR, dotR);
+                }
             }
         }
-    }
+    });
 }
 
 void ScreenSaverView::mousePressEvent(QMouseEvent *event)
@@ -2,11 +2,14 @@
 #define SCREENSAVERVIEW_H
 
 #include <QWidget>
-#include <QTimer>
 #include <QDateTime>
+#include <QElapsedTimer>
 #include <QImage>
+#include <QPixmap>
 #include <QStringList>
+#include <functional>
 #include "clockthemes.h"
+#include "glyphatlas.h"
 
 namespace Ui {
 class ScreenSaverView;
@@ -26,12 +29,21 @@ public:
     static QStringList faceNames();
     static int faceIndexForName(const QString &name); // -1 if not found
 
+    // Smoothed paint time per frame, static layer redraws and animation
+    // ticks that needed no repaint, for the API
+    QString faceName() const { return QString::fromUtf8(m_currentTheme.name); }
+    qint64 paintCostUs() const { return static_cast<qint64>(m_paintCostUs); }
+    quint64 layerRenders() const { return m_layerRenders; }
+    quint64 idleTicks() const { return m_idleTicks; }
+
 public slots:
     void start();
     void start(int themeIndex); // start with a specific theme (-1 = random)
+    void setFrameRateCap(int fps); // thermal limit, 0 = none
 
 protected:
     void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
     void keyPressEvent(QKeyEvent *event) override;
 
@@ -43,7 +55,11 @@ private slots:
 
 private:
     Ui::ScreenSaverView *ui;
-    QTimer *m_animTimer = nullptr;
+    static constexpr int ANIM_INTERVAL_MS = 33; // ~30 FPS
+    int m_frameIntervalMs = ANIM_INTERVAL_MS;   // ANIM_INTERVAL_MS or the thermal cap
+    QElapsedTimer m_frameClock;                 // since the last animate()
+    // Delay until a face with an update period next needs a frame
+    int nextFrameMs() const;
     ClockMode m_clockMode = Digital;
 
     // Clock text (digital mode)
@@ -75,9 +91,58 @@ private:
     void paintDigitalVFD(QPainter &painter);
 
     // Position a content block of the given size, bouncing off edges.
-    // Updates m_posX/m_posY/velocity and returns the block's top-left corner.
+    // Updates m_posX/m_posY/velocity and returns the block's top-left corner,
+    // on whole pixels so cached layers line up with what is drawn over them.
     QPointF placeFloatingBlock(float totalW, float totalH);
 
+    // Draws the parts of a face that only change with the widget size, the
+    // theme and key (e.g. the displayed minute) from a cached pixmap, running
+    // draw to refill it when any of them changed. draw paints in widget
+    // coordinates as usual; bounds must sit on whole pixels and cover
+    // everything it paints.
+    void drawStaticLayer(QPainter &painter, const QRectF &bounds, quint64 key,
+                         const std::function<void(QPainter &)> &draw);
+    void invalidateLayers();
+
+    // Soft glow around glyphs: draw fills the glyph shapes in white, in
+    // widget coordinates, into a buffer at 1/GLOW_SCALE of bounds. The
+    // buffer is blurred and cached until key or the size of bounds changes.
+    // Each call tints it with tint and adds it over bounds, rounded up to a
+    // multiple of GLOW_SCALE. bounds must leave room for the blur around the
+    // glyphs.
+    struct GlyphGlow {
+        QImage glow;
+        QImage tmp;
+        QImage tinted;
+        quint64 key = 0;
+        bool valid = false;
+    };
+    void drawGlyphGlow(QPainter &painter, GlyphGlow &glyphGlow, const QRect &bounds, quint64 key,
+                       const QColor &tint, const std::function<void(QPainter &)> &draw);
+
+    // Text kept as one white image the size of bounds, filled by render
+    // (in image coordinates, typically from a GlyphAtlas) until key or the
+    // size changes. Each call draws it at bounds tinted with color; the tint
+    // is only redone when the colour changed.
+    struct TextSprite {
+        QImage text;
+        QImage tinted;
+        quint64 key = 0;
+        bool valid = false;
+        QRgb tintedColor = 0;
+        bool tintValid = false;
+    };
+    void drawTextSprite(QPainter &painter, TextSprite &sprite, const QRect &bounds, quint64 key,
+                        const QColor &color, const std::function<void(QImage &)> &render);
+
+    // Records where the face painted this frame. animate() repaints only
+    // that area, and where it drifted to, when the face moved a pixel or
+    // its theme's updateMs rolled over; between the two it doesn't wake at
+    // all. New content that lays out past the repainted area gets a second
+    // repaint of its own bounds. Faces that never call it get full repaints
+    // at the frame rate.
+    void markFace(const QRectF &bounds);
+
     // Themed analog clock drawing methods
     void drawDialBackground(QPainter &p, float cx, float cy, float radius, const ClockTheme &theme);
     void drawDecorativeRings(QPainter &p, float cx, float cy, float radius, const ClockTheme &theme);
@@ -97,11 +162,47 @@ private:
     ClockTheme m_currentTheme;
     int m_themeIndex = 0;
 
-    // Pre-allocated glow buffers
+    // Static layer of the current face
+    QPixmap m_layer;
+    QSize m_layerSize;
+    quint64 m_layerKey = 0;
+    bool m_layerValid = false;
+    quint64 m_layerRenders = 0;
+
+    // Pre-allocated glow buffers; m_glowStatic holds the analog dial's static
+    // layer at glow scale, copied in before the hands each frame
     QImage m_glowBuffer;
     QImage m_glowTmp;
+    QImage m_glowStatic;
+    quint64 m_glowStaticKey = 0;
+    bool m_glowStaticValid = false;
     int m_cachedGlowSize = 0;
 
+    // Digital face glows: Neon time and date lines, Nixie digits
+    GlyphGlow m_neonTimeGlow;
+    GlyphGlow m_neonDateGlow;
+    GlyphGlow m_nixieGlow;
+
+    // Neon text: glyphs per font, and the lines built from them
+    GlyphAtlas m_neonTimeGlyphs;
+    GlyphAtlas m_neonAmpmGlyphs;
+    GlyphAtlas m_neonDateGlyphs;
+    TextSprite m_neonTimeText;
+    TextSprite m_neonDateText;
+    GlyphAtlas m_nixieGlyphs;
+
+    // Damage tracking, see markFace()
+    QRect m_faceRect;
+    QRect m_faceDamage; // last area animate() repainted
+    QPoint m_facePos;
+    int m_facePeriodMs = 0;
+    qint64 m_faceTick = 0;
+    quint64 m_idleTicks = 0;
+
+    // Paint time
+    QElapsedTimer m_paintTimer;
+    double m_paintCostUs = 0.0;
+
     // Floating position (shared between digital and analog modes)
     bool  m_posInit = false;   // false until the block is first centered (per activation)
     float m_posX = -1;
@@ -0,0 +1,170 @@
+// Checks that AvsEngine's fused per-pixel passes render exactly what the
+// effects render one at a time. Each chain is built twice, in an engine with
+// fusion off and one with it on (and once more tiled across threads), fed
+// the same synthetic audio, and the frames' checksums compared. Run through
+// ctest; prints each mismatch and exits non-zero if there was one.
+
+#include "avsengine.h"
+#include "avsblur.h"
+#include "avscolormodifier.h"
+#include "avsfadeout.h"
+#include "avsgrain.h"
+#include "avsmirror.h"
+#include "avsmovement.h"
+#include "avsring.h"
+#include "avsstarfield.h"
+#include "avssuperscope.h"
+#include "avswater.h"
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace {
+
+constexpr int FRAMES = 90;
+
+struct Chain {
+    const char *name;
+    std::function<void(AvsEngine &)> build;
+};
+
+// Fade + Blur + ColorModifier style runs, broken up by whole-frame effects
+// and a disabled effect in various places
+const Chain CHAINS[] = {
+    {"scope, fade, blur, hue shift", [](AvsEngine &e) {
+        e.addEffect(std::make_unique<AvsSuperScope>());
+        e.addEffect(std::make_unique<AvsFadeOut>(6));
+        e.addEffect(std::make_unique<AvsBlur>(1));
+        e.addEffect(std::make_unique<AvsColorModifier>(AvsColorModifier::HueShift));
+    }},
+    {"stars, grain, fade, invert, blur, blur", [](AvsEngine &e) {
+        e.addEffect(std::make_unique<AvsStarfield>());
+        e.addEffect(std::make_unique<AvsGrain>(16));
+        e.addEffect(std::make_unique<AvsFadeOut>(3));
+        e.addEffect(std::make_unique<AvsColorModifier>(AvsColorModifier::Invert));
+        e.addEffect(std::make_unique<AvsBlur>(1));
+        e.addEffect(std::make_unique<AvsBlur>(1));
+    }},
+    {"ring, blur, mirror, fade, grayscale, blur", [](AvsEngine &e) {
+        e.addEffect(std::make_unique<AvsRing>());
+        e.addEffect(std::make_unique<AvsBlur>(1));
+        e.addEffect(std::make_unique<AvsMirror>(AvsMirror::Both));
+        e.addEffect(std::make_unique<AvsFadeOut>(4));
+        e.addEffect(std::make_unique<AvsColorModifier>(AvsColorModifier::Grayscale));
+        e.addEffect(std::make_unique<AvsBlur>(1));
+    }},
+    {"scope, swirl, blur, (disabled), fade", [](AvsEngine &e) {
+        e.addEffect(std::make_unique<AvsSuperScope>());
+        e.addEffect(std::make_unique<AvsMovement>(AvsMovement::Swirl));
+        e.addEffect(std::make_unique<AvsBlur>(1));
+        auto off = std::make_unique<AvsColorModifier>(AvsColorModifier::Invert);
+        off->enabled = false;
+        e.addEffect(std::move(off));
+        e.addEffect(std::make_unique<AvsFadeOut>(2));
+    }},
+    {"water, boost, blur x2, fade, grain", [](AvsEngine &e) {
+        e.addEffect(std::make_unique<AvsSuperScope>());
+        e.addEffect(std::make_unique<AvsWater>());
+        e.addEffect(std::make_unique<AvsColorModifier>(AvsColorModifier::BrightnessBoost));
+        e.addEffect(std::make_unique<AvsBlur>(2));
+        e.addEffect(std::make_unique<AvsFadeOut>(5));
+        e.addEffect(std::make_unique<AvsGrain>(8));
+    }},
+};
+
+// A chirp with a beat every 12 frames, the same for every engine
+void fillAudio(AvsAudioData &audio, int frame)
+{
+    for (int i = 0; i < AVS_WAVEFORM_SIZE; i++) {
+        float t = static_cast<float>(i) / AVS_WAVEFORM_SIZE;
+        audio.waveformLeft[i] = 0.8f * std::sin(6.2831853f * t * (3 + frame % 7) + frame * 0.1f);
+        audio.waveformRight[i] = 0.6f * std::cos(6.2831853f * t * (5 + frame % 5));
+        audio.waveformMono[i] = 0.5f * (audio.waveformLeft[i] + audio.waveformRight[i]);
+    }
+    for (int i = 0; i < AVS_SPECTRUM_SIZE; i++)
+        audio.spectrumMono[i] = 1.0f / (1 + std::abs(i - (frame * 3) % AVS_SPECTRUM_SIZE));
+
+    audio.isBeat = frame % 12 == 0;
+    audio.isBeatBass = audio.isBeat;
+    audio.isBeatMid = frame % 8 == 0;
+    audio.isBeatHigh = frame % 5 == 0;
+    audio.beatDecay = audio.isBeat ? 1.0f : 0.8f * audio.beatDecay;
+    audio.beatDecayBass = audio.beatDecay;
+    audio.beatDecayMid = audio.isBeatMid ? 1.0f : 0.8f * audio.beatDecayMid;
+    audio.beatDecayHigh = audio.isBeatHigh ? 1.0f : 0.8f * audio.beatDecayHigh;
+}
+
+// FNV-1a over the frame's pixels
+uint64_t checksum(const QImage &image)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (int y = 0; y < image.height(); y++) {
+        const uchar *line = image.constScanLine(y);
+        for (int x = 0; x < image.width() * 4; x++) {
+            hash ^= line[x];
+            hash *= 0x100000001b3ULL;
+        }
+    }
+    return hash;
+}
+
+std::vector<uint64_t> render(const Chain &chain, bool fusion, int threads, int *fusedRuns)
+{
+    AvsEngine engine;
+    engine.clearEffects();
+    chain.build(engine);
+    engine.setFusionEnabled(fusion);
+    engine.setRenderThreads(threads);
+
+    AvsAudioData audio;
+    std::vector<uint64_t> sums;
+    *fusedRuns = 0;
+    for (int frame = 0; frame < FRAMES; frame++) {
+        fillAudio(audio, frame);
+        sums.push_back(checksum(engine.renderFrame(audio)));
+        *fusedRuns += engine.stats().fusedRuns;
+    }
+    return sums;
+}
+
+int failures = 0;
+
+void compare(const Chain &chain, const char *path, const std::vector<uint64_t> &expected,
+             const std::vector<uint64_t> &actual)
+{
+    for (int frame = 0; frame < FRAMES; frame++) {
+        if (actual[frame] != expected[frame]) {
+            std::printf("FAIL: %s, %s: frame %d checksum %016llx, unfused %016llx\n",
+                        chain.name, path, frame,
+                        static_cast<unsigned long long>(actual[frame]),
+                        static_cast<unsigned long long>(expected[frame]));
+            failures++;
+            return;
+        }
+    }
+}
+
+} // namespace
+
+int main()
+{
+    for (const Chain &chain : CHAINS) {
+        int runs = 0;
+        const std::vector<uint64_t> unfused = render(chain, false, 1, &runs);
+
+        compare(chain, "fused", unfused, render(chain, true, 1, &runs));
+        // A check that never fuses anything would pass trivially
+        if (runs == 0) {
+            std::printf("FAIL: %s: nothing was fused\n", chain.name);
+            failures++;
+        }
+
+        compare(chain, "fused on 3 threads", unfused, render(chain, true, 3, &runs));
+    }
+
+    if (failures)
+        std::printf("%d check(s) failed\n", failures);
+    return failures ? 1 : 0;
+}
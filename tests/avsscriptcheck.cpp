@@ -0,0 +1,86 @@
+// Checks for the AVS script compiler. Run through ctest; prints each failed
+// check and exits non-zero if there was one.
+
+#include "avsscript.h"
+#include <clocale>
+#include <cstdio>
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char *what)
+{
+    if (!ok) {
+        std::printf("FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+// Compiles and runs source once, for reading variables back
+bool run(AvsScript &script, const char *source)
+{
+    AvsScript::Program program;
+    QString error;
+    if (!script.compile(source, program, &error)) {
+        std::printf("FAIL: %s: %s\n", source, qPrintable(error));
+        failures++;
+        return false;
+    }
+    script.run(program);
+    return true;
+}
+
+void checkLiterals()
+{
+    // strtof would stop at the '.' under a comma-decimal LC_NUMERIC, which
+    // QApplication takes from the environment
+    const char *commaLocales[] = {"de_DE.UTF-8", "de_DE", "fr_FR.UTF-8", "fr_FR"};
+    for (const char *locale : commaLocales) {
+        if (std::setlocale(LC_NUMERIC, locale))
+            break;
+    }
+
+    AvsScript s;
+    if (run(s, "a = 0.5; b = .25e1; c = 2.; d = 1e3; e = 12.5e-1")) {
+        check(s.value(s.variable("a")) == 0.5f, "0.5");
+        check(s.value(s.variable("b")) == 2.5f, ".25e1");
+        check(s.value(s.variable("c")) == 2.0f, "2.");
+        check(s.value(s.variable("d")) == 1000.0f, "1e3");
+        check(s.value(s.variable("e")) == 1.25f, "12.5e-1");
+    }
+
+    AvsScript::Program program;
+    check(!s.compile("x = .", program), "a lone '.' is rejected");
+
+    std::setlocale(LC_NUMERIC, "C");
+}
+
+void checkIf()
+{
+    // The then branch clears the variable the condition reads; the branch
+    // already taken must still finish and be the result
+    AvsScript s;
+    if (run(s, "x = 1; r = if(x, (x = 0; y = 1), 5)")) {
+        check(s.value(s.variable("x")) == 0.0f, "if(): then branch assigns x");
+        check(s.value(s.variable("y")) == 1.0f, "if(): then branch assigns y after x");
+        check(s.value(s.variable("r")) == 1.0f, "if(): result is the then branch");
+    }
+
+    AvsScript t;
+    if (run(t, "x = 0; r = if(x, 5, (x = 1; y = 2))")) {
+        check(t.value(t.variable("y")) == 2.0f, "if(): else branch assigns y after x");
+        check(t.value(t.variable("r")) == 2.0f, "if(): result is the else branch");
+    }
+}
+
+} // namespace
+
+int main()
+{
+    checkLiterals();
+    checkIf();
+    if (failures)
+        std::printf("%d check(s) failed\n", failures);
+    return failures ? 1 : 0;
+}